@@ -0,0 +1,39 @@
+#pragma once
+
+/*
+* What the host program can run (host/src/hostMain.cpp picks one from the command line)
+*/
+
+namespace host3142a {
+
+/**
+ * boots like main does on the brain (devices, chassis, every init stage, the background tasks)
+ * and reports how long each step took
+ * @return 0 if every stage finished
+ */
+int runBoot();
+
+/**
+ * times the math kernels, chassis conversions, typed units, matrices, filters, the clock and
+ * logging per call, on the host
+ * @return 0
+ */
+int runBench();
+
+/**
+ * checks the record ring with concurrent writers, the capture window, the trig error bounds in
+ * Util/fastMath.h, the solve residuals and the moving median against sorting, on the host
+ * @return 0 if every check passed
+ */
+int runTest();
+
+/**
+ * runs the skills route against the drivetrain and ball path simulator, in virtual time, and
+ * reports where the robot ended up against where the route means to go, and how long it took
+ * @param optionCount how many options there are
+ * @param options simulator settings to change, name=value (see host/src/hostSim.cpp)
+ * @return 0 if the route finished
+ */
+int runSim(int optionCount, char **options);
+
+} // namespace host3142a
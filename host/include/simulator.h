@@ -0,0 +1,179 @@
+#pragma once
+#include "v5_vcs.h"
+
+/*
+* Drivetrain and ball path simulator
+*
+* Plays the hardware behind the stand-in (see host/include/standIn.h) under virtual time: every
+* tick it reads the motor commands from the port tables, moves a model of the robot, and writes
+* back what the motor encoders, tracking wheels, inertial sensor, line sensors and battery would
+* read. The robot code can't tell, so the real control loops (motion profiles, turn PID, the
+* scoring macros) run against it unchanged, as fast as the host can go.
+*
+* The drive is one DC motor model per motor (the cartridge it was built with, current limited like
+* the V5 motor) through the gear ratio onto a wheel per side. The wheels push the chassis through
+* a traction limit, so they slip when asked for more than the carpet gives. The chassis has mass
+* and yaw inertia, rolling and turning resistance, and doesn't slide sideways. Every motor draws
+* from a battery with internal resistance, so pushing hard sags the voltage everything gets.
+* The mechanism motors spin a load and move balls along the intake - indexer - flywheel path,
+* past the line sensors, so the goal macros see balls come and go.
+*
+* Everything is in SI units (m, kg, s, N, N m, V, A) unless the name says otherwise
+*/
+
+namespace sim3142a {
+
+/**
+ * struct motorModel. The V5 motor, for a 200 rpm cartridge (the others scale from it)
+ */
+
+struct motorModel {
+  double stallTorque;    // at the output, at nominal voltage
+  double stallCurrent;   // the motor's current limit, it never draws more
+  double nominalVoltage; // the voltage the free speed is rated at
+};
+
+/**
+ * struct drivetrainModel. The two sides of the drive and the chassis they push
+ */
+
+struct drivetrainModel {
+  int32_t leftPorts[2];
+  int32_t rightPorts[2];
+  bool leftMirrored;  // the side's motors turn backwards to drive forwards
+  bool rightMirrored;
+  double gearRatio;     // wheel turns per motor turn
+  double wheelDiameter;
+  double trackWidth;
+  double mass;
+  double yawInertia;
+  double wheelInertia;      // of a side's wheels, gears and motors, at the wheel
+  double traction;          // friction coefficient between the wheels and the carpet
+  double slipStiffness;     // N of traction per m/s of slip, until the traction limit
+  double rollingResistance; // N, against the chassis moving
+  double turningResistance; // N m, against the chassis turning (wheel scrub)
+};
+
+/**
+ * struct batteryModel
+ */
+
+struct batteryModel {
+  double openVoltage;
+  double resistance; // internal, ohm
+};
+
+/**
+ * struct trackerModel. The passive tracking wheels (see Tracking)
+ */
+
+struct trackerModel {
+  vex::triport::port right;
+  vex::triport::port back;
+  double rightOffset; // to the right of the center
+  double backOffset;  // behind the center, it measures the sideways motion (positive to the left)
+  double wheelDiameter;
+};
+
+/**
+ * struct sensorModel. How far what the robot code reads is from the truth
+ */
+
+struct sensorModel {
+  int32_t inertialPort;
+  double encoderNoise;      // degrees, standard deviation on every encoder reading (motors and tracking wheels)
+  double imuNoise;          // degrees, standard deviation on every inertial reading
+  double imuDrift;          // degrees per second the inertial heading drifts
+  uint32_t encoderLatency;  // ms from the wheels moving to the encoders reporting it
+  uint32_t imuLatency;      // ms from the chassis turning to the inertial sensor reporting it
+  uint32_t seed;            // for the noise, the same seed gives the same run
+};
+
+/**
+ * struct mechanismMotor. A mechanism motor and which way it is built in
+ */
+
+struct mechanismMotor {
+  int32_t port;
+  bool mirrored;
+};
+
+/**
+ * struct ballPathModel. The balls between the intakes, the indexer and the flywheel.
+ * While the intakes pull in for long enough there is a ball for them, whatever is in front of the robot
+ */
+
+struct ballPathModel {
+  mechanismMotor intakeL;
+  mechanismMotor intakeR;
+  mechanismMotor indexer;
+  mechanismMotor flywheel;
+  vex::triport::port intakeLine;
+  vex::triport::port bottomLine;
+  vex::triport::port middleLine;
+  vex::triport::port topLine;
+  vex::triport::port outyLine;
+  double loadInertia;  // each mechanism motor's load, at its output
+  double ballSpeed;    // a roller at free speed moves a ball this fast
+  uint32_t pickupTime; // ms the intakes have to pull in for a ball
+  int32_t capacity;    // balls the robot holds
+  int32_t preloads;    // balls in the robot at the start (the first one at the top)
+  int32_t lineEmpty;   // raw line sensor reading with no ball in front of it
+  int32_t lineBall;    // and with one
+};
+
+/**
+ * struct simConfig. Everything about the simulated robot
+ */
+
+struct simConfig {
+  motorModel motor;
+  drivetrainModel drive;
+  batteryModel battery;
+  trackerModel trackers;
+  sensorModel sensors;
+  ballPathModel balls;
+  uint32_t tickUs; // the simulator steps this often, the drive in ten sub steps
+};
+
+/**
+ * struct pose. Where the chassis is, from where it started
+ */
+
+struct pose {
+  double x;       // forwards at the start
+  double y;       // to the left at the start
+  double heading; // radians, counter clockwise = positive (like Tracking#getHeading)
+};
+
+/**
+ * struct ballCounts. What happened to the balls
+ */
+
+struct ballCounts {
+  int32_t pickedUp;
+  int32_t scored;  // out of the flywheel forwards
+  int32_t ejected; // out past the outy sensor
+  int32_t dropped; // back out of the intakes
+};
+
+/**
+ * the robot as the robot code configures it: ports from the device registry, the gear ratio and
+ * dimensions from CHASSIS_CONSTANTS, the tracking wheels from the pose tracker, and the motors built
+ * in the way the code reverses them. Call it after initDevices() and initChassisDevices()
+ */
+simConfig defaultConfig();
+
+/**
+ * starts the simulator and virtual time with it (see standIn::startVirtualTime).
+ * Call it from main before any task starts, after initDevices()
+ */
+void start(const simConfig &config);
+
+/// where the chassis really is
+pose truePose();
+
+/// the balls so far
+ballCounts balls();
+
+} // namespace sim3142a
@@ -0,0 +1,80 @@
+#pragma once
+#include "v5_vcs.h"
+
+/*
+* The hardware side of the host stand-in
+*
+* What the robot code sees through the vex:: devices lives in these port tables. The robot code
+* writes motor commands and reads sensors through the devices, whatever plays the hardware
+* (a test, the simulator) reads the commands and writes the sensors here. Positions and rotations
+* are stored the way the SDK reports them with nothing reversed (degrees, rpm, volts)
+*/
+
+namespace standIn {
+
+/**
+ * enum motorMode. What the motor was last told to do
+ */
+
+enum motorMode {
+  MOTOR_STOPPED,
+  MOTOR_VOLTAGE,  // spin(..., volt), command is volts
+  MOTOR_VELOCITY, // spin(..., rpm or pct), command is rpm
+};
+
+/**
+ * struct motorState. One smart port with a motor on it
+ */
+
+struct motorState {
+  motorMode mode;
+  double command;   // volts or rpm (see mode), positive turns the motor forward
+  double position;  // degrees of the output shaft, positive forward
+  double velocity;  // rpm of the output shaft
+  double current;   // amps
+  int32_t maxRpm;   // free speed of the cartridge it was built with (100, 200 or 600)
+};
+
+/**
+ * struct inertialState. One smart port with an inertial sensor on it
+ */
+
+struct inertialState {
+  double rotation;         // degrees, continuous, clockwise positive like the sensor
+  uint32_t calibrateUntil; // timer::system() when the calibration started by calibrate() ends
+};
+
+/// the motor on a smart port (PORT1 ... PORT21)
+motorState &motorAt(int32_t port);
+
+/// the inertial sensor on a smart port
+inertialState &inertialAt(int32_t port);
+
+/// reading of a line sensor, 0 - 4095 like the 12 bit ADC (low is something in front of it)
+int32_t &lineAt(const vex::triport::port &port);
+
+/// angle of a quadrature encoder, in degrees (the encoder is named by its first port)
+double &encoderAt(const vex::triport::port &port);
+
+/// battery voltage Brain.Battery reports
+double &batteryVoltage();
+
+/**
+ * makes the SD card a directory on the host. With no directory set (the default) the card is
+ * not inserted, so the robot code runs on its defaults and nothing is written
+ * @param path directory, or NULL to take the card out
+ */
+void setSdCardDirectory(const char *path);
+
+/**
+ * switches the stand-in to virtual time. From here on only one task runs at a time, like on the
+ * brain, and when they are all asleep the clock jumps to the next wake up instead of waiting, so
+ * the robot code runs as fast as the host can run it. Call it from the host program's main thread
+ * before any task is started (that thread becomes the first task). There is no going back
+ * @param step steps whatever plays the hardware (the simulator) by some seconds, called with every
+ * task stopped whenever the clock moves on. NULL if nothing has to move
+ * @param tickUs longest step (us)
+ */
+void startVirtualTime(void (*step)(double seconds), uint32_t tickUs = 1000);
+
+} // namespace standIn
@@ -0,0 +1,9 @@
+#pragma once
+#include <stdint.h>
+
+/*
+* Host stand-in for the VEX SDK's v5.h
+*
+* The real one declares the C API under the C++ classes. Nothing in src/ calls it directly,
+* so on the host there is nothing to declare. The C++ classes are in v5_vcs.h
+*/
@@ -0,0 +1,343 @@
+#pragma once
+#include "v5.h"
+#include <mutex>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+* Host stand-in for the VEX SDK's v5_vcs.h
+*
+* The part of the vex:: API the robot code uses (motors, encoders, line and inertial sensors, the
+* brain and its screen and SD card, the controller, tasks and timers), declared the way the SDK
+* declares it so src/ compiles unchanged, and implemented in host/src/vexStandIn.cpp.
+*
+* Devices are handles onto a table of port states, like the real ones are handles onto the
+* hardware: two motors on the same port see the same encoder, and whatever plays the part of the
+* hardware (a test, the simulator) reads the commanded voltages and sets the sensor values through
+* host/include/standIn.h. Nothing is drawn and the controller has no buttons to press. Tasks are
+* threads, and time is the host's steady clock from when the program started, or a virtual clock
+* that only moves when every task is asleep (see standIn::startVirtualTime)
+*/
+
+namespace vex {
+
+enum class timeUnits { sec, msec };
+enum class analogUnits { pct, range8bit, range10bit, range12bit, mV };
+enum class voltageUnits { volt, mV };
+enum class velocityUnits { pct, rpm, dps };
+enum class rotationUnits { deg, rev, raw };
+enum class directionType { fwd, rev };
+enum class gearSetting { ratio36_1, ratio18_1, ratio6_1 };
+enum class controllerType { primary, partner };
+enum class percentUnits { pct };
+
+const timeUnits msec = timeUnits::msec;
+const timeUnits seconds = timeUnits::sec;
+const voltageUnits volt = voltageUnits::volt;
+const velocityUnits rpm = velocityUnits::rpm;
+const velocityUnits dps = velocityUnits::dps;
+const rotationUnits degrees = rotationUnits::deg;
+const rotationUnits turns = rotationUnits::rev;
+const directionType fwd = directionType::fwd;
+const directionType forward = directionType::fwd;
+const directionType reverse = directionType::rev;
+const gearSetting ratio36_1 = gearSetting::ratio36_1;
+const gearSetting ratio18_1 = gearSetting::ratio18_1;
+const gearSetting ratio6_1 = gearSetting::ratio6_1;
+const controllerType primary = controllerType::primary;
+const controllerType partner = controllerType::partner;
+const percentUnits percent = percentUnits::pct;
+
+// smart ports, 0 based like the SDK's
+enum {
+  PORT1 = 0, PORT2, PORT3, PORT4, PORT5, PORT6, PORT7, PORT8, PORT9, PORT10, PORT11,
+  PORT12, PORT13, PORT14, PORT15, PORT16, PORT17, PORT18, PORT19, PORT20, PORT21
+};
+
+const int32_t SMART_PORTS = 21;
+const int32_t BRAIN_TRIPORT = 21; // the brain's own 3 wire ports sit after the smart ports
+
+class color {
+public:
+  color() : m_rgb(0) {}
+  color(int rgb) : m_rgb(rgb) {}
+  uint32_t rgb() const { return (m_rgb); }
+
+  static const color transparent;
+  static const color white;
+  static const color black;
+  static const color red;
+  static const color green;
+  static const color blue;
+  static const color yellow;
+  static const color orange;
+  static const color cyan;
+  static const color purple;
+
+private:
+  uint32_t m_rgb;
+};
+
+class device {
+public:
+  device(int32_t index = 0) : _index(index) {}
+  int32_t index() { return (_index); }
+  bool installed() { return true; }
+
+protected:
+  int32_t _index;
+};
+
+class triport : public device {
+public:
+  class port {
+  public:
+    port() : m_triport(BRAIN_TRIPORT), m_id(0) {}
+    port(int32_t triport, int32_t id) : m_triport(triport), m_id(id) {}
+    /// index of this port in the stand-in's 3 wire port table
+    int32_t slot() const { return (m_triport * 8 + m_id); }
+
+  private:
+    int32_t m_triport;
+    int32_t m_id;
+  };
+
+  port Port[8];
+  port &A, &B, &C, &D, &E, &F, &G, &H;
+
+  triport(int32_t index = BRAIN_TRIPORT);
+  triport(const triport &other);
+};
+
+class motor : public device {
+public:
+  motor(int32_t index);
+  motor(int32_t index, bool reverse);
+  motor(int32_t index, gearSetting gears, bool reverse = false);
+
+  void setReversed(bool reverse);
+  void spin(directionType dir, double value, voltageUnits units);
+  void spin(directionType dir, double value, velocityUnits units);
+  void stop();
+
+  double position(rotationUnits units);
+  double rotation(rotationUnits units);
+  void setPosition(double value, rotationUnits units);
+  void resetPosition();
+  void resetRotation();
+
+  double velocity(velocityUnits units);
+  double voltage(voltageUnits units = voltageUnits::volt);
+  double current();
+  double temperature(percentUnits units);
+
+private:
+  bool m_reversed;
+  gearSetting m_gears;
+};
+
+class encoder : public device {
+public:
+  encoder(triport::port &port);
+  double position(rotationUnits units);
+  double rotation(rotationUnits units);
+  void setPosition(double value, rotationUnits units);
+  void resetRotation();
+
+private:
+  int32_t m_slot;
+};
+
+class line : public device {
+public:
+  line(triport::port &port);
+  int32_t value(analogUnits units);
+
+private:
+  int32_t m_slot;
+};
+
+class inertial : public device {
+public:
+  inertial(int32_t index);
+  void calibrate(int32_t value = 0);
+  bool isCalibrating();
+  double rotation(rotationUnits units = rotationUnits::deg);
+  double heading(rotationUnits units = rotationUnits::deg);
+  void setRotation(double value, rotationUnits units);
+  void resetRotation();
+};
+
+class brain {
+public:
+  class lcd {
+  public:
+    void print(const char *format, ...);
+    void print(double value);
+    void print(int value);
+    void printAt(int32_t x, int32_t y, const char *format, ...);
+    void setCursor(int32_t row, int32_t col);
+    void clearScreen();
+    void clearScreen(const color &fill);
+    void clearLine(int32_t row);
+    void clearLine();
+    void drawRectangle(int x, int y, int width, int height);
+    void drawRectangle(int x, int y, int width, int height, const color &fill);
+    void drawLine(int x1, int y1, int x2, int y2);
+    void drawPixel(int x, int y);
+    void drawCircle(int x, int y, int radius);
+    void setPenColor(const color &pen);
+    void setFillColor(const color &fill);
+    void setFont(int font);
+    void setPenWidth(uint32_t width);
+    bool drawImageFromFile(const char *name, int x, int y);
+    void pressed(void (*callback)(void));
+    void released(void (*callback)(void));
+    int32_t xPosition();
+    int32_t yPosition();
+    bool pressing();
+    bool render();
+    bool render(bool vsync, bool runScheduler = true);
+  } Screen;
+
+  /// the SD card is a directory on the host, see standIn::setSdCardDirectory
+  class sdcard {
+  public:
+    bool isInserted();
+    int32_t loadfile(const char *name, uint8_t *buffer, int32_t length);
+    int32_t savefile(const char *name, uint8_t *buffer, int32_t length);
+    int32_t appendfile(const char *name, uint8_t *buffer, int32_t length);
+    int32_t size(const char *name);
+    bool exists(const char *name);
+  } SDcard;
+
+  class battery {
+  public:
+    double voltage(voltageUnits units = voltageUnits::volt);
+    double current();
+    uint32_t capacity();
+  } Battery;
+
+  triport ThreeWirePort;
+
+  brain();
+  double timer(timeUnits units);
+  void resetTimer();
+
+private:
+  uint64_t m_timerStart; // timer::systemHighResolution() at the last resetTimer
+};
+
+class controller {
+public:
+  class lcd {
+  public:
+    void print(const char *format, ...);
+    void print(double value);
+    void print(int value);
+    void setCursor(int32_t row, int32_t col);
+    void clearScreen();
+    void clearLine(int32_t row);
+    void clearLine();
+  } Screen;
+
+  class button {
+  public:
+    void pressed(void (*callback)(void));
+    void released(void (*callback)(void));
+    bool pressing();
+  } ButtonA, ButtonB, ButtonX, ButtonY, ButtonUp, ButtonDown, ButtonLeft, ButtonRight, ButtonL1,
+      ButtonL2, ButtonR1, ButtonR2;
+
+  controller();
+  controller(controllerType type);
+  void rumble(const char *pattern);
+};
+
+/// a task is a detached thread, the priority is only remembered (virtual time runs them round robin)
+class task {
+public:
+  task();
+  task(int (*callback)(void));
+  task(int (*callback)(void), int32_t priority);
+  task(int (*callback)(void *), void *arg);
+  task(int (*callback)(void *), void *arg, int32_t priority);
+
+  bool stop();
+  bool suspend();
+  bool resume();
+  int32_t priority();
+  void setPriority(int32_t priority);
+
+  static void sleep(uint32_t time);
+  static void yield();
+
+  static const int32_t taskPriorityLow = 1;
+  static const int32_t taskPriorityNormal = 7;
+  static const int32_t taskPriorityHigh = 15;
+
+private:
+  int32_t m_priority;
+};
+
+class thread {
+public:
+  thread(int (*callback)(void));
+  thread(void (*callback)(void));
+};
+
+namespace this_thread {
+void sleep_for(uint32_t time);
+void yield();
+int32_t get_id();
+} // namespace this_thread
+
+class mutex {
+public:
+  void lock();
+  void unlock();
+  bool try_lock();
+
+private:
+  std::mutex m_mutex;
+};
+
+class timer {
+public:
+  timer();
+  uint32_t time();
+  double time(timeUnits units);
+  void clear();
+
+  /// ms since the program started (virtual once standIn::startVirtualTime was called)
+  static uint32_t system();
+  /// us since the program started (virtual once standIn::startVirtualTime was called)
+  static uint64_t systemHighResolution();
+
+private:
+  uint64_t m_start;
+};
+
+void wait(double time, timeUnits units);
+
+namespace vision {
+class signature {
+public:
+  signature() {}
+};
+class code {
+public:
+  code() {}
+};
+} // namespace vision
+
+class competition {
+public:
+  void autonomous(void (*callback)(void));
+  void drivercontrol(void (*callback)(void));
+  bool isEnabled();
+};
+
+} // namespace vex
+
+using namespace vex;
@@ -0,0 +1,35 @@
+# host build: every file in src/ except main.cpp (the brain's entry point), compiled for the
+# machine you are on against the vex stand-in in host/include, plus host/src
+#
+#   make host                 builds build/host/robot
+#   build/host/robot boot     boots like the brain does and prints the boot report
+#   build/host/robot bench    times the math kernels, conversions, units, matrices, filters and logging
+#   build/host/robot test     runs the offline checks (record ring, capture, trig, solves, median), non-zero if one fails
+#   build/host/robot sim      runs the skills route against the simulator, faster than real time
+#
+# the DEFINES switches in the makefile apply here too (except VexV5, this isn't the brain)
+
+HOST_BUILD   = $(BUILD)/host
+HOST_PROGRAM = $(HOST_BUILD)/robot
+HOST_CXX     = g++
+HOST_DEFINES = $(filter-out -DVexV5,$(DEFINES))
+HOST_FLAGS   = -Os -Wall -Werror=return-type -fno-rtti -fno-exceptions -std=gnu++11 -pthread $(HOST_DEFINES)
+HOST_INC     = -Ihost/include $(addprefix -I, ${INC_F})
+
+HOST_SRC  = $(filter-out src/Impl_src/main.cpp, $(wildcard src/*/*.cpp))
+HOST_SRC += $(wildcard host/src/*.cpp)
+HOST_OBJ  = $(addprefix $(HOST_BUILD)/, $(addsuffix .o, $(basename $(HOST_SRC))) )
+HOST_H    = $(wildcard host/include/*.h) $(wildcard include/*/*.h)
+
+$(HOST_BUILD)/%.o: %.cpp $(HOST_H) $(SRC_A) host/mkhost.mk
+	$(Q)$(MKDIR)
+	$(ECHO) "HOST CXX $<"
+	$(Q)$(HOST_CXX) $(HOST_FLAGS) $(HOST_INC) -c -o $@ $<
+
+$(HOST_PROGRAM): $(HOST_OBJ)
+	$(ECHO) "HOST LINK $@"
+	$(Q)$(HOST_CXX) -pthread -o $@ $^
+
+host: $(HOST_PROGRAM)
+
+.PHONY: host
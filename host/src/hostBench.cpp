@@ -0,0 +1,234 @@
+#include "hostModes.h"
+#include "Config/chassis-config.h"
+#include "Util/fastMath.h"
+#include "Util/filters.h"
+#include "Util/matrix.h"
+#include "Util/premacros.h"
+#include "Util/timestamp.h"
+#include "Util/units.h"
+#include <cmath>
+#include <fcntl.h>
+#include <iostream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+// per call costs on the host, to compare implementations with each other (the brain is a lot
+// slower, but mostly in proportion). Every loop reads its inputs from a table so nothing can be
+// worked out ahead, and writes to a volatile so nothing can be thrown away
+
+namespace host3142a {
+
+static const int INPUTS = 1024;
+static const int ROUNDS = 2000;
+
+static volatile double sinkD;
+static volatile float sinkF;
+
+static double inputsD[INPUTS];
+static float inputsF[INPUTS];
+
+static void report(const char *name, const math3142a::Stopwatch &clock, int calls) {
+  printf("  %-28s %8.1f ns\n", name, clock.elapsedMicros() * 1000.0 / calls);
+}
+
+// runs body(input) for every input, ROUNDS times, and reports the time per call
+#define BENCH(name, inputs, sink, body)                                                           \
+  do {                                                                                             \
+    math3142a::Stopwatch clock;                                                                    \
+    for (int round = 0; round < ROUNDS; round++)                                                   \
+      for (int i = 0; i < INPUTS; i++)                                                             \
+        sink = (body)(inputs[i]);                                                                  \
+    report(name, clock, ROUNDS * INPUTS);                                                          \
+  } while (0)
+
+static double libmSin(double x) { return (std::sin(x)); }
+static float libmSinF(float x) { return (std::sin(x)); }
+static double libmAtan2(double x) { return (std::atan2(x, 1.5 - x)); }
+static double kernelSin(double x) { return (math3142a::fastSin(x)); }
+static float kernelSinF(float x) { return (math3142a::fastSin(x)); }
+static double kernelAtan2(double x) { return (math3142a::fastAtan2(x, 1.5 - x)); }
+
+static void benchTrig() {
+  printf("trig (fastMath.h against libm)\n");
+  BENCH("std::sin double", inputsD, sinkD, libmSin);
+  BENCH("fastSin double", inputsD, sinkD, kernelSin);
+  BENCH("std::sin float", inputsF, sinkF, libmSinF);
+  BENCH("fastSin float", inputsF, sinkF, kernelSinF);
+  BENCH("std::atan2 double", inputsD, sinkD, libmAtan2);
+  BENCH("fastAtan2 double", inputsD, sinkD, kernelAtan2);
+}
+
+template <int N>
+static void benchMatrix(const char *mulName, const char *solveName, const char *luName) {
+  typedef math3142a::Matrix<math3142a::real, N, N> square;
+  square a;
+  for (int r = 0; r < N; r++)
+    for (int c = 0; c < N; c++)
+      a(r, c) = (math3142a::real)((r * 7 + c * 3) % 5) + (r == c ? N : 0);
+  square spd = a.transpose() * a; // symmetric positive definite, for Cholesky
+
+  math3142a::Vector<math3142a::real, N> b;
+  for (int r = 0; r < N; r++)
+    b[r] = inputsF[r];
+
+  math3142a::Stopwatch clock;
+  for (int i = 0; i < ROUNDS * 100; i++) {
+    a(0, 0) = inputsF[i % INPUTS]; // a new product every time
+    sinkD = (a * a)(N - 1, N - 1);
+  }
+  report(mulName, clock, ROUNDS * 100);
+
+  clock.restart();
+  for (int i = 0; i < ROUNDS * 100; i++) {
+    square lower;
+    spd(0, 0) = N * N + inputsF[i % INPUTS];
+    math3142a::choleskyDecompose(spd, lower);
+    sinkD = math3142a::choleskySolve(lower, b)[0];
+  }
+  report(solveName, clock, ROUNDS * 100);
+
+  clock.restart();
+  for (int i = 0; i < ROUNDS * 100; i++) {
+    math3142a::Vector<math3142a::real, N> x = math3142a::Vector<math3142a::real, N>::zeros();
+    a(0, 0) = N + inputsF[i % INPUTS];
+    math3142a::solve(a, b, x);
+    sinkD = x[0];
+  }
+  report(luName, clock, ROUNDS * 100);
+}
+
+// the conversions before ChassisConstants: the factors worked out again on every call, with two
+// long double divides per pair. Not const, so they can't be folded either
+static long double wheelSizeBefore = 3.25 * 0.0254;
+static double gearRatioBefore = 1.6666667;
+static ChassisConstants constants = CHASSIS_CONSTANTS; // a copy, so it is read like the chassis reads its own
+
+static double convertedBefore(double ticks) {
+  double meters = ticks * (wheelSizeBefore * M_PI / 360) * gearRatioBefore;
+  return (meters * (360 / (wheelSizeBefore * M_PI)) * gearRatioBefore);
+}
+
+// what FourMotorDrive#convertTicksToMeters and #convertMetersToTicks do now
+static double convertedPrecomputed(double ticks) {
+  double meters = ticks * constants.metersPerTick();
+  return (meters * constants.ticksPerMeter());
+}
+
+static void benchConversions() {
+  printf("chassis conversions, ticks to m and back (chassisConstants.h)\n");
+  BENCH("factors every call", inputsD, sinkD, convertedBefore);
+  BENCH("precomputed factors", inputsD, sinkD, convertedPrecomputed);
+}
+
+// a feedforward voltage with plain doubles and with the units the chassis uses. The gains aren't
+// const, so neither can be folded. Built on their own at -Os, both are the same 7 instructions
+static double kVDouble = 9.2, kADouble = 0.08;
+static math3142a::Quantity<-1, 0, 1, 1> kV(9.2);  // V per m/s
+static math3142a::Quantity<-1, 0, 2, 1> kA(0.08); // V per m/s^2
+
+static double feedforwardDoubles(double velocity) {
+  double acceleration = velocity * 0.5 - 1;
+  return (kVDouble * velocity + kADouble * acceleration);
+}
+
+static double feedforwardQuantities(double velocity) {
+  const math3142a::Velocity v(velocity);
+  const math3142a::Acceleration a(velocity * 0.5 - 1);
+  const math3142a::Voltage volts = kV * v + kA * a;
+  return (volts.value());
+}
+
+static void benchUnits() {
+  printf("typed units, a feedforward voltage (units.h)\n");
+  BENCH("doubles", inputsD, sinkD, feedforwardDoubles);
+  BENCH("Quantity", inputsD, sinkD, feedforwardQuantities);
+}
+
+// the same line three ways, a flywheel debug log with a sensor reading and its threshold
+static const int LOG_CALLS = 200000;
+// flushed this often, like the log task would, so the 2 KB buffer never fills and drops a line
+static const int LOG_FLUSH_CALLS = 50;
+
+static void logWithCout(int i) { std::cout << "SCORING" << ' ' << i % 1024 << ' ' << 711 << std::endl; }
+static void logBuffered(int i) { LOG("SCORING", i % 1024, 711); }
+static void logCompiledOut(int i) { LOG_DEBUG(FLYWHEEL, "SCORING", i % 1024, 711); }
+
+static void benchLogging() {
+  void (*const ways[])(int) = {logWithCout, logBuffered, logCompiledOut};
+  const char *names[] = {"cout + endl (the old LOG)", "LOG, buffered", "LOG_DEBUG, compiled out"};
+  uint64_t took[3];
+
+  // the lines go to /dev/null, so the time is formatting and writing, not the terminal
+  fflush(stdout);
+  int console = dup(STDOUT_FILENO);
+  int devNull = open("/dev/null", O_WRONLY);
+  dup2(devNull, STDOUT_FILENO);
+  for (int way = 0; way < 3; way++) {
+    math3142a::Stopwatch clock;
+    for (int i = 0; i < LOG_CALLS; i++) {
+      ways[way](i);
+      if (i % LOG_FLUSH_CALLS == LOG_FLUSH_CALLS - 1)
+        log3142a::flushLog();
+    }
+    log3142a::flushLog(); // the buffered lines still have to go out
+    took[way] = clock.elapsedMicros();
+  }
+  fflush(stdout);
+  dup2(console, STDOUT_FILENO);
+  close(devNull);
+  close(console);
+
+  printf("logging, per call (premacros.h, to /dev/null, LOG_LEVEL %d)\n", LOG_LEVEL);
+  for (int way = 0; way < 3; way++)
+    printf("  %-28s %8.1f ns\n", names[way], took[way] * 1000.0 / LOG_CALLS);
+  printf("  %-28s %8lu\n", "lines dropped", (unsigned long)log3142a::getDroppedLogLines());
+}
+
+// one filter over every input, the time is per sample
+template <class Filter>
+static void benchFilter(const char *name, Filter filter) {
+  math3142a::Stopwatch clock;
+  for (int round = 0; round < ROUNDS; round++)
+    for (int i = 0; i < INPUTS; i++)
+      sinkF = filter.update(inputsF[i]);
+  report(name, clock, ROUNDS * INPUTS);
+}
+
+static void benchFilters() {
+  printf("filters, per sample (filters.h, float)\n");
+  benchFilter("ExponentialAverage", math3142a::ExponentialAverage<float>(0.2f));
+  benchFilter("LowPassBiquad", math3142a::LowPassBiquad<float>(5, 100));
+  benchFilter("MovingMedian<5>", math3142a::MovingMedian<float, 5>());
+  benchFilter("SavitzkyGolayDerivative<5>", math3142a::SavitzkyGolayDerivative<float, 5>());
+  benchFilter("RateLimiter", math3142a::RateLimiter<float>(1));
+}
+
+static void benchClock() {
+  printf("clock (timestamp.h)\n");
+  math3142a::Stopwatch clock;
+  for (int i = 0; i < ROUNDS * 100; i++)
+    sinkD = (double)math3142a::micros();
+  report("micros", clock, ROUNDS * 100);
+}
+
+int runBench() {
+  srand(3142);
+  for (int i = 0; i < INPUTS; i++) {
+    inputsD[i] = (rand() % 20000 - 10000) / 1000.0; // +-10 rad
+    inputsF[i] = (float)inputsD[i];
+  }
+
+  benchTrig();
+  benchConversions();
+  benchUnits();
+  printf("matrices (matrix.h, real = %s)\n", sizeof(math3142a::real) == 4 ? "float" : "double");
+  benchMatrix<4>("4x4 product", "4x4 cholesky + solve", "4x4 lu + solve");
+  benchMatrix<6>("6x6 product", "6x6 cholesky + solve", "6x6 lu + solve");
+  benchFilters();
+  benchClock();
+  benchLogging();
+  return (0);
+}
+
+} // namespace host3142a
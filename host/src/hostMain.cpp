@@ -0,0 +1,56 @@
+#include "hostModes.h"
+#include "Impl/api.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// the host program: the robot code running against the vex stand-in (see host/include/v5_vcs.h)
+// usage: <program> [boot | bench | test | sim [name=value ...]]
+
+namespace host3142a {
+
+static const uint32_t BOOT_TIMEOUT = 10000; // ms, the IMU calibration alone takes 2 s
+
+int runBoot() {
+  boot3142a::profileStep("main");
+
+  initDevices();
+  initChassisDevices();
+
+  // the same background tasks pre_auto starts (see src/Impl_src/main.cpp)
+  task controllerScreen(display3142a::controllerDisplayTask, task::taskPriorityLow);
+  task logWriter(log3142a::logTask, task::taskPriorityLow);
+  task recordWriter(telemetry3142a::recordDrainTask, task::taskPriorityLow);
+  boot3142a::startInitStages();
+  task autonSelect(selector3142a::makeDisplay, task::taskPriorityLow);
+
+  bool ready = boot3142a::waitForStages(boot3142a::ALL_STAGES, BOOT_TIMEOUT);
+  if (!ready)
+    LOG_ERROR(BOOT, "HOST BOOT TIMED OUT (ms)", BOOT_TIMEOUT);
+  return (ready ? 0 : 1);
+}
+
+} // namespace host3142a
+
+int main(int argc, char **argv) {
+  const char *mode = argc > 1 ? argv[1] : "boot";
+
+  int result;
+  if (strcmp(mode, "boot") == 0) {
+    result = host3142a::runBoot();
+  } else if (strcmp(mode, "bench") == 0) {
+    result = host3142a::runBench();
+  } else if (strcmp(mode, "test") == 0) {
+    result = host3142a::runTest();
+  } else if (strcmp(mode, "sim") == 0) {
+    result = host3142a::runSim(argc - 2, argv + 2);
+  } else {
+    fprintf(stderr, "usage: %s [boot | bench | test | sim [name=value ...]]\n", argv[0]);
+    return (2);
+  }
+
+  // the robot's tasks never return, so leave without running static destructors under them
+  log3142a::flushLog();
+  fflush(stdout);
+  _Exit(result);
+}
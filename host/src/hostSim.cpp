@@ -0,0 +1,148 @@
+#include "hostModes.h"
+#include "simulator.h"
+#include "Impl/api.h"
+#include "Impl/auto_skills.h"
+#include "Util/timestamp.h"
+#include <chrono>
+#include <cmath>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// the skills route against the simulator (see host/include/simulator.h), in virtual time
+
+namespace host3142a {
+
+static const uint32_t ROUTE_TIMEOUT = 120000; // ms of virtual time, a stuck macro never finishes
+static const double INCH = 0.0254;
+
+/**
+ * struct plannedMove. One turn then one drive of the route
+ */
+
+struct plannedMove {
+  double heading; // degrees, counter clockwise = positive (turnToDegreeGyro)
+  double inches;  // negative backwards
+};
+
+// where runAutoSkillsRoute (src/Impl_src/auto_skills.cpp) means to go, turn by drive.
+// It has to be kept in step with the route, the simulator only knows where the robot really went
+static const plannedMove SKILLS_ROUTE[] = {
+  {0, 8}, {-75, 41}, {-125, 20}, {-125, -17}, {0, 53}, {-90, 10}, {-90, -17},
+};
+
+static sim3142a::pose plannedEnd() {
+  sim3142a::pose end = {0, 0, 0};
+  for (const plannedMove &move : SKILLS_ROUTE) {
+    end.heading = move.heading * M_PI / 180;
+    end.x += move.inches * INCH * std::cos(end.heading);
+    end.y += move.inches * INCH * std::sin(end.heading);
+  }
+  return (end);
+}
+
+/**
+ * struct simOption. A setting that can be changed from the command line (name=value)
+ */
+
+struct simOption {
+  const char *name;
+  double *value;
+};
+
+// what the command line can change, everything else stays as defaultConfig has it
+static bool applyOption(sim3142a::simConfig &config, const char *arg) {
+  double seed = config.sensors.seed;
+  double encoderLatency = config.sensors.encoderLatency;
+  double imuLatency = config.sensors.imuLatency;
+  const simOption options[] = {
+    {"encoderNoise", &config.sensors.encoderNoise},
+    {"imuNoise", &config.sensors.imuNoise},
+    {"imuDrift", &config.sensors.imuDrift},
+    {"encoderLatency", &encoderLatency},
+    {"imuLatency", &imuLatency},
+    {"seed", &seed},
+    {"mass", &config.drive.mass},
+    {"traction", &config.drive.traction},
+    {"battery", &config.battery.openVoltage},
+    {"batteryResistance", &config.battery.resistance},
+  };
+
+  const char *equals = strchr(arg, '=');
+  if (!equals)
+    return false;
+  for (const simOption &option : options) {
+    if (strlen(option.name) == (size_t)(equals - arg) && strncmp(option.name, arg, equals - arg) == 0) {
+      *option.value = atof(equals + 1);
+      config.sensors.seed = (uint32_t)seed;
+      config.sensors.encoderLatency = (uint32_t)encoderLatency;
+      config.sensors.imuLatency = (uint32_t)imuLatency;
+      return true;
+    }
+  }
+  return false;
+}
+
+static volatile bool routeDone = false;
+
+static int routeTask() {
+  runAutoSkillsRoute();
+  routeDone = true;
+  return 0;
+}
+
+static void printPose(const char *name, const sim3142a::pose &where) {
+  printf("  %-10s x %7.2f in  y %7.2f in  heading %7.1f deg\n", name, where.x / INCH, where.y / INCH,
+         where.heading * 180 / M_PI);
+}
+
+int runSim(int optionCount, char **options) {
+  const std::chrono::steady_clock::time_point wallStart = std::chrono::steady_clock::now();
+
+  initDevices();
+  initChassisDevices();
+
+  sim3142a::simConfig config = sim3142a::defaultConfig();
+  for (int i = 0; i < optionCount; i++) {
+    if (!applyOption(config, options[i])) {
+      fprintf(stderr, "unknown simulator option %s\n", options[i]);
+      return (2);
+    }
+  }
+  sim3142a::start(config);
+  const uint32_t virtualStart = math3142a::millis();
+
+  // boot like the brain (the tasks pre_auto starts), then drive the route the way the controller's A button would
+  task controllerScreen(display3142a::controllerDisplayTask, task::taskPriorityLow);
+  task logWriter(log3142a::logTask, task::taskPriorityLow);
+  task recordWriter(telemetry3142a::recordDrainTask, task::taskPriorityLow);
+  boot3142a::startInitStages();
+  task autonSelect(selector3142a::makeDisplay, task::taskPriorityLow);
+  task route(routeTask);
+
+  while (!routeDone && math3142a::millis() - virtualStart < ROUTE_TIMEOUT)
+    task::sleep(100);
+
+  const double virtualSeconds = (math3142a::millis() - virtualStart) / 1000.0;
+  const double wallSeconds =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+  log3142a::flushLog();
+
+  const sim3142a::pose planned = plannedEnd();
+  const sim3142a::pose simulated = sim3142a::truePose();
+  const double headingError = std::remainder(simulated.heading - planned.heading, 2 * M_PI);
+  const sim3142a::ballCounts balls = sim3142a::balls();
+
+  printf("\nskills route %s after %.2f s (virtual), %.2f s wall, %.1fx real time\n",
+         routeDone ? "finished" : "TIMED OUT", virtualSeconds, wallSeconds, virtualSeconds / wallSeconds);
+  printPose("planned", planned);
+  printPose("simulated", simulated);
+  printf("  %-10s %.2f in, %.1f deg\n", "error", std::hypot(simulated.x - planned.x, simulated.y - planned.y) / INCH,
+         headingError * 180 / M_PI);
+  printf("  %-10s %ld picked up, %ld scored, %ld ejected, %ld dropped\n", "balls", (long)balls.pickedUp,
+         (long)balls.scored, (long)balls.ejected, (long)balls.dropped);
+
+  return (routeDone ? 0 : 1);
+}
+
+} // namespace host3142a
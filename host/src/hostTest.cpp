@@ -0,0 +1,371 @@
+#include "hostModes.h"
+#include "Telemetry/capture.h"
+#include "Telemetry/recordLog.h"
+#include "Util/fastMath.h"
+#include "Util/filters.h"
+#include "Util/matrix.h"
+#include "standIn.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <vector>
+
+// the offline checks behind the figures in the headers: the record ring under concurrent
+// writers, the capture window, the trig error bounds, the solve residuals and the moving median.
+// Each prints ok or FAILED, and any FAILED makes the program exit non-zero
+
+namespace host3142a {
+
+using namespace telemetry3142a;
+
+static int failures = 0;
+
+static void check(const char *name, bool passed) {
+  printf("  %-44s %s\n", name, passed ? "ok" : "FAILED");
+  if (!passed)
+    failures++;
+}
+
+// an error against its documented limit
+static void checkError(const char *name, double error, double limit) {
+  char line[64];
+  snprintf(line, sizeof(line), "%s %.1e (limit %.0e)", name, error, limit);
+  check(line, error <= limit);
+}
+
+// a deterministic random number in [-1, 1], the same every run
+static double randomUnit() {
+  static uint32_t state = 142;
+  state = state * 1664525u + 1013904223u;
+  return (state / 2147483648.0 - 1.0);
+}
+
+// ---------------------------------------------------------------- record ring (recordLog.h)
+
+static const int RING_WRITERS = 4;
+static const int RING_RECORDS = 5000; // per writer, all of them together stay below the 16 bit sequence
+static const int RING_BURST = 40;     // records a writer writes between 1 ms sleeps, so some get through and some don't
+
+static std::atomic<int> nextWriter(0);
+static std::atomic<int> writersDone(0);
+static int accepted[RING_WRITERS];
+
+// writes RING_RECORDS records in bursts: (writer, count)
+static int ringWriter() {
+  int writer = nextWriter.fetch_add(1);
+  for (int count = 0; count < RING_RECORDS; count++) {
+    if (logRecord(DRIVE_STRAIGHT_RECORD, (float)writer, (float)count))
+      accepted[writer]++;
+    if (count % RING_BURST == RING_BURST - 1)
+      vex::task::sleep(1);
+  }
+  writersDone.fetch_add(1);
+  return 0;
+}
+
+// reads telemetry.bin back: every accepted record once, in order per writer
+static void checkRecordRing() {
+  printf("record ring, %d writers (recordLog.h)\n", RING_WRITERS);
+
+  char directory[] = "/tmp/robotTestXXXXXX";
+  if (!mkdtemp(directory)) {
+    check("temporary SD card directory", false);
+    return;
+  }
+  standIn::setSdCardDirectory(directory);
+  setRecordSink(SD_CARD_SINK);
+  uint32_t droppedBefore = getDroppedRecords();
+
+  vex::task recordWriter(recordDrainTask, vex::task::taskPriorityLow);
+  for (int i = 0; i < RING_WRITERS; i++)
+    vex::task writer(ringWriter);
+  while (writersDone.load() < RING_WRITERS)
+    vex::task::sleep(1);
+
+  int acceptedTotal = 0;
+  for (int i = 0; i < RING_WRITERS; i++)
+    acceptedTotal += accepted[i];
+  uint32_t dropped = getDroppedRecords() - droppedBefore;
+
+  // the drain task empties the ring every RECORD_DRAIN_MS, give it a few rounds
+  char path[512];
+  snprintf(path, sizeof(path), "%s/%s", directory, RECORD_FILE);
+  std::vector<uint8_t> file;
+  for (int round = 0; round < 100; round++) {
+    vex::task::sleep(RECORD_DRAIN_MS);
+    FILE *input = fopen(path, "rb");
+    if (!input)
+      continue;
+    file.clear();
+    uint8_t buffer[4096];
+    size_t length;
+    while ((length = fread(buffer, 1, sizeof(buffer), input)) > 0)
+      file.insert(file.end(), buffer, buffer + length);
+    fclose(input);
+    if (file.size() >= acceptedTotal * sizeof(telemetryRecord) + sizeof(recordBatchHeader))
+      break;
+  }
+
+  bool framed = true, inOrder = true, unique = true;
+  int decoded[RING_WRITERS] = {0};
+  int last[RING_WRITERS];
+  for (int i = 0; i < RING_WRITERS; i++)
+    last[i] = -1;
+  std::vector<bool> seen(RING_WRITERS * RING_RECORDS, false);
+  uint32_t lastDropped = 0;
+
+  size_t offset = 0;
+  while (offset + sizeof(recordBatchHeader) <= file.size()) {
+    recordBatchHeader header;
+    memcpy(&header, &file[offset], sizeof(header));
+    offset += sizeof(header);
+    if (header.magic != RECORD_BATCH_MAGIC || header.size != sizeof(telemetryRecord) ||
+        offset + header.count * sizeof(telemetryRecord) > file.size()) {
+      framed = false;
+      break;
+    }
+    lastDropped = header.dropped;
+
+    for (int i = 0; i < header.count; i++, offset += sizeof(telemetryRecord)) {
+      telemetryRecord record;
+      memcpy(&record, &file[offset], sizeof(record));
+      int writer = (int)record.fields[0];
+      int count = (int)record.fields[1];
+      if (record.id != DRIVE_STRAIGHT_RECORD || writer < 0 || writer >= RING_WRITERS ||
+          record.sequence >= seen.size()) {
+        framed = false;
+        continue;
+      }
+      if (count <= last[writer])
+        inOrder = false;
+      if (seen[record.sequence])
+        unique = false;
+      seen[record.sequence] = true;
+      last[writer] = count;
+      decoded[writer]++;
+    }
+  }
+  if (offset != file.size())
+    framed = false;
+
+  bool allDecoded = true;
+  for (int i = 0; i < RING_WRITERS; i++)
+    allDecoded = allDecoded && decoded[i] == accepted[i];
+
+  char line[64];
+  snprintf(line, sizeof(line), "%d written, %d accepted, %u dropped", RING_WRITERS * RING_RECORDS, acceptedTotal,
+           (unsigned)dropped);
+  check(line, acceptedTotal + (int)dropped == RING_WRITERS * RING_RECORDS);
+  check("batches framed", framed);
+  check("every accepted record decoded", allDecoded);
+  check("in order per writer", inOrder);
+  check("sequence numbers unique", unique);
+  check("dropped count in the last batch", lastDropped - droppedBefore == dropped);
+
+  standIn::setSdCardDirectory(NULL);
+  unlink(path);
+  rmdir(directory);
+}
+
+// ---------------------------------------------------------------- capture window (capture.h)
+
+static const int TRIGGER_SAMPLE = 100;
+
+// the sample numbers of the frozen capture, after its trigger record
+static void checkCaptureWindow() {
+  printf("capture window (capture.h)\n");
+
+  telemetryRecord records[CAPTURE_LENGTH + 1];
+  int sample = 0;
+  for (; sample <= TRIGGER_SAMPLE; sample++)
+    captureSample(TURN_CAPTURE, (float)sample);
+  captureTrigger(TURN_CAPTURE, ERROR_TRIGGER, 1.0f);
+  for (; sample < TRIGGER_SAMPLE + 20; sample++)
+    captureSample(TURN_CAPTURE, (float)sample);
+  captureTrigger(TURN_CAPTURE, JAM_TRIGGER, 2.0f); // still recording the first one
+  for (; sample < 300; sample++)
+    captureSample(TURN_CAPTURE, (float)sample);
+
+  int taken = 0, count;
+  while (taken <= CAPTURE_LENGTH && (count = takeCaptureRecords(records + taken, CAPTURE_LENGTH + 1 - taken)) > 0)
+    taken += count;
+
+  const int first = TRIGGER_SAMPLE + 1 - CAPTURE_BEFORE;
+  bool window = taken == CAPTURE_LENGTH + 1;
+  for (int i = 1; window && i <= CAPTURE_LENGTH; i++)
+    window = records[i].id == TURN_CAPTURE_RECORD && records[i].fields[0] == first + i - 1;
+  char line[64];
+  snprintf(line, sizeof(line), "trigger at %d froze samples %d..%d", TRIGGER_SAMPLE, first, first + CAPTURE_LENGTH - 1);
+  check(line, window);
+  check("second trigger ignored",
+        records[0].id == CAPTURE_TRIGGER_RECORD && records[0].fields[1] == ERROR_TRIGGER && records[0].fields[2] == 1.0f &&
+            records[0].fields[3] == CAPTURE_BEFORE);
+
+  // taken out, so it records and triggers again
+  captureTrigger(TURN_CAPTURE, ERROR_TRIGGER, 3.0f);
+  for (int i = 0; i < CAPTURE_AFTER; i++)
+    captureSample(TURN_CAPTURE, (float)sample++);
+  count = takeCaptureRecords(records, 1);
+  check("re-armed after it was taken", count == 1 && records[0].fields[2] == 3.0f);
+  while (takeCaptureRecords(records, CAPTURE_LENGTH + 1) > 0) {
+  }
+}
+
+// ---------------------------------------------------------------- trig (fastMath.h)
+
+static const int TRIG_STEPS = 2000000;
+static const double TRIG_RANGE = 1000; // rad, the range the header quotes the sin/cos error for
+
+// largest error of the kernels against libm over |angle| < TRIG_RANGE, and atan2 all the way round.
+// The reference is libm in double on the same input, so a float kernel isn't charged for the
+// rounding of libm's own float result
+template <class T>
+static void checkTrig(const char *type, double sinLimit, double atan2Limit) {
+  double sinError = 0, atan2Error = 0;
+  for (int i = 0; i <= TRIG_STEPS; i++) {
+    T angle = (T)(-TRIG_RANGE + 2 * TRIG_RANGE * i / TRIG_STEPS);
+    T sine, cosine;
+    math3142a::fastSinCos(angle, sine, cosine);
+    sinError = std::max(sinError, std::fabs((double)math3142a::fastSin(angle) - std::sin((double)angle)));
+    sinError = std::max(sinError, std::fabs((double)math3142a::fastCos(angle) - std::cos((double)angle)));
+    sinError = std::max(sinError, std::fabs((double)sine - std::sin((double)angle)));
+    sinError = std::max(sinError, std::fabs((double)cosine - std::cos((double)angle)));
+
+    // points on circles from 1e-3 to 1e3 across, every direction
+    T radius = (T)std::pow(10.0, -3 + 6.0 * (i % 1000) / 1000);
+    T direction = (T)(math3142a::PI_D * (2.0 * i / TRIG_STEPS * 2 - 1) * 1.0000001);
+    T y = radius * std::sin(direction), x = radius * std::cos(direction);
+    atan2Error = std::max(atan2Error, std::fabs((double)math3142a::fastAtan2(y, x) - std::atan2((double)y, (double)x)));
+  }
+
+  char name[32];
+  snprintf(name, sizeof(name), "%s sin, cos, sincos", type);
+  checkError(name, sinError, sinLimit);
+  snprintf(name, sizeof(name), "%s atan2", type);
+  checkError(name, atan2Error, atan2Limit);
+}
+
+// ---------------------------------------------------------------- solves (matrix.h)
+
+static const int SYSTEMS = 1000; // random systems per size
+
+// largest entry of A x - b
+template <class T, int N, int C>
+static double residual(const math3142a::Matrix<T, N, N> &a, const math3142a::Matrix<T, N, C> &x,
+                       const math3142a::Matrix<T, N, C> &b) {
+  math3142a::Matrix<T, N, C> difference = a * x - b;
+  double largest = 0;
+  for (int r = 0; r < N; r++)
+    for (int c = 0; c < C; c++)
+      largest = std::max(largest, std::fabs((double)difference(r, c)));
+  return (largest);
+}
+
+// LU solve, Cholesky solve and inverse of random well conditioned systems (diagonally dominant,
+// and A^T A of one for Cholesky)
+template <class T, int N>
+static double solveResidual() {
+  typedef math3142a::Matrix<T, N, N> square;
+  double largest = 0;
+  for (int system = 0; system < SYSTEMS; system++) {
+    square a;
+    math3142a::Vector<T, N> b, x;
+    for (int r = 0; r < N; r++) {
+      for (int c = 0; c < N; c++)
+        a(r, c) = (T)(randomUnit() + (r == c ? N : 0));
+      b[r] = (T)randomUnit();
+    }
+
+    if (!math3142a::solve(a, b, x))
+      return (INFINITY);
+    largest = std::max(largest, residual(a, x, b));
+
+    square spd = a.transpose() * a, lower;
+    if (!math3142a::choleskyDecompose(spd, lower))
+      return (INFINITY);
+    largest = std::max(largest, residual(spd, math3142a::choleskySolve(lower, b), b));
+
+    square inverse;
+    if (!math3142a::invert(a, inverse))
+      return (INFINITY);
+    largest = std::max(largest, residual(a, inverse, square::identity()));
+  }
+  return (largest);
+}
+
+template <class T>
+static void checkSolves(const char *type, double limit) {
+  double largest = std::max(std::max(solveResidual<T, 2>(), solveResidual<T, 3>()),
+                            std::max(solveResidual<T, 4>(), solveResidual<T, 6>()));
+  char name[40];
+  snprintf(name, sizeof(name), "%s residual, 2x2 to 6x6", type);
+  checkError(name, largest, limit);
+}
+
+// ---------------------------------------------------------------- filters (filters.h)
+
+static const int MEDIAN_SAMPLES = 20000;
+
+// the streaming median against sorting the window every sample. The samples are coarse so the
+// window has ties in it
+template <int N>
+static int medianMismatches() {
+  math3142a::MovingMedian<float, N> median;
+  float window[N];
+  int mismatches = 0;
+  for (int i = 0; i < MEDIAN_SAMPLES; i++) {
+    float sample = std::floor((float)randomUnit() * 8);
+    float value = median.update(sample);
+    if (i == 0)
+      std::fill(window, window + N, sample);
+    window[i % N] = sample;
+
+    float sorted[N];
+    std::copy(window, window + N, sorted);
+    std::sort(sorted, sorted + N);
+    if (value != sorted[N / 2])
+      mismatches++;
+  }
+  return (mismatches);
+}
+
+static void checkFilters() {
+  printf("filters (filters.h)\n");
+  int mismatches = medianMismatches<3>() + medianMismatches<5>() + medianMismatches<9>();
+  char line[64];
+  snprintf(line, sizeof(line), "median 3, 5, 9 against sorting, %d mismatches", mismatches);
+  check(line, mismatches == 0);
+
+  math3142a::SavitzkyGolayDerivative<double, 5> derivative(0.01);
+  bool exact = true;
+  for (int i = 0; i < 1000; i++) {
+    double slope = derivative.update(0.25 * i);
+    if (i >= 4 && std::fabs(slope - 25) > 1e-9)
+      exact = false;
+  }
+  check("derivative of a ramp", exact);
+}
+
+int runTest() {
+  checkCaptureWindow(); // before the drain task is started, it would take the capture itself
+  checkRecordRing();
+
+  printf("trig against libm (fastMath.h)\n");
+  checkTrig<float>("float", 9e-7, 4e-7);
+  checkTrig<double>("double", 6e-14, 2e-13);
+
+  printf("solves (matrix.h)\n");
+  checkSolves<float>("float", 1e-5);
+  checkSolves<double>("double", 2e-14);
+
+  checkFilters();
+
+  printf("%d failed\n", failures);
+  return (failures > 0 ? 1 : 0);
+}
+
+} // namespace host3142a
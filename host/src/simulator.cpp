@@ -0,0 +1,474 @@
+#include "simulator.h"
+#include "standIn.h"
+#include "Config/chassis-config.h"
+#include "Config/deviceRegistry.h"
+#include <cmath>
+#include <random>
+
+// the drivetrain and ball path simulator (see host/include/simulator.h)
+
+namespace sim3142a {
+
+static const double GRAVITY = 9.81;
+static const double INCH = 0.0254;
+static const int DRIVE_SUBSTEPS = 10; // the wheel slip is stiff, the drive steps ten times a tick
+static const int HISTORY = 128;        // ticks of sensor history kept for the latency
+
+// the ball path, in m from the intake mouth. The intakes move the balls up to INTAKE_END (the
+// indexer's bottom roller reaches down between them, so it can take a ball they hold), the
+// indexer up to INDEXER_END under the flywheel, and forwards the flywheel shoots them out at SCORE_AT.
+// Backwards it throws them down the outy chute instead, out at OUTY_END along it
+static const double INTAKE_END = 0.12;
+static const double INDEXER_END = 0.59;
+static const double SCORE_AT = 0.72;
+static const double OUTY_END = 0.20;
+static const double INTAKE_LINE_AT = 0.06;
+static const double BOTTOM_LINE_AT = 0.24;
+static const double MIDDLE_LINE_AT = 0.40;
+static const double TOP_LINE_AT = 0.56;
+static const double OUTY_LINE_AT = 0.06;  // along the chute
+static const double BALL_GAP = 0.16;      // a ball across, two are never closer
+static const double SENSOR_REACH = 0.04;  // a line sensor sees a ball this close to it
+static const double ROLLER_MOVING = 0.1;  // of the ball speed, slower than this a roller doesn't take a ball
+static const int MAX_BALLS = 8;
+
+/**
+ * struct motorConstants. A DC motor worked out from the motor model and a cartridge
+ */
+
+struct motorConstants {
+  double kT;         // N m per A
+  double kE;         // V per rad/s
+  double resistance; // ohm
+  double maxRpm;
+};
+
+/**
+ * struct chassisState. The truth
+ */
+
+struct chassisState {
+  pose where;
+  double velocity;        // forwards
+  double turnRate;        // rad/s, counter clockwise = positive
+  double wheelSpeed[2];   // rad/s of each side's wheels (left, right), forwards
+  double wheelAngle[2];   // rad each side's wheels turned
+  double trackerTravel[2]; // m under each tracking wheel (right, back)
+};
+
+/**
+ * struct sensorSample. What the sensors would read at one tick, before the latency and noise
+ */
+
+struct sensorSample {
+  double wheelAngle[2];
+  double wheelSpeed[2];
+  double trackerTravel[2];
+  double heading;
+};
+
+/**
+ * struct ball. A ball in the robot
+ */
+
+struct ball {
+  double at;   // m along the ball path, or along the outy chute
+  bool inOuty; // on its way down the outy chute
+};
+
+static simConfig config;
+static chassisState chassis;
+
+static bool driveMotor[vex::SMART_PORTS];
+static double motorSpeed[vex::SMART_PORTS]; // rad/s of each mechanism motor's output, as the motor turns
+static double totalCurrent;                  // A drawn from the battery last tick
+
+static sensorSample history[HISTORY];
+static uint32_t tick;
+
+static std::mt19937 noiseSource;
+static std::normal_distribution<double> gaussian(0, 1);
+static double motorNoise[vex::SMART_PORTS]; // the noise on each reading now, taken off again next tick
+static double trackerNoise[2];
+static double imuNoise;
+
+static ball ballPath[MAX_BALLS]; // front (nearest the flywheel) first
+static int32_t ballCount;
+static uint32_t pullingMs; // the intakes pulling in with room for a ball, towards the next one
+static ballCounts ballTotals;
+
+static motorConstants constantsFor(double maxRpm) {
+  const motorModel &model = config.motor;
+  motorConstants motor;
+  motor.maxRpm = maxRpm;
+  motor.resistance = model.nominalVoltage / model.stallCurrent;
+  motor.kT = model.stallTorque * 200 / maxRpm / model.stallCurrent;
+  motor.kE = model.nominalVoltage / (maxRpm * 2 * M_PI / 60);
+  return (motor);
+}
+
+static double clamp(double value, double limit) { return (value > limit ? limit : value < -limit ? -limit : value); }
+
+// a speed this small is at rest. Left alone it would decay into denormals, which the host is very slow at
+static void settle(double &speed) {
+  if (std::abs(speed) < 1e-9)
+    speed = 0;
+}
+
+/**
+ * current through a motor, from what it was told to do and how fast it turns.
+ * Coasts when stopped, draws no more than its limit, and never gets more than the battery has
+ * @param port the motor's port
+ * @param speed rad/s of its output, the way the motor turns
+ */
+static double motorCurrent(int32_t port, double speed) {
+  const standIn::motorState &state = standIn::motorAt(port);
+  const motorConstants motor = constantsFor(state.maxRpm);
+  const double battery = standIn::batteryVoltage();
+  const double rpm = speed * 60 / (2 * M_PI);
+
+  double volts;
+  switch (state.mode) {
+  case standIn::MOTOR_VOLTAGE:
+    volts = state.command;
+    break;
+  case standIn::MOTOR_VELOCITY: // the motor's own velocity loop, roughly
+    volts = config.motor.nominalVoltage * (state.command + 2 * (state.command - rpm)) / motor.maxRpm;
+    break;
+  default:
+    return (0);
+  }
+  volts = clamp(volts, battery);
+  return (clamp((volts - motor.kE * speed) / motor.resistance, config.motor.stallCurrent));
+}
+
+/*** the drive ***/
+
+static void stepDrive(double dt) {
+  const drivetrainModel &drive = config.drive;
+  const double radius = drive.wheelDiameter / 2;
+  const double halfTrack = drive.trackWidth / 2;
+  const double tractionLimit = drive.traction * drive.mass * GRAVITY / 2; // half the weight on each side
+
+  double force[2];
+  for (int side = 0; side < 2; side++) {
+    const int32_t *ports = side == 0 ? drive.leftPorts : drive.rightPorts;
+    const double direction = (side == 0 ? drive.leftMirrored : drive.rightMirrored) ? -1 : 1;
+
+    // the motors turn gearRatio times slower than the wheels, with gearRatio times the torque
+    double torque = 0;
+    for (int i = 0; i < 2; i++) {
+      const double speed = direction * chassis.wheelSpeed[side] / drive.gearRatio;
+      const double current = motorCurrent(ports[i], speed);
+      torque += direction * constantsFor(standIn::motorAt(ports[i]).maxRpm).kT * current / drive.gearRatio;
+      standIn::motorAt(ports[i]).current = std::abs(current);
+      totalCurrent += std::abs(current) / DRIVE_SUBSTEPS;
+    }
+
+    // the carpet pushes back against the slip, up to what the wheels can grip
+    const double groundSpeed = chassis.velocity + (side == 0 ? -1 : 1) * chassis.turnRate * halfTrack;
+    const double slip = chassis.wheelSpeed[side] * radius - groundSpeed;
+    force[side] = clamp(drive.slipStiffness * slip, tractionLimit);
+
+    chassis.wheelSpeed[side] += (torque - force[side] * radius) / drive.wheelInertia * dt;
+    settle(chassis.wheelSpeed[side]);
+    chassis.wheelAngle[side] += chassis.wheelSpeed[side] * dt;
+  }
+
+  // resistance is smoothed through zero so a chassis at rest stays at rest
+  const double push = force[0] + force[1] - drive.rollingResistance * std::tanh(chassis.velocity / 0.01);
+  const double twist = (force[1] - force[0]) * halfTrack - drive.turningResistance * std::tanh(chassis.turnRate / 0.05);
+  chassis.velocity += push / drive.mass * dt;
+  chassis.turnRate += twist / drive.yawInertia * dt;
+  settle(chassis.velocity);
+  settle(chassis.turnRate);
+
+  pose &where = chassis.where;
+  where.heading += chassis.turnRate * dt;
+  where.x += chassis.velocity * std::cos(where.heading) * dt;
+  where.y += chassis.velocity * std::sin(where.heading) * dt;
+
+  const trackerModel &trackers = config.trackers;
+  chassis.trackerTravel[0] += (chassis.velocity + chassis.turnRate * trackers.rightOffset) * dt;
+  chassis.trackerTravel[1] += -chassis.turnRate * trackers.backOffset * dt;
+}
+
+/*** the mechanisms ***/
+
+// every motor that isn't on the drive spins a load of its own
+static void stepMechanismMotors(double dt) {
+  for (int32_t port = 0; port < vex::SMART_PORTS; port++) {
+    standIn::motorState &state = standIn::motorAt(port);
+    if (state.maxRpm == 0 || driveMotor[port])
+      continue;
+
+    const motorConstants motor = constantsFor(state.maxRpm);
+    const double current = motorCurrent(port, motorSpeed[port]);
+    const double friction = 0.05 * config.motor.stallTorque * 200 / motor.maxRpm * std::tanh(motorSpeed[port]);
+    motorSpeed[port] += (motor.kT * current - friction) / config.balls.loadInertia * dt;
+    settle(motorSpeed[port]);
+
+    state.position += motorSpeed[port] * dt * 180 / M_PI;
+    state.velocity = motorSpeed[port] * 60 / (2 * M_PI);
+    state.current = std::abs(current);
+    totalCurrent += std::abs(current);
+  }
+}
+
+// how fast a mechanism moves a ball along, forwards the way the robot code means it
+static double surfaceSpeed(const mechanismMotor &motor) {
+  const double direction = motor.mirrored ? -1 : 1;
+  const double freeSpeed = standIn::motorAt(motor.port).maxRpm * 2 * M_PI / 60;
+  return (freeSpeed > 0 ? direction * motorSpeed[motor.port] / freeSpeed * config.balls.ballSpeed : 0);
+}
+
+static void removeBall(int32_t index) {
+  for (int32_t i = index; i + 1 < ballCount; i++)
+    ballPath[i] = ballPath[i + 1];
+  ballCount--;
+}
+
+static int32_t lineReading(double sensorAt, bool outy) {
+  for (int32_t i = 0; i < ballCount; i++)
+    if (ballPath[i].inOuty == outy && std::abs(ballPath[i].at - sensorAt) < SENSOR_REACH)
+      return (config.balls.lineBall);
+  return (config.balls.lineEmpty);
+}
+
+static void stepBalls(double dt) {
+  const ballPathModel &balls = config.balls;
+  const double intake = (surfaceSpeed(balls.intakeL) + surfaceSpeed(balls.intakeR)) / 2;
+  const double indexer = surfaceSpeed(balls.indexer);
+  const double flywheel = surfaceSpeed(balls.flywheel);
+  const double moving = ROLLER_MOVING * balls.ballSpeed;
+
+  // front to back, so each ball stops behind the one in front of it
+  double ahead = 1e9;
+  for (int32_t i = 0; i < ballCount; i++) {
+    ball &b = ballPath[i];
+    if (b.inOuty) {
+      b.at += (flywheel < 0 ? -flywheel : 0) * dt;
+      if (b.at > OUTY_END) {
+        removeBall(i--);
+        ballTotals.ejected++;
+      }
+      continue;
+    }
+
+    double speed = b.at < INTAKE_END ? (indexer > intake ? indexer : intake)
+                   : b.at < INDEXER_END ? indexer : (flywheel > moving ? flywheel : 0);
+    double at = b.at + speed * dt;
+    if (b.at < INDEXER_END && at >= INDEXER_END) {
+      if (flywheel < -moving) { // the flywheel throws it down the chute
+        b.inOuty = true;
+        b.at = 0;
+        continue;
+      }
+      if (flywheel < moving)
+        at = INDEXER_END; // held under the flywheel
+    }
+    b.at = std::min(at, ahead - BALL_GAP);
+    ahead = b.at;
+
+    if (b.at > SCORE_AT) {
+      removeBall(i--);
+      ballTotals.scored++;
+      ahead = 1e9;
+    } else if (b.at < 0) {
+      removeBall(i--);
+      ballTotals.dropped++;
+    }
+  }
+
+  // a ball for the intakes once they have pulled in long enough, with room for it all along
+  bool room = ballCount < balls.capacity && ballCount < MAX_BALLS;
+  for (int32_t i = 0; i < ballCount; i++)
+    room = room && (ballPath[i].inOuty || ballPath[i].at >= BALL_GAP);
+  pullingMs = intake > moving && room ? pullingMs + (uint32_t)(dt * 1000 + 0.5) : 0;
+  if (pullingMs >= balls.pickupTime) {
+    ballPath[ballCount].at = 0;
+    ballPath[ballCount].inOuty = false;
+    ballCount++;
+    ballTotals.pickedUp++;
+    pullingMs = 0;
+  }
+
+  standIn::lineAt(balls.intakeLine) = lineReading(INTAKE_LINE_AT, false);
+  standIn::lineAt(balls.bottomLine) = lineReading(BOTTOM_LINE_AT, false);
+  standIn::lineAt(balls.middleLine) = lineReading(MIDDLE_LINE_AT, false);
+  standIn::lineAt(balls.topLine) = lineReading(TOP_LINE_AT, false);
+  standIn::lineAt(balls.outyLine) = lineReading(OUTY_LINE_AT, true);
+}
+
+/*** the sensors ***/
+
+// noise for one reading: the new noise minus what was put on the last one, so it never adds up
+static double renoise(double &last, double deviation) {
+  double next = deviation * gaussian(noiseSource);
+  double change = next - last;
+  last = next;
+  return (change);
+}
+
+static const sensorSample &sampleBefore(uint32_t ticks) {
+  uint32_t back = ticks < tick ? ticks : tick;
+  return (history[(tick - back) % HISTORY]);
+}
+
+static uint32_t latencyTicks(uint32_t ms) {
+  uint32_t ticks = ms * 1000 / config.tickUs;
+  return (ticks < HISTORY - 2 ? ticks : HISTORY - 2);
+}
+
+// moves every sensor on by what changed since the last tick, as late as it reports it.
+// Moving them on instead of setting them keeps whatever the robot code reset them to
+static void stepSensors(double dt) {
+  sensorSample &now = history[tick % HISTORY];
+  for (int side = 0; side < 2; side++) {
+    now.wheelAngle[side] = chassis.wheelAngle[side];
+    now.wheelSpeed[side] = chassis.wheelSpeed[side];
+  }
+  for (int i = 0; i < 2; i++)
+    now.trackerTravel[i] = chassis.trackerTravel[i];
+  now.heading = chassis.where.heading;
+
+  const sensorModel &sensors = config.sensors;
+  const drivetrainModel &drive = config.drive;
+
+  const uint32_t encoderLatency = latencyTicks(sensors.encoderLatency);
+  const sensorSample &encoders = sampleBefore(encoderLatency);
+  const sensorSample &encodersBefore = sampleBefore(encoderLatency + 1);
+  for (int side = 0; side < 2; side++) {
+    const int32_t *ports = side == 0 ? drive.leftPorts : drive.rightPorts;
+    const double direction = (side == 0 ? drive.leftMirrored : drive.rightMirrored) ? -1 : 1;
+    const double turned = (encoders.wheelAngle[side] - encodersBefore.wheelAngle[side]) / drive.gearRatio;
+    for (int i = 0; i < 2; i++) {
+      standIn::motorState &state = standIn::motorAt(ports[i]);
+      state.position += direction * turned * 180 / M_PI + renoise(motorNoise[ports[i]], sensors.encoderNoise);
+      state.velocity = direction * encoders.wheelSpeed[side] / drive.gearRatio * 60 / (2 * M_PI);
+    }
+  }
+
+  const trackerModel &trackers = config.trackers;
+  const vex::triport::port *trackerPorts[2] = {&trackers.right, &trackers.back};
+  for (int i = 0; i < 2; i++) {
+    const double travel = encoders.trackerTravel[i] - encodersBefore.trackerTravel[i];
+    standIn::encoderAt(*trackerPorts[i]) +=
+        travel / (M_PI * trackers.wheelDiameter) * 360 + renoise(trackerNoise[i], sensors.encoderNoise);
+  }
+
+  // the inertial sensor counts clockwise, the chassis heading counter clockwise
+  const uint32_t imuLatency = latencyTicks(sensors.imuLatency);
+  const double turned = sampleBefore(imuLatency).heading - sampleBefore(imuLatency + 1).heading;
+  standIn::inertialAt(sensors.inertialPort).rotation +=
+      -turned * 180 / M_PI + sensors.imuDrift * dt + renoise(imuNoise, sensors.imuNoise);
+
+  tick++;
+}
+
+/*** ticks ***/
+
+// one tick of everything, called by the stand-in whenever the virtual clock moves on
+static void step(double seconds) {
+  totalCurrent = 0;
+  for (int i = 0; i < DRIVE_SUBSTEPS; i++)
+    stepDrive(seconds / DRIVE_SUBSTEPS);
+  stepMechanismMotors(seconds);
+  stepBalls(seconds);
+  stepSensors(seconds);
+
+  // everything drew from the battery at once, so the next tick gets what is left
+  standIn::batteryVoltage() = config.battery.openVoltage - config.battery.resistance * totalCurrent;
+}
+
+simConfig defaultConfig() {
+  simConfig defaults;
+
+  // a 100 rpm V5 motor stalls at 2.1 N m, at its 2.5 A limit
+  defaults.motor = {1.05, 2.5, 12};
+
+  drivetrainModel &drive = defaults.drive;
+  for (int i = 0; i < 2; i++) {
+    drive.leftPorts[i] = devices.driveLeft[i].index();
+    drive.rightPorts[i] = devices.driveRight[i].index();
+  }
+  drive.leftMirrored = true; // resetMotorsStage reverses the left side
+  drive.rightMirrored = false;
+  drive.gearRatio = CHASSIS_CONSTANTS.gearRatio();
+  drive.wheelDiameter = CHASSIS_CONSTANTS.wheelRadius(); // the conversions take the wheel size as its diameter
+  drive.trackWidth = CHASSIS_CONSTANTS.trackWidth();
+  drive.mass = 6.8;
+  drive.yawInertia = 0.18;
+  drive.wheelInertia = 0.0015;
+  drive.traction = 0.9;
+  drive.slipStiffness = 2000;
+  drive.rollingResistance = 4;
+  drive.turningResistance = 0.8;
+
+  defaults.battery = {12.8, 0.1};
+
+  trackerModel &trackers = defaults.trackers;
+  trackers.right = Brain.ThreeWirePort.C; // the ports in deviceRegistry.cpp
+  trackers.back = Brain.ThreeWirePort.A;
+  trackers.rightOffset = poseTracker.m_odomImpl.R_DISTANCE * INCH;
+  trackers.backOffset = poseTracker.m_odomImpl.B_DISTANCE * INCH;
+  trackers.wheelDiameter = poseTracker.wheelRadius * INCH; // the wheel size again
+
+  sensorModel &sensors = defaults.sensors;
+  sensors.inertialPort = devices.inert.index();
+  sensors.encoderNoise = 0.2;
+  sensors.imuNoise = 0.1;
+  sensors.imuDrift = 0.01;
+  sensors.encoderLatency = 10;
+  sensors.imuLatency = 10;
+  sensors.seed = 3142;
+
+  // reversed like deviceRegistry.cpp builds them
+  ballPathModel &balls = defaults.balls;
+  balls.intakeL = {devices.intakeL.index(), false};
+  balls.intakeR = {devices.intakeR.index(), true};
+  balls.indexer = {devices.indexer.index(), false};
+  balls.flywheel = {devices.flywheel.index(), true};
+  balls.intakeLine = Brain.ThreeWirePort.G;
+  balls.bottomLine = devices.expander.F;
+  balls.middleLine = devices.expander.G;
+  balls.topLine = devices.expander.H;
+  balls.outyLine = devices.expander.E;
+  balls.loadInertia = 0.002;
+  balls.ballSpeed = 1.0;
+  balls.pickupTime = 2000; // pulling one out of the bottom of a goal takes a while
+  balls.capacity = 3;
+  balls.preloads = 1;
+  balls.lineEmpty = 3100; // above every threshold in other-config.h
+  balls.lineBall = 2000;  // below every one
+
+  defaults.tickUs = 1000;
+  return (defaults);
+}
+
+void start(const simConfig &simulated) {
+  config = simulated;
+  noiseSource.seed(config.sensors.seed);
+
+  for (int i = 0; i < 2; i++) {
+    driveMotor[config.drive.leftPorts[i]] = true;
+    driveMotor[config.drive.rightPorts[i]] = true;
+  }
+
+  // the preloads from the top down
+  ballCount = 0;
+  for (int32_t i = 0; i < config.balls.preloads && i < config.balls.capacity && i < MAX_BALLS; i++) {
+    ballPath[ballCount].at = TOP_LINE_AT - i * BALL_GAP;
+    ballPath[ballCount].inOuty = false;
+    ballCount++;
+  }
+
+  standIn::batteryVoltage() = config.battery.openVoltage;
+  standIn::startVirtualTime(step, config.tickUs);
+}
+
+pose truePose() { return (chassis.where); }
+
+ballCounts balls() { return (ballTotals); }
+
+} // namespace sim3142a
@@ -0,0 +1,595 @@
+#include "standIn.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cmath>
+#include <mutex>
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+
+// the stand-in for the part of the VEX SDK the robot code uses (see host/include/v5_vcs.h)
+
+namespace standIn {
+
+static const int32_t TRIPORT_SLOTS = (vex::BRAIN_TRIPORT + 1) * 8;
+static const uint32_t CALIBRATION_MS = 2000; // about what the real sensor takes
+static const int32_t LINE_EMPTY = 4095;       // nothing in front of the sensor
+
+static motorState motors[vex::SMART_PORTS];
+static inertialState inertials[vex::SMART_PORTS];
+static int32_t lines[TRIPORT_SLOTS];
+static double encoders[TRIPORT_SLOTS];
+static double battery = 12.8;
+
+static char sdCardDirectory[256];
+
+motorState &motorAt(int32_t port) { return (motors[port]); }
+inertialState &inertialAt(int32_t port) { return (inertials[port]); }
+int32_t &lineAt(const vex::triport::port &port) { return (lines[port.slot()]); }
+double &encoderAt(const vex::triport::port &port) { return (encoders[port.slot()]); }
+double &batteryVoltage() { return (battery); }
+
+void setSdCardDirectory(const char *path) {
+  snprintf(sdCardDirectory, sizeof(sdCardDirectory), "%s", path ? path : "");
+}
+
+// the line sensors read empty until something says otherwise
+static struct lineDefaults {
+  lineDefaults() {
+    for (int i = 0; i < TRIPORT_SLOTS; i++)
+      lines[i] = LINE_EMPTY;
+  }
+} setLineDefaults;
+
+// path of a file on the SD card, false if there is no card
+static bool sdPath(const char *name, char *path, size_t size) {
+  if (sdCardDirectory[0] == 0)
+    return false;
+  snprintf(path, size, "%s/%s", sdCardDirectory, name);
+  return true;
+}
+
+} // namespace standIn
+
+namespace vex {
+
+const color color::transparent(0);
+const color color::white(0xFFFFFF);
+const color color::black(0x000000);
+const color color::red(0xFF0000);
+const color color::green(0x00FF00);
+const color color::blue(0x0000FF);
+const color color::yellow(0xFFFF00);
+const color color::orange(0xFFA500);
+const color color::cyan(0x00FFFF);
+const color color::purple(0xFF00FF);
+
+/*** time ***/
+
+// "power on" is the first time anything asks for the time, during static init at the latest
+static std::chrono::steady_clock::time_point powerOn() {
+  static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  return (start);
+}
+static std::chrono::steady_clock::time_point startClock = powerOn();
+
+static uint64_t realMicros() {
+  return ((uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - powerOn())
+              .count());
+}
+
+} // namespace vex
+
+/*
+* Virtual time (see standIn::startVirtualTime)
+*
+* The brain's scheduler is cooperative, a task runs until it sleeps or yields. Here the tasks are
+* still threads, but only the one holding the baton runs, the others wait on their slot. Sleeping
+* or yielding hands the baton to the next task that is due (round robin). When every task is
+* asleep the clock jumps to the earliest wake up, stepping the hardware on the way, so nothing
+* ever waits for real time. Sleeping and handing over never allocate, a control loop can sleep
+* inside a ControlCriticalSection (see Util/allocTracker.h)
+*/
+
+namespace standIn {
+
+static const int TASK_SLOTS = 32;
+static const int NO_SLOT = -1;
+
+/**
+ * struct taskSlot. One task under the virtual scheduler
+ */
+
+struct taskSlot {
+  bool used;
+  uint64_t wakeAt; // virtual us, due when it is <= now
+  std::condition_variable wake;
+  int (*noArg)(void);
+  int (*withArg)(void *);
+  void (*noResult)(void);
+  void *arg;
+};
+
+static bool virtualTime = false;
+static std::atomic<uint64_t> virtualNow(0);
+static uint32_t hardwareTickUs = 1000;
+static void (*hardwareStep)(double seconds) = NULL;
+
+static std::mutex schedulerLock;
+static taskSlot taskSlots[TASK_SLOTS];
+static int running = NO_SLOT; // slot holding the baton
+static thread_local int currentSlot = NO_SLOT;
+
+// moves the clock on to time, stepping the hardware every tick on the way
+static void advanceTo(uint64_t time) {
+  uint64_t now = virtualNow.load();
+  while (now < time) {
+    uint64_t step = time - now < hardwareTickUs ? time - now : hardwareTickUs;
+    now += step;
+    virtualNow.store(now);
+    if (hardwareStep)
+      hardwareStep(step * 1e-6);
+  }
+}
+
+// the next slot that is due after from (round robin, from itself last), moving the clock on until one is
+static int nextDue(int from) {
+  while (true) {
+    uint64_t now = virtualNow.load();
+    uint64_t earliest = UINT64_MAX;
+    for (int k = 1; k <= TASK_SLOTS; k++) {
+      int i = (from + k) % TASK_SLOTS;
+      if (!taskSlots[i].used)
+        continue;
+      if (taskSlots[i].wakeAt <= now)
+        return (i);
+      earliest = taskSlots[i].wakeAt < earliest ? taskSlots[i].wakeAt : earliest;
+    }
+    advanceTo(earliest);
+  }
+}
+
+// gives the baton to next and waits until it comes back
+static void handOver(std::unique_lock<std::mutex> &lock, int me, int next) {
+  running = next;
+  if (next == me)
+    return;
+  taskSlots[next].wake.notify_one();
+  taskSlots[me].wake.wait(lock, [me]() { return (running == me); });
+}
+
+static void sleepVirtual(uint64_t micros) {
+  std::unique_lock<std::mutex> lock(schedulerLock);
+  int me = currentSlot;
+  taskSlots[me].wakeAt = virtualNow.load() + micros;
+  handOver(lock, me, nextDue(me));
+}
+
+// lets the others run. If none of them is due the time moves on by a tick, so a task spinning
+// on something another task will do later still gets there
+static void yieldVirtual() {
+  std::unique_lock<std::mutex> lock(schedulerLock);
+  int me = currentSlot;
+  taskSlots[me].wakeAt = virtualNow.load();
+  int next = nextDue(me);
+  if (next == me)
+    advanceTo(virtualNow.load() + hardwareTickUs);
+  handOver(lock, me, next);
+}
+
+static void runSlot(int slot) {
+  currentSlot = slot;
+  {
+    std::unique_lock<std::mutex> lock(schedulerLock);
+    taskSlots[slot].wake.wait(lock, [slot]() { return (running == slot); });
+  }
+
+  taskSlot &entry = taskSlots[slot];
+  if (entry.noArg)
+    entry.noArg();
+  else if (entry.withArg)
+    entry.withArg(entry.arg);
+  else
+    entry.noResult();
+
+  // the task returned, pass the baton on for good
+  std::unique_lock<std::mutex> lock(schedulerLock);
+  entry.used = false;
+  running = nextDue(slot);
+  taskSlots[running].wake.notify_one();
+}
+
+// starts a task, a thread of its own under the virtual scheduler or a plain thread without it
+static void startTask(int (*noArg)(void), int (*withArg)(void *), void (*noResult)(void), void *arg) {
+  if (!virtualTime) {
+    if (noArg)
+      std::thread(noArg).detach();
+    else if (withArg)
+      std::thread(withArg, arg).detach();
+    else
+      std::thread(noResult).detach();
+    return;
+  }
+
+  int slot = NO_SLOT;
+  {
+    std::lock_guard<std::mutex> lock(schedulerLock);
+    for (int i = 0; i < TASK_SLOTS && slot == NO_SLOT; i++)
+      slot = taskSlots[i].used ? NO_SLOT : i;
+    if (slot == NO_SLOT) {
+      fprintf(stderr, "stand-in: more than %d tasks\n", TASK_SLOTS);
+      abort();
+    }
+    taskSlot &entry = taskSlots[slot];
+    entry.used = true;
+    entry.wakeAt = virtualNow.load(); // due right away, it runs when the one starting it sleeps
+    entry.noArg = noArg;
+    entry.withArg = withArg;
+    entry.noResult = noResult;
+    entry.arg = arg;
+  }
+  std::thread(runSlot, slot).detach();
+}
+
+void startVirtualTime(void (*step)(double seconds), uint32_t tickUs) {
+  std::lock_guard<std::mutex> lock(schedulerLock);
+  virtualNow.store(vex::realMicros());
+  hardwareStep = step;
+  hardwareTickUs = tickUs;
+
+  // whoever starts it is the first task (the host program's main)
+  currentSlot = 0;
+  taskSlots[0].used = true;
+  taskSlots[0].wakeAt = virtualNow.load();
+  running = 0;
+  virtualTime = true;
+}
+
+} // namespace standIn
+
+namespace vex {
+
+uint64_t timer::systemHighResolution() {
+  return (standIn::virtualTime ? standIn::virtualNow.load() : realMicros());
+}
+
+uint32_t timer::system() { return ((uint32_t)(systemHighResolution() / 1000)); }
+
+timer::timer() : m_start(systemHighResolution()) {}
+void timer::clear() { m_start = systemHighResolution(); }
+uint32_t timer::time() { return ((uint32_t)((systemHighResolution() - m_start) / 1000)); }
+double timer::time(timeUnits units) {
+  double seconds = (systemHighResolution() - m_start) * 1e-6;
+  return (units == timeUnits::sec ? seconds : seconds * 1000);
+}
+
+// sleeps on the host's clock, or on the virtual one
+static void sleepMicros(uint64_t micros) {
+  if (standIn::virtualTime && standIn::currentSlot != standIn::NO_SLOT)
+    standIn::sleepVirtual(micros);
+  else
+    std::this_thread::sleep_for(std::chrono::microseconds(micros));
+}
+
+void wait(double time, timeUnits units) { sleepMicros((uint64_t)(units == timeUnits::sec ? time * 1e6 : time * 1e3)); }
+
+/*** tasks ***/
+
+task::task() : m_priority(taskPriorityNormal) {}
+task::task(int (*callback)(void)) : task(callback, taskPriorityNormal) {}
+task::task(int (*callback)(void), int32_t priority) : m_priority(priority) {
+  standIn::startTask(callback, NULL, NULL, NULL);
+}
+task::task(int (*callback)(void *), void *arg) : task(callback, arg, taskPriorityNormal) {}
+task::task(int (*callback)(void *), void *arg, int32_t priority) : m_priority(priority) {
+  standIn::startTask(NULL, callback, NULL, arg);
+}
+
+// a task can't be stopped from the outside, the robot code never does
+bool task::stop() { return false; }
+bool task::suspend() { return false; }
+bool task::resume() { return false; }
+int32_t task::priority() { return (m_priority); }
+void task::setPriority(int32_t priority) { m_priority = priority; }
+
+void task::sleep(uint32_t time) { sleepMicros((uint64_t)time * 1000); }
+
+void task::yield() {
+  if (standIn::virtualTime && standIn::currentSlot != standIn::NO_SLOT)
+    standIn::yieldVirtual();
+  else
+    std::this_thread::yield();
+}
+
+thread::thread(int (*callback)(void)) { standIn::startTask(callback, NULL, NULL, NULL); }
+thread::thread(void (*callback)(void)) { standIn::startTask(NULL, NULL, callback, NULL); }
+
+namespace this_thread {
+void sleep_for(uint32_t time) { task::sleep(time); }
+void yield() { task::yield(); }
+
+int32_t get_id() {
+  static std::atomic<int32_t> nextId(1);
+  static thread_local int32_t id = nextId.fetch_add(1);
+  return (id);
+}
+} // namespace this_thread
+
+// a task waiting on a lock has to let the holder run, under the virtual scheduler that is a yield
+void mutex::lock() {
+  if (!standIn::virtualTime) {
+    m_mutex.lock();
+    return;
+  }
+  while (!m_mutex.try_lock())
+    task::yield();
+}
+void mutex::unlock() { m_mutex.unlock(); }
+bool mutex::try_lock() { return (m_mutex.try_lock()); }
+
+/*** motors ***/
+
+// output shaft free speed of each cartridge
+static int32_t cartridgeRpm(gearSetting gears) {
+  return (gears == gearSetting::ratio36_1 ? 100 : gears == gearSetting::ratio6_1 ? 600 : 200);
+}
+
+// encoder counts per output turn, what rotationUnits::raw reports
+static double cartridgeTicks(gearSetting gears) {
+  return (gears == gearSetting::ratio36_1 ? 1800 : gears == gearSetting::ratio6_1 ? 300 : 900);
+}
+
+motor::motor(int32_t index) : motor(index, gearSetting::ratio18_1, false) {}
+motor::motor(int32_t index, bool reverse) : motor(index, gearSetting::ratio18_1, reverse) {}
+motor::motor(int32_t index, gearSetting gears, bool reverse) : device(index), m_reversed(reverse), m_gears(gears) {
+  standIn::motorAt(_index).maxRpm = cartridgeRpm(gears);
+}
+
+void motor::setReversed(bool reverse) { m_reversed = reverse; }
+
+void motor::spin(directionType dir, double value, voltageUnits units) {
+  standIn::motorState &state = standIn::motorAt(_index);
+  double volts = units == voltageUnits::mV ? value / 1000 : value;
+  state.mode = standIn::MOTOR_VOLTAGE;
+  state.command = (dir == directionType::fwd) != m_reversed ? volts : -volts;
+}
+
+void motor::spin(directionType dir, double value, velocityUnits units) {
+  standIn::motorState &state = standIn::motorAt(_index);
+  double rpm = units == velocityUnits::pct ? value / 100 * cartridgeRpm(m_gears)
+                                           : units == velocityUnits::dps ? value / 6 : value;
+  state.mode = standIn::MOTOR_VELOCITY;
+  state.command = (dir == directionType::fwd) != m_reversed ? rpm : -rpm;
+}
+
+void motor::stop() {
+  standIn::motorState &state = standIn::motorAt(_index);
+  state.mode = standIn::MOTOR_STOPPED;
+  state.command = 0;
+}
+
+double motor::position(rotationUnits units) {
+  double degrees = standIn::motorAt(_index).position * (m_reversed ? -1 : 1);
+  return (units == rotationUnits::rev ? degrees / 360
+                                      : units == rotationUnits::raw ? degrees / 360 * cartridgeTicks(m_gears) : degrees);
+}
+
+double motor::rotation(rotationUnits units) { return (position(units)); }
+
+void motor::setPosition(double value, rotationUnits units) {
+  double degrees = units == rotationUnits::rev ? value * 360
+                                               : units == rotationUnits::raw ? value / cartridgeTicks(m_gears) * 360 : value;
+  standIn::motorAt(_index).position = degrees * (m_reversed ? -1 : 1);
+}
+
+void motor::resetPosition() { standIn::motorAt(_index).position = 0; }
+void motor::resetRotation() { resetPosition(); }
+
+double motor::velocity(velocityUnits units) {
+  double rpm = standIn::motorAt(_index).velocity * (m_reversed ? -1 : 1);
+  return (units == velocityUnits::pct ? rpm / cartridgeRpm(m_gears) * 100 : units == velocityUnits::dps ? rpm * 6 : rpm);
+}
+
+// what the motor is driving its windings with
+double motor::voltage(voltageUnits units) {
+  const standIn::motorState &state = standIn::motorAt(_index);
+  double volts = state.mode == standIn::MOTOR_VOLTAGE
+                     ? state.command
+                     : state.mode == standIn::MOTOR_VELOCITY ? state.command / state.maxRpm * 12 : 0;
+  volts *= m_reversed ? -1 : 1;
+  return (units == voltageUnits::mV ? volts * 1000 : volts);
+}
+
+double motor::current() { return (standIn::motorAt(_index).current); }
+double motor::temperature(percentUnits) { return (0); }
+
+/*** 3 wire devices ***/
+
+triport::triport(int32_t index)
+    : device(index), A(Port[0]), B(Port[1]), C(Port[2]), D(Port[3]), E(Port[4]), F(Port[5]), G(Port[6]), H(Port[7]) {
+  for (int i = 0; i < 8; i++)
+    Port[i] = port(index, i);
+}
+
+triport::triport(const triport &other)
+    : device(other), A(Port[0]), B(Port[1]), C(Port[2]), D(Port[3]), E(Port[4]), F(Port[5]), G(Port[6]), H(Port[7]) {
+  for (int i = 0; i < 8; i++)
+    Port[i] = other.Port[i];
+}
+
+encoder::encoder(triport::port &port) : m_slot(port.slot()) {}
+
+double encoder::position(rotationUnits units) {
+  double degrees = standIn::encoders[m_slot];
+  return (units == rotationUnits::rev ? degrees / 360 : degrees); // 360 counts a turn, so raw is degrees
+}
+
+double encoder::rotation(rotationUnits units) { return (position(units)); }
+
+void encoder::setPosition(double value, rotationUnits units) {
+  standIn::encoders[m_slot] = units == rotationUnits::rev ? value * 360 : value;
+}
+
+void encoder::resetRotation() { standIn::encoders[m_slot] = 0; }
+
+line::line(triport::port &port) : m_slot(port.slot()) {}
+
+int32_t line::value(analogUnits units) {
+  int32_t raw = standIn::lines[m_slot];
+  switch (units) {
+  case analogUnits::range8bit:
+    return (raw >> 4);
+  case analogUnits::range10bit:
+    return (raw >> 2);
+  case analogUnits::pct:
+    return (raw * 100 / 4095);
+  case analogUnits::mV:
+    return (raw * 5000 / 4095);
+  default:
+    return (raw);
+  }
+}
+
+/*** inertial ***/
+
+inertial::inertial(int32_t index) : device(index) {}
+
+void inertial::calibrate(int32_t) { standIn::inertialAt(_index).calibrateUntil = timer::system() + standIn::CALIBRATION_MS; }
+bool inertial::isCalibrating() { return (timer::system() < standIn::inertialAt(_index).calibrateUntil); }
+
+double inertial::rotation(rotationUnits units) {
+  double degrees = standIn::inertialAt(_index).rotation;
+  return (units == rotationUnits::rev ? degrees / 360 : degrees);
+}
+
+double inertial::heading(rotationUnits units) {
+  double degrees = std::fmod(standIn::inertialAt(_index).rotation, 360.0);
+  degrees += degrees < 0 ? 360 : 0;
+  return (units == rotationUnits::rev ? degrees / 360 : degrees);
+}
+
+void inertial::setRotation(double value, rotationUnits units) {
+  standIn::inertialAt(_index).rotation = units == rotationUnits::rev ? value * 360 : value;
+}
+
+void inertial::resetRotation() { standIn::inertialAt(_index).rotation = 0; }
+
+/*** brain ***/
+
+brain::brain() : m_timerStart(timer::systemHighResolution()) {}
+
+double brain::timer(timeUnits units) {
+  double seconds = (timer::systemHighResolution() - m_timerStart) * 1e-6;
+  return (units == timeUnits::sec ? seconds : seconds * 1000);
+}
+
+void brain::resetTimer() { m_timerStart = timer::systemHighResolution(); }
+
+// nothing is drawn on the host
+void brain::lcd::print(const char *, ...) {}
+void brain::lcd::print(double) {}
+void brain::lcd::print(int) {}
+void brain::lcd::printAt(int32_t, int32_t, const char *, ...) {}
+void brain::lcd::setCursor(int32_t, int32_t) {}
+void brain::lcd::clearScreen() {}
+void brain::lcd::clearScreen(const color &) {}
+void brain::lcd::clearLine(int32_t) {}
+void brain::lcd::clearLine() {}
+void brain::lcd::drawRectangle(int, int, int, int) {}
+void brain::lcd::drawRectangle(int, int, int, int, const color &) {}
+void brain::lcd::drawLine(int, int, int, int) {}
+void brain::lcd::drawPixel(int, int) {}
+void brain::lcd::drawCircle(int, int, int) {}
+void brain::lcd::setPenColor(const color &) {}
+void brain::lcd::setFillColor(const color &) {}
+void brain::lcd::setFont(int) {}
+void brain::lcd::setPenWidth(uint32_t) {}
+bool brain::lcd::drawImageFromFile(const char *, int, int) { return false; }
+void brain::lcd::pressed(void (*)(void)) {}
+void brain::lcd::released(void (*)(void)) {}
+int32_t brain::lcd::xPosition() { return (0); }
+int32_t brain::lcd::yPosition() { return (0); }
+bool brain::lcd::pressing() { return false; }
+bool brain::lcd::render() { return true; }
+bool brain::lcd::render(bool, bool) { return true; }
+
+bool brain::sdcard::isInserted() { return (standIn::sdCardDirectory[0] != 0); }
+
+int32_t brain::sdcard::loadfile(const char *name, uint8_t *buffer, int32_t length) {
+  char path[512];
+  FILE *file = standIn::sdPath(name, path, sizeof(path)) ? fopen(path, "rb") : NULL;
+  if (!file)
+    return (0);
+  int32_t read = (int32_t)fread(buffer, 1, length, file);
+  fclose(file);
+  return (read);
+}
+
+// writes or appends, returns the bytes written like the SDK
+static int32_t writeFile(const char *name, const char *mode, const uint8_t *buffer, int32_t length) {
+  char path[512];
+  FILE *file = standIn::sdPath(name, path, sizeof(path)) ? fopen(path, mode) : NULL;
+  if (!file)
+    return (0);
+  int32_t written = (int32_t)fwrite(buffer, 1, length, file);
+  fclose(file);
+  return (written);
+}
+
+int32_t brain::sdcard::savefile(const char *name, uint8_t *buffer, int32_t length) {
+  return (writeFile(name, "wb", buffer, length));
+}
+
+int32_t brain::sdcard::appendfile(const char *name, uint8_t *buffer, int32_t length) {
+  return (writeFile(name, "ab", buffer, length));
+}
+
+int32_t brain::sdcard::size(const char *name) {
+  char path[512];
+  FILE *file = standIn::sdPath(name, path, sizeof(path)) ? fopen(path, "rb") : NULL;
+  if (!file)
+    return (0);
+  fseek(file, 0, SEEK_END);
+  int32_t bytes = (int32_t)ftell(file);
+  fclose(file);
+  return (bytes);
+}
+
+bool brain::sdcard::exists(const char *name) {
+  char path[512];
+  FILE *file = standIn::sdPath(name, path, sizeof(path)) ? fopen(path, "rb") : NULL;
+  if (file)
+    fclose(file);
+  return (file != NULL);
+}
+
+double brain::battery::voltage(voltageUnits units) {
+  return (units == voltageUnits::mV ? standIn::battery * 1000 : standIn::battery);
+}
+double brain::battery::current() { return (0); }
+uint32_t brain::battery::capacity() { return (100); }
+
+/*** controller (no buttons are ever pressed) ***/
+
+controller::controller() {}
+controller::controller(controllerType) {}
+void controller::rumble(const char *) {}
+
+void controller::lcd::print(const char *, ...) {}
+void controller::lcd::print(double) {}
+void controller::lcd::print(int) {}
+void controller::lcd::setCursor(int32_t, int32_t) {}
+void controller::lcd::clearScreen() {}
+void controller::lcd::clearLine(int32_t) {}
+void controller::lcd::clearLine() {}
+
+void controller::button::pressed(void (*)(void)) {}
+void controller::button::released(void (*)(void)) {}
+bool controller::button::pressing() { return false; }
+
+void competition::autonomous(void (*)(void)) {}
+void competition::drivercontrol(void (*)(void)) {}
+bool competition::isEnabled() { return false; }
+
+} // namespace vex
@@ -4,56 +4,73 @@
 //This class let's us have a chassis "builder"
 //we can set specific attributes like gearRatio, kinematical limits 
 // See example in src/config/chassis_config.cpp
-class FourMotorDrive::FourMotorDriveBuilder {
+template <int N>
+class DifferentialDrive<N>::Builder {
+
+  friend class DifferentialDrive<N>; // builds itself straight from our fields (see DifferentialDrive(builder))
 
   private:
-  std::array<int32_t, 2> m_leftGroup;
-  std::array<int32_t, 2> m_rightGroup;
-  gearSetting gearbox;
-  double gearRatio;
-  Dimensions b_chassisDimensions;
+  std::array<motor, N> *m_leftGroup; // the motors are owned by the device registry
+  std::array<motor, N> *m_rightGroup;
+  ChassisConstants m_constants;
   Limits b_chassisLinearLimits;
   Limits b_chassisAngularLimits;
-  std::initializer_list<PDcontroller> m_PDGains;
+  std::array<PDcontroller, 3> m_PDGains; // copied out of the initializer list, which doesn't outlive the call
+  feedforwardGains m_feedforward;
+  encoderReduction m_reduction = MEAN_REDUCTION;
 
 
   public:
-    FourMotorDriveBuilder& withMotors(const std::array<int32_t, 2> &leftGroup,const std::array<int32_t, 2> &rightGroup) {
-      m_leftGroup = leftGroup;
-      m_rightGroup = rightGroup;
+    Builder& withMotors(std::array<motor, N> &leftGroup, std::array<motor, N> &rightGroup) {
+      m_leftGroup = &leftGroup;
+      m_rightGroup = &rightGroup;
       return *this;
     }
-    FourMotorDriveBuilder& withGearSetting(const gearSetting gears) {
-      gearbox = gears;
+    Builder& withGearRatio(const double ratio) {
+      m_constants = m_constants.withGearRatio(ratio);
       return *this;
     }
-    FourMotorDriveBuilder& withGearRatio(const double ratio) {
-      gearRatio = ratio;
+    Builder& withDimensions(const Dimensions chassisDimensions) {
+      m_constants = m_constants.withDimensions(math3142a::Length(chassisDimensions.m_trackWidth),
+                                               math3142a::Length(chassisDimensions.m_wheelRadius), chassisDimensions.ticksToDegrees);
       return *this;
     }
-    FourMotorDriveBuilder& withDimensions(const Dimensions chassisDimensions) {
-      b_chassisDimensions = chassisDimensions;
+    ///gear ratio and dimensions in one go, from constants the compiler already worked out
+    Builder& withConstants(const ChassisConstants &constants) {
+      m_constants = constants;
       return *this;
     }
-    FourMotorDriveBuilder& withLinearLimits(Limits linearChassisLimits) {
+    Builder& withLinearLimits(Limits linearChassisLimits) {
       b_chassisLinearLimits = linearChassisLimits;
       return *this;
     }
-    FourMotorDriveBuilder& withAngularLimits(Limits angularChassisLimits) {
+    Builder& withAngularLimits(Limits angularChassisLimits) {
       b_chassisAngularLimits = angularChassisLimits;
       return *this;
     }
-    FourMotorDriveBuilder& withPDGains(std::initializer_list<PDcontroller> PDGains) {
-      PDGains = PDGains;
+    Builder& withPDGains(std::initializer_list<PDcontroller> PDGains) {
+      int count = 0;
+      for (auto &element : PDGains) {
+        if (count < 3)
+          m_PDGains[count++] = element;
+      }
+      return *this;
+    }
+
+    Builder& withFeedforward(const feedforwardGains feedforward) {
+      m_feedforward = feedforward;
       return *this;
     }
 
-    ///builder that returns a new FourMotorDrive
-    FourMotorDrive buildChassis() const
-    {
-      return FourMotorDrive{m_leftGroup, m_rightGroup, gearbox, gearRatio,b_chassisDimensions,b_chassisLinearLimits,b_chassisAngularLimits,m_PDGains};
+    ///how the encoders on each side are combined (see motorGroup.h), the mean if this is never called
+    Builder& withEncoderReduction(const encoderReduction reduction) {
+      m_reduction = reduction;
+      return *this;
     }
 
+    // no buildChassis(): a drive can't be copied (its gain mailboxes hold a lock), so construct
+    // DifferentialDrive(builder) in place (see Config_src/chassis-config.cpp)
+
 };
 
 
@@ -0,0 +1,69 @@
+#pragma once
+#include <cmath>
+#include "Util/units.h"
+
+/**
+ * Class ChassisConstants. The fixed geometry of a chassis plus every conversion factor derived from it
+ *
+ * Everything is constexpr, so a chassis described with a constexpr ChassisConstants
+ * (see Config/chassis-config.h) has its conversion factors worked out by the compiler.
+ * The control loops then only multiply by them instead of redoing the division every tick
+ *
+ * Built like the chassis builder, each with* returns a new set of constants:
+ *
+ *   constexpr ChassisConstants constants = ChassisConstants().withGearRatio(1.6666667).withDimensions(12.0_in, 3.25_in, 26);
+ */
+
+class ChassisConstants {
+public:
+  constexpr ChassisConstants() : ChassisConstants(0, 1, 0, 1) {}
+
+  /**
+   * @param trackWidth width of the drive (m)
+   * @param wheelRadius wheel size used for the encoder conversion (m)
+   * @param ticksToDegrees motor encoder degrees per degree the robot turns (tuned, see FourMotorDrive#turnToDegreeFeedforward)
+   * @param gearRatio gear ratio
+   */
+  constexpr ChassisConstants(double trackWidth, double wheelRadius, double ticksToDegrees, double gearRatio)
+      : m_trackWidth(trackWidth), m_wheelRadius(wheelRadius), m_ticksToDegrees(ticksToDegrees), m_gearRatio(gearRatio),
+        m_ticksPerMeter(360 / (wheelRadius * M_PI) * gearRatio),
+        m_metersPerTick(wheelRadius * M_PI / 360 * gearRatio),
+        m_trackWidthTicks(trackWidth * (360 / (wheelRadius * M_PI) * gearRatio)) {}
+
+  /// same constants with a different gear ratio
+  constexpr ChassisConstants withGearRatio(double gearRatio) const {
+    return ChassisConstants(m_trackWidth, m_wheelRadius, m_ticksToDegrees, gearRatio);
+  }
+
+  /// same constants with a different track width, wheel size and turn scaling (like Dimensions)
+  constexpr ChassisConstants withDimensions(math3142a::Length trackWidth, math3142a::Length wheelRadius,
+                                            double ticksToDegrees) const {
+    return ChassisConstants(trackWidth.value(), wheelRadius.value(), ticksToDegrees, m_gearRatio);
+  }
+
+  constexpr double trackWidth() const { return (m_trackWidth); }
+  constexpr double wheelRadius() const { return (m_wheelRadius); }
+  constexpr double ticksToDegrees() const { return (m_ticksToDegrees); }
+  constexpr double gearRatio() const { return (m_gearRatio); }
+
+  /// motor encoder degrees per meter driven (see FourMotorDrive#convertMetersToTicks)
+  constexpr double ticksPerMeter() const { return (m_ticksPerMeter); }
+
+  /// meters per motor encoder degree (see FourMotorDrive#convertTicksToMeters)
+  /// Both factors have always multiplied by the gear ratio, so this is not 1 / ticksPerMeter.
+  /// Every tuned gain depends on that, so it stays
+  constexpr double metersPerTick() const { return (m_metersPerTick); }
+
+  /// track width in motor encoder degrees
+  constexpr double trackWidthTicks() const { return (m_trackWidthTicks); }
+
+private:
+  double m_trackWidth;
+  double m_wheelRadius;
+  double m_ticksToDegrees;
+  double m_gearRatio;
+
+  double m_ticksPerMeter;
+  double m_metersPerTick;
+  double m_trackWidthTicks;
+};
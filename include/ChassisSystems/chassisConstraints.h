@@ -1,4 +1,5 @@
 #pragma once
+#include "Util/units.h"
 
 /**
  * struct Dimensions
@@ -8,16 +9,16 @@
 
 struct Dimensions
 {
-  long double m_trackWidth;
-  long double m_wheelRadius;
-  long double ticksToDegrees;
+  double m_trackWidth;  // m
+  double m_wheelRadius; // m
+  double ticksToDegrees;
 
   /**
    * Initializes dimensions for 4 motor drive
    * @param trackWidth width of drive
    * @param wheelRadius radius of  wheels on drive
    */
-  Dimensions( const long double trackWidth,  const long double wheelRadius, const long double ticksToDegrees);
+  Dimensions( const math3142a::Length trackWidth,  const math3142a::Length wheelRadius, const double ticksToDegrees);
   Dimensions() {}
 };
 
@@ -30,15 +31,25 @@ struct Dimensions
 class Limits
 {
   public:
-    long double m_maxVelocity;
-    long double m_maxAcceleration;
+    double m_maxVelocity;     // m/sec or rad/sec
+    double m_maxAcceleration; // m/sec^2 or rad/sec^2
 
     /**
     * Initializes kinematic limits for 4 motor drive
     * @param maxVelocity of drive (m/sec)
     * @param maxAcceleration of drive (m/sec^2)
     */
-    Limits(  long double maxVelocity,   long double maxAcceleration);
+    Limits(  math3142a::Velocity maxVelocity,   math3142a::Acceleration maxAcceleration);
+
+    /**
+    * Initializes turning limits for 4 motor drive
+    * @param maxVelocity of drive (rad/sec)
+    * @param maxAcceleration of drive (rad/sec^2)
+    */
+    Limits(  math3142a::AngularVelocity maxVelocity,   math3142a::AngularAcceleration maxAcceleration);
+
+    /// limits read back as plain numbers (see Config/configStore.h), already in the right units
+    Limits(  double maxVelocity,   double maxAcceleration);
     Limits() {}
 
 };
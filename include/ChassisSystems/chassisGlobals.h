@@ -1,8 +1,14 @@
 #pragma once
 #include "ChassisSystems/posPID.h"
+#include "ChassisSystems/motionprofile.h"
+#include "Util/mailbox.h"
 #include "Util/premacros.h"
+#include "Util/angle.h"
+#include "Util/units.h"
 #include "Util/vex.h"
 #include "chassisConstraints.h"
+#include "chassisConstants.h"
+#include "motorGroup.h"
 #include <vector>
 
 using namespace vex;
@@ -15,19 +21,15 @@ applications such as PID and Motion Profiling
 
 */
 
-/// FourMotorDrive class that we use for our builder, and chassis functions
-class FourMotorDrive {
+/**
+ * DifferentialDrive class that we use for our builder, and chassis functions
+ * N is the number of motors on each side (FourMotorDrive is DifferentialDrive<2>)
+ * Member functions live in src/ChassisSystems_src and are explicitly instantiated there for every N we use
+ */
+template <int N>
+class DifferentialDrive {
 private:
 
-  /**
-   * Omtimizes the output of a PD controller for turning
-   * if the difference between the output and targer is less than 180, -1*angleOutput otherwise
-   * @param targetAngle the target angle we have to reach
-   * @param angleOutput that needs to be optimized
-   */
-
-  inline void adjustOutput(double targetAngle, double &angleOutput);
-
   /**
    * Changes the voltage of our feedforward/feedback controller depending if we are going backwards
    * Will multiply by -1 if we are going backwards
@@ -37,8 +39,10 @@ private:
    */
 
   inline void checkBackwards(double &lVoltage, double &rVoltage, bool backwards);
+
+  math3142a::Mailbox<feedforwardGains> m_pendingFeedforward; //feedforward gains from requestFeedforward waiting for the next tick
 public:
-  Dimensions m_chassisDimensions;
+  ChassisConstants m_constants; // geometry and conversion factors, worked out once (see chassisConstants.h)
   Limits m_chassisLinearLimits;
   Limits m_chassisAngularLimits;
 
@@ -46,48 +50,63 @@ public:
   posPID anglePID;
   posPID turnPID;
 
-  double gearRatio;
-  gearSetting setting;
+  feedforwardGains m_feedforwardGains;
 
   enum backOrFront {
-    FRONT,
-    BACK,
+    FRONT = 0,
+    BACK = N - 1,
   };
 
-  class FourMotorDriveBuilder;
+  class Builder;
+  typedef Builder FourMotorDriveBuilder; // the name the 4 motor builder always had
+
+  // owned by the device registry (see Config/deviceRegistry.h), front to back
+  std::array<motor, N> &m_leftMotors;
+  std::array<motor, N> &m_rightMotors;
+
+  // the front and back motor of each side (odometry reads the front ones)
+  motor &leftFront;
+  motor &rightFront;
+  motor &leftBack;
+  motor &rightBack;
 
-  motor leftFront;
-  motor rightFront;
-  motor leftBack;
-  motor rightBack;
+  encoderReduction m_reduction; // how each side's encoders are combined (see motorGroup.h)
 
   /**
-   * Initializes 4 motor drive
-   * @param leftGroup vector of left motor ports (front,back)
-   * @param rightGroup vector of right motor ports (front,back)
-   * @param setting gear cartridge type (36:1.18:1,6:1)
-   * @param gearRatio gear ratio
-   * @param chassisDimensions chassis dimensions (trackWidth and wheel size)
+   * Initializes the drive
+   * @param leftGroup left motors (front to back), the chassis keeps references to them
+   * @param rightGroup right motors (front to back), the chassis keeps references to them
+   * @param constants chassis geometry (gear ratio, trackWidth and wheel size)
    * @param chassisLimits chassis limits (max velocity and acceleration)
    * @param PDGains Controller chassis parameters
+   * @param feedforward feedforward gains for driveStraightFeedforward
+   * @param reduction how each side's encoders are combined
    */
 
-  FourMotorDrive(const std::array<int32_t, 2> &leftGroup,
-                 const std::array<int32_t, 2> &rightGroup,
-                 const gearSetting setting, const double gearRatio,
-                 const Dimensions chassisDimensions, const Limits linLimits,
+  DifferentialDrive(std::array<motor, N> &leftGroup,
+                 std::array<motor, N> &rightGroup,
+                 const ChassisConstants &constants,
+                 const Limits linLimits,
                  const Limits angLimits,
-                 const std::initializer_list<PDcontroller> PDGains);
+                 const std::array<PDcontroller, 3> &PDGains,
+                 const feedforwardGains feedforward,
+                 const encoderReduction reduction = MEAN_REDUCTION);
+
+  /**
+   * Initializes the drive straight from a builder, so a global chassis can be built in place
+   * (see Config_src/chassis-config.cpp)
+   * @param builder builder with every chassis attribute set
+   */
+
+  explicit DifferentialDrive(const Builder &builder);
 
   /**
    * Handles the reversal of motors.
-   * @param LeftReverseVals boolean array of leftFront and leftBack desired
-   * reversal states
-   * @param RightReverseVals boolean array of rightFront and rightBack desired
-   * reversal states
+   * @param LeftReverseVals desired reversal states of the left motors (front to back)
+   * @param RightReverseVals desired reversal states of the right motors (front to back)
    */
 
-  void setReverseSettings(const std::array<bool, 2> &LeftReverseVals, const std::array<bool, 2> &RightReverseVals);
+  void setReverseSettings(const std::array<bool, N> &LeftReverseVals, const std::array<bool, N> &RightReverseVals);
 
   /**
    * Does a point turn based off of inertial value
@@ -96,9 +115,9 @@ public:
    * @see posPID#calculatePower
    */
 
-  void turnToDegreeGyro(const double angle);
+  void turnToDegreeGyro(const math3142a::Angle angle);
 
-  void turnToDegreeFeedforward(const double angle);
+  void turnToDegreeFeedforward(const math3142a::Angle angle);
 
   /**
    * Drives the robot straight using feedforward control
@@ -125,7 +144,7 @@ public:
    * @see posPID#calculatePower
    */
 
-  void driveStraightFeedforward(const double distance, bool backwards = false);
+  void driveStraightFeedforward(const math3142a::Length distance, bool backwards = false);
 
   /**
     Frame and construction style.
@@ -139,7 +158,21 @@ public:
 
   void moveToPoint(const double x, const double y, bool backwards = false);
 
-  void driveArcFeedforward(const double radius, const double exitAngle);
+  void driveArcFeedforward(const math3142a::Length radius, const math3142a::Angle exitAngle);
+
+  /**
+   * Asks for new feedforward gains from another task (e.g. the selector PID tuner)
+   * They are picked up at the next tick of driveStraightFeedforward
+   * @param gains new feedforward gains
+   */
+  void requestFeedforward(const feedforwardGains &gains);
+
+  /**
+   * gets the feedforward gains asked for last (or the ones it runs with if nothing was asked for)
+   * Safe from any task, it leaves the request for driveStraightFeedforward
+   * @return requested gains
+   */
+  feedforwardGains getRequestedFeedforward() const;
 
   /// resets the chassis encoders to 0
   void resetPosition();
@@ -165,21 +198,21 @@ public:
   void setVelDrive(const double leftVelocity, const double rightVelocity, const velocityUnits units);
 
   /**
-   * gets the encoder values of the all motors (average)
+   * gets the encoder values of the all motors (average of the two sides)
    * @return the total average econder values
    */
 
   double getAverageEncoderValueMotors();
 
   /**
-   * gets the encoder values of the right encoders (average)
+   * gets the encoder values of the right encoders (reduced with m_reduction)
    * @return the total average  of right econder values
    */
 
   double getRightEncoderValueMotors();
 
   /**
-   * gets the encoder values of the left encoders (average)
+   * gets the encoder values of the left encoders (reduced with m_reduction)
    * @return the total average  of left encoder values
    */
 
@@ -187,10 +220,10 @@ public:
 
   /// converts an imput meters to encoder ticks based off of gear ratio, gearbox
   /// etc.
-  double convertMetersToTicks( const double num_meters) const;
+  double convertMetersToTicks( const double num_meters) const {return(num_meters * m_constants.ticksPerMeter());}
 
   /// converts an imput ticks meters based off of gear ratio, gearbox etc.
-  double convertTicksToMeters( const double num_ticks) const;
+  double convertTicksToMeters( const double num_ticks) const {return(num_ticks * m_constants.metersPerTick());}
 
   double getMaxLinearVelocity() const {return(m_chassisLinearLimits.m_maxVelocity);}
 
@@ -201,6 +234,9 @@ public:
   double getMaxAngularAcceleration() const {return(m_chassisAngularLimits.m_maxAcceleration);}
 };
 
+/// the drive we have always had, 2 motors a side. Existing code keeps using this name
+typedef DifferentialDrive<2> FourMotorDrive;
+
 
 
 
@@ -224,8 +260,6 @@ struct Tracking {
 
   enum trackType { THREE_ENCODER_MODEL, IME_ENCODER_MODEL };
 
-  enum triportIndex { A, B, C, D, E, F, G, H };
-  brain brained;
   double trackWidth;
   double wheelRadius;
   double backDistance;
@@ -233,36 +267,25 @@ struct Tracking {
   double maxVelocity;
   double maxAcceleration;
   WheelDistances m_odomImpl;
-  encoder rightEncoder;
-  encoder leftEncoder;
-  encoder backEncoder;
-  inertial inert;
 
-  /**
-   * Constructor for 3 encoder model
-   * @param trackWidth of encoder model
-   * @param distance from tracking center to the back encoder
-   * @param encoder wheel radius
-   * @param encoder ticks per revolution
-   * @param list of triports (in order of left, right, back)
-   * @param gyroport (if any)
-   */
-
-  Tracking(WheelDistances wheels, double wheelRadius, std::vector<triportIndex> enocoderPorts, int GyroPort = NULL, double ticksPerRev = 360.0);
+  // owned by the device registry (see Config/deviceRegistry.h). There is no left wheel, its port
+  // has the intake line sensor
+  encoder &rightEncoder;
+  encoder &backEncoder;
+  inertial &inert;
 
   /**
-   * Constructor for 2 IME  and one backEncoder model
-   * @param trackWidth of encoder model
-   * @param distance from tracking center to the back encoder
-   * @param encoder wheel radius
-   * @param encoder ticks per revolution
-   * @param list of triports (in order of left, right, back)
-   * @param gyroport (if any)
+   * Constructor for the right and back encoders
+   * @param wheels distances from the tracking center to each tracking wheel
+   * @param wheelRadius encoder wheel radius
+   * @param rightEncoder right tracking wheel encoder
+   * @param backEncoder back tracking wheel encoder
+   * @param inert inertial sensor
+   * @param ticksPerRev encoder ticks per revolution
    */
 
-  Tracking(FourMotorDrive drive, triportIndex backPort, int GyroPort = NULL);
-
-  Tracking(FourMotorDrive drive, int GyroPort = NULL);
+  Tracking(WheelDistances wheels, double wheelRadius, encoder &rightEncoder, encoder &backEncoder,
+           inertial &inert, double ticksPerRev = 360.0);
   /**
    * returns "fixed" inertial value
    * @return intertial value
@@ -270,5 +293,13 @@ struct Tracking {
 
   double getInertialHeading();
 
-  double getAverageEncoderValueEncoders();
+  /**
+   * returns the inertial heading as an Angle, continuous (it keeps counting past +-180)
+   * @return heading, counter clockwise = positive
+   */
+
+  math3142a::Angle getHeading();
 };
+
+/// adds the chassis metrics (see Telemetry/metrics.h), once, from initChassisDevices
+void addChassisMetrics();
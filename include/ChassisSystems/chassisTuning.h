@@ -0,0 +1,40 @@
+#pragma once
+#include "ChassisSystems/chassisGlobals.h"
+
+/**
+ * struct chassisGains
+ * Every gain of the chassis that the selector PID tuner can change
+ */
+
+struct chassisGains {
+  PDcontroller distance;
+  PDcontroller angle;
+  PDcontroller turn;
+  feedforwardGains feedforward;
+};
+
+/**
+ * gets the gains a chassis was asked to run with last (see requestChassisGains), which the
+ * control loops pick up at their next tick. Safe to call from any task, it doesn't apply them
+ * @param drive chassis to read
+ * @return gains of the chassis
+ */
+
+chassisGains getChassisGains(const FourMotorDrive &drive);
+
+/**
+ * sends new gains to a chassis. Safe to call from any task, the control loops
+ * pick them up between two ticks (see posPID#requestPD)
+ * @param drive chassis to change
+ * @param gains new gains
+ */
+
+void requestChassisGains(FourMotorDrive &drive, const chassisGains &gains);
+
+/**
+ * saves gains to the SD card so they survive a power cycle (see Config/configStore.h)
+ * @param gains gains to save
+ * @return true if they were written
+ */
+
+bool saveChassisGains(const chassisGains &gains);
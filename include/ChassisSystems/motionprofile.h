@@ -1,5 +1,4 @@
 #pragma once
-#include <string>
 
 class TrapezoidalMotionProfile {
 private:
@@ -51,10 +50,10 @@ public:
   /**
    * gives profile status at a given t
    * @param t time for status to be given
-   * @return status at the given time (accelerating, coasting, decelerating)
+   * @return status at the given time (accelerating, coasting, decelerating). A string literal, so asking every tick costs nothing
    */
 
-  std::string getMpStatus(const double t) const;
+  const char *getMpStatus(const double t) const;
 
   double getMpTotalTime() const {return(m_totalTime);}
 
@@ -74,4 +73,16 @@ struct Feedfoward {
    * @param kA acceleration constant
    */
   Feedfoward(double kV, double kA);
-};
\ No newline at end of file
+};
+
+/**
+ * struct feedforwardGains
+ * The tunable part of our feedforward controller (see FourMotorDrive#driveStraightFeedforward)
+ * kV is not stored directly because it depends on the max velocity of each profile
+ */
+
+struct feedforwardGains {
+  double maxVoltage; //voltage that holds the drive at max velocity (kV = maxVoltage / maxVel)
+  double leftKa;     //acceleration constant of the left side
+  double rightKa;    //acceleration constant of the right side
+};
@@ -0,0 +1,114 @@
+#pragma once
+#include "Util/vex.h"
+#include <array>
+
+using namespace vex;
+
+/*
+* Helpers for one side of a DifferentialDrive (see chassisGlobals.h)
+*
+* MotorGroup runs an operation on every motor of a std::array<motor, N>. The recursion is on a
+* template index, so the compiler writes out the N calls itself, exactly like the hand written
+* leftFront/leftBack pairs used to be, just for any N
+*/
+
+/**
+ * enum encoderReduction. How the encoders of the motors on one side are turned into one value
+ */
+
+enum encoderReduction {
+  MEAN_REDUCTION,    // plain average (what we always did)
+  MEDIAN_REDUCTION,  // middle value, ignores one bad motor out of three
+  OUTLIER_REDUCTION  // average of the motors within OUTLIER_LIMIT of the median
+};
+
+/// how far (motor degrees) a motor can be from the median before OUTLIER_REDUCTION drops it.
+/// Motors on one side are geared together, so anything this far off has slipped or been unplugged
+const double OUTLIER_LIMIT = 90;
+
+template <int N, int I = 0>
+struct MotorGroup {
+  static void spin(std::array<motor, N> &motors, double value, voltageUnits units) {
+    motors[I].spin(fwd, value, units);
+    MotorGroup<N, I + 1>::spin(motors, value, units);
+  }
+
+  static void spin(std::array<motor, N> &motors, double value, velocityUnits units) {
+    motors[I].spin(fwd, value, units);
+    MotorGroup<N, I + 1>::spin(motors, value, units);
+  }
+
+  static void setReversed(std::array<motor, N> &motors, const std::array<bool, N> &reversed) {
+    motors[I].setReversed(reversed[I]);
+    MotorGroup<N, I + 1>::setReversed(motors, reversed);
+  }
+
+  static void resetPosition(std::array<motor, N> &motors) {
+    motors[I].resetPosition();
+    MotorGroup<N, I + 1>::resetPosition(motors);
+  }
+
+  static void resetRotation(std::array<motor, N> &motors) {
+    motors[I].resetRotation();
+    MotorGroup<N, I + 1>::resetRotation(motors);
+  }
+
+  static void position(std::array<motor, N> &motors, std::array<double, N> &positions) {
+    positions[I] = motors[I].position(degrees);
+    MotorGroup<N, I + 1>::position(motors, positions);
+  }
+};
+
+// end of the recursion, nothing left to do
+template <int N>
+struct MotorGroup<N, N> {
+  static void spin(std::array<motor, N> &, double, voltageUnits) {}
+  static void spin(std::array<motor, N> &, double, velocityUnits) {}
+  static void setReversed(std::array<motor, N> &, const std::array<bool, N> &) {}
+  static void resetPosition(std::array<motor, N> &) {}
+  static void resetRotation(std::array<motor, N> &) {}
+  static void position(std::array<motor, N> &, std::array<double, N> &) {}
+};
+
+/**
+ * reduces the encoder values of one side to a single value
+ * @param positions encoder value of every motor on the side (degrees)
+ * @param reduction how to reduce them
+ * @return the side's encoder value (degrees)
+ */
+
+template <int N>
+double reduceEncoders(std::array<double, N> positions, encoderReduction reduction) {
+  double sum = 0;
+  for (int i = 0; i < N; i++)
+    sum += positions[i];
+
+  if (reduction == MEAN_REDUCTION || N < 3) // with two motors the median is the mean
+    return (sum / N);
+
+  // insertion sort, N is the motors on one side so this is a handful of compares
+  for (int i = 1; i < N; i++) {
+    double value = positions[i];
+    int j = i - 1;
+    for (; j >= 0 && positions[j] > value; j--)
+      positions[j + 1] = positions[j];
+    positions[j + 1] = value;
+  }
+
+  double median = (N % 2) ? positions[N / 2] : (positions[N / 2 - 1] + positions[N / 2]) / 2;
+
+  if (reduction == MEDIAN_REDUCTION)
+    return (median);
+
+  double kept = 0;
+  int count = 0;
+  for (int i = 0; i < N; i++) {
+    if (positions[i] - median <= OUTLIER_LIMIT && median - positions[i] <= OUTLIER_LIMIT) {
+      kept += positions[i];
+      count++;
+    }
+  }
+  if (count == 0) // even N with the two middle motors far apart, nothing to trust more than the median
+    return (median);
+  return (kept / count);
+}
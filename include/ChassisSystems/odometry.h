@@ -1,5 +1,6 @@
 #pragma once
 #include "Config/chassis-config.h"
+#include "Util/angle.h"
 
 
 /// WE WOULD LIKE TO THANK 5225A FOR SHARING AND EXPLAINING THEIR ODOM SYSTEM AND CODE
@@ -11,13 +12,13 @@ struct pointVals
 
 typedef struct _pos
 {
-	double a;
+	math3142a::Angle a; // continuous, positionArray[ODOM_THETA] gets it wrapped into [-180, 180]
 	double y;
 	double x;
 	int leftLst;
 	int rightLst;
 	int backLst;
-	double angleLst;
+	math3142a::Angle angleLst;
 } sPos; // Position of the robot
 
 void computeDistanceAndAngleToPoint(const long x, const long y, pointVals *out);
@@ -67,6 +68,14 @@ void setOdomOrigin(double x, double y, double a);
 
 
 void printPosition();
+
+/// adds the odometry metrics (see Telemetry/metrics.h), once, from initChassisDevices
+void addOdomMetrics();
+
+/**
+ * tasked function, odometry with the heading from the IMU. Waits for the motion stages, then keeps
+ * positionArray up to date. Nothing starts it: L is in meters and the offsets are in inches
+ */
 int trackPositionGyro();
 
 extern float thetaDegrees;
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
-
+#include "Util/filters.h"
+#include "Util/mailbox.h"
 
 struct PDcontroller
 {
@@ -20,11 +21,14 @@ private:
   double m_prevError;
   double m_proportional;
   double m_derivative;
+  math3142a::ExponentialAverage<double> m_derivativeFilter; //smooths the difference of errors, alpha 1 (off) unless set
 
   static const int m_upperBound = 11; //max voltage
   static const int m_lowerBound = -11; //min voltage
   double m_power;
 
+  math3142a::Mailbox<PDcontroller> m_pendingGains; //gains from requestPD waiting for the next tick
+
 public:
 
 
@@ -39,6 +43,38 @@ public:
    * @param kD desired kD value
    */
   void setPD(double kP, double kD);
+
+  /**
+   * Asks for new PD values from another task (e.g. the selector PID tuner)
+   * They are picked up at the start of the next calculatePower, so a control tick
+   * never runs with half an update
+   * @param kP desired kP value
+   * @param kD desired kD value
+   */
+  void requestPD(double kP, double kD);
+
+  /**
+   * Applies PD values from requestPD. calculatePower already does this, only the task
+   * that runs the controller may call it (see Mailbox#take)
+   */
+  void applyPendingGains();
+
+  /**
+   * gets the PD values asked for last (by requestPD, or the ones it runs with if nothing was
+   * asked for). Safe from any task, it leaves the request for the control loop
+   * @return requested gains
+   */
+  PDcontroller getRequestedPD() const;
+
+  /**
+   * smooths the derivative term (an exponential average of the difference of errors),
+   * for sensors noisy enough that kD mostly amplifies the noise
+   * @param alpha weight of the newest difference, 1 (the default) is no smoothing
+   */
+  void setDerivativeSmoothing(double alpha) { m_derivativeFilter.setAlpha(alpha); }
+
+  /// clears the error history so the derivative doesn't kick at the start of a new motion
+  void reset();
   
   
   /**
@@ -0,0 +1,27 @@
+#pragma once
+#include <stdint.h>
+
+/*
+* Boot profiler
+*
+* Timestamps every construction/init step from power on until we are ready for autonomous.
+* Steps are recorded from any task and printed together with the init stage report
+* (see Config/initStages.h)
+*/
+
+namespace boot3142a {
+
+/// most steps we keep, later ones are dropped
+const int MAX_BOOT_STEPS = 24;
+
+/**
+ * records that a boot step just finished
+ * @param name name of the step (must be a string literal, only the pointer is kept)
+ */
+
+void profileStep(const char *name);
+
+/// prints every step with the time since power on and since the step before it (us)
+void printBootProfile();
+
+} // namespace boot3142a
@@ -1,18 +1,41 @@
+#pragma once
 #include "ChassisSystems/chassisGlobals.h"
+#include "Util/literals.h"
 
 using namespace vex;
 
-extern Tracking poseTracker;
+/// geometry of our chassis, every conversion factor is worked out at compile time (see ChassisSystems/chassisConstants.h)
+constexpr ChassisConstants CHASSIS_CONSTANTS = ChassisConstants()
+                                                .withGearRatio(1.6666667)
+                                                .withDimensions(12.0_in, 3.25_in, 26); //trackWidth, wheel size, ticks per degree of turn
+
+static_assert(CHASSIS_CONSTANTS.ticksPerMeter() > 0, "chassis constants have to be usable at compile time");
+
+extern Tracking &poseTracker;
 extern FourMotorDrive testchassis;
-extern FourMotorDrive chassis;
+extern FourMotorDrive &chassis;
 
-// VEXcode devices
-extern encoder testEncoder;
-extern line intakeDetect;
+// VEXcode devices (these point into the device registry)
+extern encoder &testEncoder;
+extern line &intakeDetect;
 extern brain Brain;
 
-
 /**
- * Used to initialize code/tasks/devices in the chassis
+ * Builds the chassis and pose tracker on top of the device registry.
+ * Call it right after initDevices(), nothing above can be used before it
  */
-void initChassis(void);
\ No newline at end of file
+void initChassisDevices();
+
+
+/*
+ * Chassis init stages, each runs in its own task (see Config/initStages.h)
+ */
+
+/// loads the robot config from the SD card and applies it to the chassis
+int loadConfigStage();
+
+/// sets motor reversal, resets the chassis encoders and the odometry origin
+int resetMotorsStage();
+
+/// calibrates the inertial sensor (about 2 seconds)
+int calibrateImuStage();
@@ -0,0 +1,90 @@
+#pragma once
+#include "ChassisSystems/chassisTuning.h"
+#include <stdint.h>
+
+/*
+* Persistent robot configuration
+*
+* Every value we tune at competitions lives in one plain struct. At boot it is filled with the
+* values compiled into the code (chassis builder, line sensor enum, mechanism timeouts) and then
+* overwritten by "config.bin" on the SD card if the card has a valid copy. The file is the struct
+* itself behind a small header, so loading is a single read with no parsing.
+*/
+
+/**
+ * struct robotConfig
+ * Every tunable that can be changed without re-uploading code
+ * Only add fields to the END and bump CONFIG_VERSION when the layout changes
+ */
+
+struct robotConfig {
+  // chassis builder limits (m/s, m/s^2, rad/s, rad/s^2)
+  double maxLinearVelocity;
+  double maxLinearAcceleration;
+  double maxAngularVelocity;
+  double maxAngularAcceleration;
+
+  // PD and feedforward gains (see ChassisSystems/chassisTuning.h)
+  chassisGains gains;
+
+  // line sensor thresholds (10 bit analog, see LineSensorThresolds)
+  int32_t topLineThreshold;
+  int32_t topLineEmptyThreshold;
+  int32_t middleLineThreshold;
+  int32_t bottomLineThreshold;
+  int32_t outyLineThreshold;
+  int32_t intakeStopLineThreshold;
+
+  // mechanism timeouts (ms, see Scorer#flywheelTask)
+  int32_t scoreTimeout;
+  int32_t ejectTimeout;
+};
+
+/// version of the robotConfig layout, files with any other version are ignored
+const uint32_t CONFIG_VERSION = 1;
+
+/**
+ * gets the config the robot is running with
+ * Before loadRobotConfig this is all zeros, so read it once boot3142a::CONFIG_STAGE is ready
+ * @return the loaded config (change it and call saveRobotConfig to keep the changes)
+ */
+
+robotConfig &getRobotConfig();
+
+/**
+ * builds the config from the values compiled into the code
+ * @param drive chassis the limits and gains come from
+ * @return the compiled in config
+ */
+
+robotConfig makeDefaultConfig(FourMotorDrive &drive);
+
+/**
+ * loads the config once at boot. Falls back to the compiled in values if the SD card has no
+ * config or it is from a different version or fails its checksum
+ * @param drive chassis the compiled in limits and gains come from
+ * @return true if the config came from the SD card
+ */
+
+bool loadRobotConfig(FourMotorDrive &drive);
+
+/**
+ * pushes the loaded limits and gains to a chassis
+ * @param drive chassis to change
+ */
+
+void applyRobotConfig(FourMotorDrive &drive);
+
+/**
+ * saves the current config to the SD card
+ * @return true if the whole file was written
+ */
+
+bool saveRobotConfig();
+
+/**
+ * how long loadRobotConfig took, including the SD card read
+ * @return load time in microseconds
+ */
+
+uint32_t getConfigLoadTime();
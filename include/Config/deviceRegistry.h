@@ -0,0 +1,63 @@
+#pragma once
+#include "Util/vex.h"
+#include <array>
+
+using namespace vex;
+
+/*
+* Device registry
+*
+* Every motor and sensor on the robot is owned here, exactly once. Subsystems (the chassis,
+* the pose tracker, the mechanism tasks) only hold references into it, so nothing ever copies
+* a device and all the ports are listed in one place (src/Config_src/deviceRegistry.cpp)
+*/
+
+/**
+ * struct deviceRegistry
+ * Owns every device. Built in place by initDevices()
+ */
+
+struct deviceRegistry {
+  // drive motors, {front, back} (see FourMotorDrive)
+  std::array<motor, 2> driveLeft;
+  std::array<motor, 2> driveRight;
+
+  // mechanisms
+  motor flywheel;
+  motor intakeL;
+  motor intakeR;
+  motor indexer;
+
+  // line sensors on the 3 wire expander
+  triport expander;
+  line bottomLine;
+  line middleLine;
+  line topLine;
+  line outyLine;
+
+  // sensors on the brain's own 3 wire ports
+  line intakeDetect;
+  encoder testEncoder;
+
+  // pose tracker sensors (see Tracking), its back wheel is testEncoder above
+  encoder rightTracker;
+  inertial inert;
+
+  /// sets up every device on its port
+  deviceRegistry();
+};
+
+/// the registry (only valid after initDevices())
+extern deviceRegistry &devices;
+
+/**
+ * Builds the device registry. Has to be the first thing main does, no device can be used before it
+ */
+void initDevices();
+
+/**
+ * logs the sizeof of the registry, the chassis and the pose tracker, and of the brain object Tracking
+ * no longer carries. They are the sizes of the types this is built with, so they only mean the V5's
+ * numbers in the V5 build. The static RAM before and after is the .bss and .data of the linker map
+ */
+void printDeviceReport();
@@ -0,0 +1,80 @@
+#pragma once
+#include <stdint.h>
+
+/*
+* Boot in parallel stages
+*
+* Each init step runs in its own task as soon as the stages it depends on are ready, so the
+* ~2 second IMU calibration overlaps with everything else instead of holding up the selector.
+* Code that needs a stage (autonomous, the selector test motions) waits on just the stages it uses.
+*/
+
+namespace boot3142a {
+
+/**
+ * enum initStage. Every step between power on and ready for autonomous
+ */
+
+enum initStage {
+  CONFIG_STAGE,   // robot config loaded from the SD card and applied to the chassis
+  MOTOR_STAGE,    // chassis motors reversed/reset and odometry origin set
+  IMU_STAGE,      // inertial sensor calibrated
+  SELECTOR_STAGE, // first selector frame on the brain screen
+  STAGE_COUNT
+};
+
+typedef uint32_t stageMask;
+
+/// mask with a single stage in it
+inline stageMask stageBit(initStage stage) { return (1u << stage); }
+
+/// stages autonomous (and anything else that moves the chassis) needs
+const stageMask MOTION_STAGES = (1u << CONFIG_STAGE) | (1u << MOTOR_STAGE) | (1u << IMU_STAGE);
+
+/// every stage
+const stageMask ALL_STAGES = (1u << STAGE_COUNT) - 1;
+
+/**
+ * starts a task for every stage that has an init function. Each one waits for the stages it
+ * depends on and then runs. Returns right away
+ */
+
+void startInitStages();
+
+/**
+ * (re)runs a single stage in its own task, e.g. recalibrating the IMU from the selector
+ * Does nothing if the stage is already running
+ * @param stage stage to run
+ */
+
+void startStage(initStage stage);
+
+/**
+ * marks a stage ready. Stages with an init function are marked automatically when it returns,
+ * this is for stages that finish inside a longer running task (the selector)
+ * @param stage stage that finished
+ */
+
+void markStageDone(initStage stage);
+
+/**
+ * checks stages without waiting
+ * @param stages mask of stages (see stageBit)
+ * @return true if all of them are ready
+ */
+
+bool stagesReady(stageMask stages);
+
+/**
+ * blocks the calling task until all of the stages are ready
+ * @param stages mask of stages (see stageBit)
+ * @param timeout give up after this many ms (0 waits forever)
+ * @return true if all of them are ready, false if we timed out
+ */
+
+bool waitForStages(stageMask stages, uint32_t timeout = 0);
+
+/// prints when each stage started and finished (ms since power on)
+void printBootReport();
+
+} // namespace boot3142a
@@ -1,5 +1,6 @@
 #pragma once
 #include "Util/vex.h"
+#include "Config/deviceRegistry.h"
 
 using namespace vex;
 
@@ -9,16 +10,17 @@ extern brain Brain;
 
 extern controller BigBrother;
 
-extern motor IntakeL;
-extern motor IntakeR;
-extern motor Flywheel;
-extern motor Indexer;
+// these all point into the device registry
+extern motor &IntakeL;
+extern motor &IntakeR;
+extern motor &Flywheel;
+extern motor &Indexer;
 
-extern triport Expander21;
-extern line bottomLine;
-extern line middleLine;
-extern line topLine;
-extern line outyLine;
+extern triport &Expander21;
+extern line &bottomLine;
+extern line &middleLine;
+extern line &topLine;
+extern line &outyLine;
 
 enum LineSensorThresolds {
   TOP_LINE_THRESHOLD = 711,
@@ -4,6 +4,7 @@
 #include "Util/literals.h"
 #include "Util/premacros.h"
 #include "Util/vex.h"
+#include "Util/controllerDisplay.h"
 
 #include "ChassisSystems/motionprofile.h"
 #include "ChassisSystems/posPID.h"
@@ -15,6 +16,8 @@
 #include "NonChassisSystems/intakes.h"
 #include "NonChassisSystems/indexer.h"
 
+#include "Telemetry/recordLog.h"
+#include "Telemetry/metrics.h"
 
 
 #include "Selector/selectorAPI.h"
@@ -22,4 +25,6 @@
 
 
 #include "Config/chassis-config.h"
-#include "Config/other-config.h"
\ No newline at end of file
+#include "Config/other-config.h"
+#include "Config/initStages.h"
+#include "Config/bootProfile.h"
\ No newline at end of file
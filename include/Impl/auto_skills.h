@@ -4,6 +4,10 @@
 #include "Impl/api.h"
 void runAutoSkills();
 
+/// the skills route itself, returns after the last move (the mechanism tasks it started keep running).
+/// runAutoSkills runs it and then idles, the host simulator runs it and reports where the robot ended up
+void runAutoSkillsRoute();
+
 void testAutoSkills();
 
 extern bool atGoal;
@@ -13,6 +13,9 @@ namespace Scorer{
 /// Main flywheel task
 int flywheelTask();
 
+/// adds the flywheel metrics (see Telemetry/metrics.h), once, from initDevices
+void addFlywheelMetrics();
+
 
 /// when we set this bool to true, then the flywheel stops when the top line sensor detects a ball
 extern bool FlywheelStopWhenTopDetected;
@@ -28,5 +31,11 @@ enum FlywheelVoltages {
     FLYWHEEL_OUTY_VOLTAGE = -12 ///voltage while ejecting
 };
 
+// default time (ms) the flywheel keeps running after a ball leaves, the ones used come from the robot config
+enum FlywheelTimeouts {
+    SCORE_TIMEOUT = 1250,
+    EJECT_TIMEOUT = 1000
+};
+
 
 }
\ No newline at end of file
@@ -1,7 +1,8 @@
 #pragma once
-#include <vector>
+#include "Util/fixedVector.h"
 #include "Util/vex.h"
 #include "Util/premacros.h"
+#include "Telemetry/telemetry.h"
 
 /* ***************************************************************************************************** */
 
@@ -38,6 +39,10 @@ struct pidValues
   const char *label;
 };
 
+/// most buttons a group can hold (the biggest, the pid toggle and up/down buttons, has 7). Kept in the group itself so the
+/// screen never allocates
+const int MAX_GROUP_BUTTONS = 8;
+
 /**
  * Class buttonGroupMaler. Use to make and use a button type
  */
@@ -45,7 +50,7 @@ struct pidValues
 class ButtonGroupMaker
 {
 public:
-  std::vector<button> buttonList; //list of buttons
+  math3142a::FixedVector<button, MAX_GROUP_BUTTONS> buttonList; //list of buttons
 
   /**
    * Button group constructor
@@ -69,24 +74,133 @@ public:
   void initButtons();
 
   /**
-   * Displays all of the temporary buttons in a group
-   * @param index of button pressed
-   * @param pressed state of press on button
+   * Marks every button in the group as stale so the next render() redraws all of them
+   * Used when whatever was behind the group (the page background) has been painted over
    */
-
-  int displayButtonControls(int index, bool pressed);
+  void invalidate();
 
   /**
-   * Displays all of the permamant buttons in a group (PID, tab, and confirm)
-   * @param index of button pressed
-   * @param pressed state of press on button 
-   * @param permamant if button is permamant (always true)
+   * Redraws only the buttons whose state or label changed since they were last drawn
+   * @return number of buttons that were redrawn
    */
-  int displayButtonControls(int index, bool pressed, bool permamant);
+  int render();
 
   /**
    * switches the button state
    * @param index of button pressed
    */
   void switchStates(int index);
-};
\ No newline at end of file
+
+private:
+  math3142a::FixedVector<button, MAX_GROUP_BUTTONS> m_drawnList; //each button as it was when we last drew it
+  uint32_t m_drawnMask;            //bit i is set while button i on the screen still matches m_drawnList[i]
+
+  /**
+   * Draws a single button (fill, outline and label)
+   * @param index of button to draw
+   */
+  void drawButton(int index);
+};
+
+/**
+ * Class TextField. A line of text on the brain screen that remembers what it last printed,
+ * so it only gets repainted when the text actually changes
+ */
+
+class TextField
+{
+public:
+  /**
+   * Text field constructor
+   * @param xpos x-coordinate of the text (left edge)
+   * @param ypos y-coordinate of the text (baseline)
+   * @param width width of the area that is cleared before reprinting
+   * @param background color painted behind the text
+   */
+  TextField(int xpos, int ypos, int width, vex::color background);
+
+  /**
+   * Sets the text of the field (printf style). Nothing is drawn until render()
+   * @param format printf style format string
+   */
+  void setText(const char *format, ...);
+
+  /// Forces the next render() to repaint the field
+  void invalidate();
+
+  /**
+   * Repaints the field if its text changed since it was last drawn
+   * @return 1 if the field was redrawn, 0 otherwise
+   */
+  int render();
+
+private:
+  int m_xpos;
+  int m_ypos;
+  int m_width;
+  vex::color m_background;
+  char m_text[32];  //text we want on the screen
+  char m_drawn[32]; //text that is on the screen
+  bool m_valid;     //false when the field has to be repainted
+};
+
+/**
+ * Class GraphField. Scrolling plot of up to two telemetry signals
+ *
+ * The graph reads the newest samples straight out of the signal ring buffers.
+ * It is only redrawn when new samples came in, and never more often than
+ * REFRESH_MS, so drawing it can not eat into the control loops
+ */
+
+class GraphField
+{
+public:
+  static const uint32_t REFRESH_MS = 200; // fastest the graph is redrawn (5 Hz)
+  static const int PIXELS_PER_SAMPLE = 2;
+  static const int MAX_POINTS = telemetry3142a::RING_SIZE / 2;
+
+  /**
+   * Graph field constructor
+   * @param xpos x-coordinate of the top left corner
+   * @param ypos y-coordinate of the top left corner
+   * @param width width of the graph
+   * @param height height of the graph
+   */
+  GraphField(int xpos, int ypos, int width, int height);
+
+  /**
+   * Picks the signals to plot
+   * @param first signal drawn in cyan
+   * @param second signal drawn in yellow (SIGNAL_COUNT for none)
+   */
+  void setSignals(telemetry3142a::signalID first, telemetry3142a::signalID second);
+
+  /// Forces the next render() to redraw the graph
+  void invalidate();
+
+  /**
+   * Redraws the graph if new samples came in and REFRESH_MS has passed
+   * @param timeMs current time in msec
+   * @return 1 if the graph was redrawn, 0 otherwise
+   */
+  int render(uint32_t timeMs);
+
+private:
+  int m_xpos;
+  int m_ypos;
+  int m_width;
+  int m_height;
+  telemetry3142a::signalID m_signals[2];
+  uint32_t m_drawnWritten[2]; // sample counts of the signals when we last drew
+  uint32_t m_lastDrawTime;    // when we last drew (msec)
+  bool m_valid;               // false when the graph has to be redrawn
+
+  /**
+   * Draws one signal as a line
+   * @param samples samples to draw (oldest first)
+   * @param count number of samples
+   * @param minValue value at the bottom of the graph
+   * @param maxValue value at the top of the graph
+   */
+  void plot(const float *samples, int count, float minValue, float maxValue);
+};
@@ -1,6 +1,7 @@
 #pragma once
 #include "Impl/auto_skills.h"
 #include "selectorAPI.h"
+#include "selectorInput.h"
 
 namespace selector3142a {
 
@@ -14,6 +15,12 @@ namespace selector3142a {
 
 /* ****************************************************************************************************** */
 
+/**
+ * Builds the selector button groups. Called by makeDisplay before its first frame
+ */
+
+void initSelector();
+
 /**
  * Creates background for the selector
  */
@@ -21,75 +28,102 @@ namespace selector3142a {
 void makeBackground();
 
 /**
-   * Displays all of the  buttons in the selector
-   * @param index of button pressed
-   * @param state of press on button
-   */
+ * Draws everything on the selector that changed since the last call
+ * Callbacks only change button states, this is the only place that draws
+ * @return number of widgets that were redrawn (0 means the screen is unchanged)
+ */
 
-void displayAllButtonControls(int index, bool pressed);
+int renderSelector();
 
 /**
  * tasked function that is called in main
+ * Renders the selector into the brain's back buffer and pushes it with render() when something changed
  */
 
 int makeDisplay();
 
 /**
  * callback function for when Brain Screen is pressed
+ * Only queues the press for the display task, so it returns straight away
  */
 
 void userTouchCallbackPressed();
 
 /**
  * callback function for when brain screen is "unpressed"
+ * Only queues the release for the display task, so it returns straight away
  */
 
 void userTouchCallbackReleased();
 
 /**
- * Changes pid values of a chassis system
+ * Handles one touch event in the display task (press, release or press-and-hold repeat)
+ * @param event the touch event
+ */
+
+void handleTouchEvent(const touchEvent &event);
+
+/**
+ * Changes pid values of a chassis system. The new values go straight to the live
+ * controllers of the chassis (see requestChassisGains)
  * @param type of system to change PID settings (e.g. straight or turn)
+ * @param valueIndex which up/down toggle button was pressed
  */
 
-void changeChassisPidValues(int type);
+void changeChassisPidValues(int type, int valueIndex);
 
 /**
- * Changes pid values of a non chassis system
- * @param type of system to change PID settings (e.g. flywheel or intake)
+ * Copies the gains the chassis is running with into the chassis PID tuner
  */
 
-void changeNonChassisPidValues(int type);
+void syncChassisTuner();
+
+/**
+ * Saves the chassis PID tuner values to the SD card once they have stopped changing for a second
+ * @param timeMs current time in msec
+ */
+
+void saveChassisTuner(uint32_t timeMs);
 
 /**
  * Displays values made in the "settings menu"
+ * @return number of values that were reprinted
  */
 
-void displaySettingsValues();
+int displaySettingsValues();
 
 /**
  * Displaus PID tuner values
+ * @return number of values that were reprinted
  */
 
-void displayPIDSettings();
+int displayPIDSettings();
 
 /**
  * Displays all the PID tuner buttons
  * This had to be a standalone function (not part of ButtonGroupMaker) becuase it had different properties
- * @param index of button pressed
- * @param pressed state of press on button
+ * @return number of buttons that were redrawn
+ */
+
+int displayPIDControls();
+
+/**
+ * Lists METRIC_ROWS metrics of the registry (see Telemetry/metrics.h), refreshed every METRICS_REFRESH_MS
+ * @return number of lines that were reprinted
  */
 
-int displayPIDControls(int index, bool pressed);
+int displayMetrics();
 
 /**
  * Generates the loading screen when the confirm button is pressed
+ * @return number of lines that were reprinted
  */
 
-void makeLoadingScreen();
+int makeLoadingScreen();
 
 //externs that are used in mutiple src files
-extern ButtonGroupMaker tabButtons;
-extern ButtonGroupMaker confirmButton;
+extern ButtonGroupMaker &tabButtons;
+extern ButtonGroupMaker &confirmButton;
 extern int confirmPress;
 
 extern bool allianceBlue;
@@ -0,0 +1,127 @@
+#pragma once
+#include "Selector/selectorAPI.h"
+#include "Util/vex.h"
+#include <atomic>
+
+namespace selector3142a {
+
+/**
+ * enum touchEventType. What happened on the brain screen
+ */
+
+enum touchEventType {
+  TOUCH_PRESS,   // finger went down
+  TOUCH_RELEASE, // finger came up
+  TOUCH_REPEAT   // finger is still down (sent faster the longer it is held)
+};
+
+/**
+ * struct touchEvent. A single touch event handed to the display task
+ */
+
+struct touchEvent {
+  touchEventType type;
+  int16_t xpos;     // x-coordinate of the touch
+  int16_t ypos;     // y-coordinate of the touch
+  int repeatCount;  // how many repeats came before this one (0 for press and release)
+};
+
+/**
+ * Class TouchInput. Turns the brain screen callbacks into press, release and repeat events
+ *
+ * The callbacks only post into a small lock free queue and return straight away.
+ * The display task pulls the events out with next(), which also makes the repeat events
+ * while the screen is held down, so nothing ever sleeps in a callback
+ */
+
+class TouchInput {
+public:
+  static const int QUEUE_SIZE = 16;          // power of two so the indexes can wrap
+  static const uint32_t FIRST_REPEAT_MS = 400; // hold time before the first repeat
+  static const uint32_t MIN_REPEAT_MS = 40;    // fastest repeat rate we accelerate to
+
+  TouchInput();
+
+  /**
+   * Posts an event from a brain screen callback. Never blocks
+   * If the queue is full the event is dropped and counted
+   * @param type press or release
+   * @param xpos x-coordinate of the touch
+   * @param ypos y-coordinate of the touch
+   */
+  void post(touchEventType type, int16_t xpos, int16_t ypos);
+
+  /**
+   * Gets the next event for the display task
+   * While the screen is held this also makes repeat events. Every repeat comes
+   * sooner than the last one, down to MIN_REPEAT_MS
+   * @param event filled in with the next event
+   * @param timeMs current time in msec
+   * @return true if there was an event
+   */
+  bool next(touchEvent &event, uint32_t timeMs);
+
+  /// number of events dropped because the queue was full
+  uint32_t getDropped() const { return (m_dropped); }
+
+private:
+  touchEvent m_queue[QUEUE_SIZE];
+  std::atomic<uint32_t> m_head; // next slot the callbacks write (only touched by callbacks)
+  std::atomic<uint32_t> m_tail; // next slot the display task reads (only touched by display task)
+  uint32_t m_dropped;
+
+  bool m_held;                // true between a press and its release
+  touchEvent m_heldEvent;     // the press we are repeating
+  uint32_t m_nextRepeatTime;  // when the next repeat is due (msec)
+  uint32_t m_repeatInterval;  // gap before the repeat after that (msec)
+};
+
+/**
+ * Class HitGrid. Precomputed lookup of which button sits under each part of the screen
+ *
+ * The screen is split into CELL_SIZE x CELL_SIZE pixel cells and every cell stores the
+ * button on top of it, so finding a button is a single array read and one bounds check instead
+ * of checking every button of every group. A cell stores the last button added that touches it,
+ * so only presses on the cells at the edge of a button (where it may not reach, or another button
+ * may share the cell) check the groups one by one. The grid is rebuilt when the selector changes page
+ */
+
+class HitGrid {
+public:
+  static const int CELL_SIZE = 5;
+  static const int COLUMNS = 480 / CELL_SIZE;
+  static const int ROWS = 240 / CELL_SIZE;
+  static const uint8_t EMPTY = 0xFF;
+  static const int MAX_GROUPS = 15; // one per groupID
+
+  HitGrid();
+
+  /// removes every button from the grid
+  void clear();
+
+  /**
+   * Adds all buttons of a group to the grid. The group is read again by find(), so it has to
+   * stay alive (and keep its buttons where they are) until the grid is cleared
+   * @param group button group to add
+   * @param groupID id reported by find() for this group (0-14)
+   */
+  void addGroup(const ButtonGroupMaker &group, int groupID);
+
+  /**
+   * Finds the button under a point on the screen
+   * @param xpos x coordinate of brain press
+   * @param ypos y coordinate of brain press
+   * @param groupID set to the id of the group the button is in
+   * @param index set to the index of the button inside the group
+   * @return true if there is a button there
+   */
+  bool find(int16_t xpos, int16_t ypos, int &groupID, int &index) const;
+
+private:
+  uint8_t m_cells[ROWS][COLUMNS]; // (groupID << 4) | index, or EMPTY
+  const ButtonGroupMaker *m_groups[MAX_GROUPS]; // the groups added, in order, for the exact bounds
+  int m_groupIDs[MAX_GROUPS];
+  int m_groupCount;
+};
+
+}
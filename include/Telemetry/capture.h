@@ -0,0 +1,77 @@
+#pragma once
+#include "Telemetry/recordLog.h"
+
+/*
+* Triggered capture, like the single shot mode of an oscilloscope
+*
+* Each capture keeps the last CAPTURE_BEFORE samples of a few signals of one loop. When the loop
+* sees something worth looking at (overshoot, a jam...) it triggers the capture, which keeps
+* recording for CAPTURE_AFTER more samples and then freezes. The record drain task writes the frozen
+* capture out as records (see Telemetry/recordDefs.h) and arms it again.
+*
+* Sampling is a 24 byte copy, and a trigger is only a call when the loop's own condition is true,
+* so the loops can keep every capture armed all the time
+*/
+
+namespace telemetry3142a {
+
+const int CAPTURE_BEFORE = 64; // samples kept from before the trigger (0.64 s of a 10 msec loop)
+const int CAPTURE_AFTER = 64;  // samples recorded after the trigger
+const int CAPTURE_LENGTH = CAPTURE_BEFORE + CAPTURE_AFTER;
+
+/**
+ * enum captureID. One per loop that captures
+ */
+
+enum captureID {
+  DRIVE_CAPTURE,    // driveStraightFeedforward
+  TURN_CAPTURE,     // turnToDegreeGyro
+  FLYWHEEL_CAPTURE, // flywheelTask
+  CAPTURE_COUNT
+};
+
+/**
+ * enum captureReason. Why a capture was triggered (written in its CAPTURE_TRIGGER_RECORD)
+ */
+
+enum captureReason {
+  ERROR_TRIGGER,    // error over a limit (following error, overshoot)
+  JAM_TRIGGER,      // a mechanism is powered but not moving
+  WATCHDOG_TRIGGER, // a motion gave up
+  MANUAL_TRIGGER    // asked for by hand
+};
+
+// what the loops trigger on
+const float DRIVE_ERROR_LIMIT = 0.10f;   // profile position minus measured position (m)
+const float TURN_OVERSHOOT_LIMIT = 5.0f; // heading past the target (degrees)
+const float FLYWHEEL_JAM_RPM = 100.0f;   // slower than this while powered...
+const int FLYWHEEL_JAM_TICKS = 25;       // ...for this many ticks in a row is a jam
+
+/**
+ * Records a sample of a capture. Call once per tick from the capture's loop (one task per capture)
+ * Does nothing while the capture is frozen waiting to be written
+ */
+void captureSample(captureID capture, float a, float b = 0, float c = 0, float d = 0);
+
+/**
+ * Triggers a capture. Safe from any task, ignored unless the capture is armed
+ * (a capture being recorded or written out ignores new triggers)
+ * @param capture capture to trigger
+ * @param reason why
+ * @param value what made it trigger (the error, the rpm...), written with the capture
+ */
+void captureTrigger(captureID capture, captureReason reason, float value = 0);
+
+/// number of captures that have been written out since power on
+uint32_t getCaptureCount();
+
+/**
+ * Takes the next records of a frozen capture, re-arming it once all of it has been taken.
+ * Only called by the record drain task
+ * @param out where to put the records
+ * @param max most records wanted
+ * @return number of records taken (0 if no capture is frozen)
+ */
+int takeCaptureRecords(telemetryRecord *out, int max);
+
+} // namespace telemetry3142a
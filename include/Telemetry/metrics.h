@@ -0,0 +1,112 @@
+#pragma once
+#include <atomic>
+#include <stdint.h>
+
+/*
+* Metrics registry
+*
+* Named counters, gauges and histograms in one fixed size table. A module adds its metrics once
+* when it starts and keeps the metricID; updating one from a loop is then a single indexed atomic
+* op (a histogram first picks its bucket). A snapshot copies every value at once, and can be shown
+* on the brain (selector "Tele." tab, "Stats"), logged, diffed against an older snapshot or saved to
+* the SD card. The logged and saved lines are sorted by name, so two runs can be compared with any
+* diff tool
+*/
+
+namespace telemetry3142a {
+
+const int MAX_METRICS = 32;
+const int HISTOGRAM_BOUNDS = 8; // a histogram has up to this many bucket bounds, plus one bucket for everything above
+
+/**
+ * enum metricKind. What a metric counts
+ */
+
+enum metricKind {
+  COUNTER_METRIC,  // only goes up (events)
+  GAUGE_METRIC,    // last value set (a reading)
+  HISTOGRAM_METRIC // how many values fell in each bucket
+};
+
+/// index of a metric in the registry. When the registry is full the add* functions hand out
+/// METRICS_FULL, a spare slot that is updated like any other but never shown
+typedef int metricID;
+const metricID METRICS_FULL = MAX_METRICS;
+
+/**
+ * struct metricSlot
+ * Live values of one metric
+ */
+
+struct metricSlot {
+  std::atomic<int32_t> count;                          // counter value, or number of values a histogram saw
+  std::atomic<float> gauge;                            // gauge value
+  std::atomic<uint32_t> buckets[HISTOGRAM_BOUNDS + 1]; // histogram buckets
+};
+
+extern metricSlot metricSlots[MAX_METRICS + 1];
+
+/**
+ * adds a counter (call once, from the module's init, never from a task that can be restarted)
+ * @param name name shown and logged (must be a string literal)
+ * @return id to update the counter with
+ */
+metricID addCounter(const char *name);
+
+/// adds a gauge (see addCounter)
+metricID addGauge(const char *name);
+
+/**
+ * adds a histogram (see addCounter)
+ * @param bounds upper bound of each bucket, increasing. Must stay valid (a const array)
+ * @param boundCount number of bounds (at most HISTOGRAM_BOUNDS)
+ */
+metricID addHistogram(const char *name, const float *bounds, int boundCount);
+
+/// adds to a counter
+inline void countMetric(metricID id, int32_t amount = 1) {
+  metricSlots[id].count.fetch_add(amount, std::memory_order_relaxed);
+}
+
+/// sets a gauge
+inline void setGauge(metricID id, float value) { metricSlots[id].gauge.store(value, std::memory_order_relaxed); }
+
+/// adds a value to a histogram
+void observeMetric(metricID id, float value);
+
+/**
+ * struct metricsSnapshot
+ * Every metric's value at one time
+ */
+
+struct metricsSnapshot {
+  uint32_t time;             // ms since power on
+  int count;                 // metrics in the registry
+  float values[MAX_METRICS]; // counter value, gauge value or number of values a histogram saw
+  uint32_t buckets[MAX_METRICS][HISTOGRAM_BOUNDS + 1];
+};
+
+/// copies every metric into snapshot
+void takeSnapshot(metricsSnapshot &snapshot);
+
+/// logs one line per metric
+void printSnapshot(const metricsSnapshot &snapshot);
+
+/// logs the metrics that changed between two snapshots (counters and histograms as the difference)
+void printSnapshotDiff(const metricsSnapshot &before, const metricsSnapshot &after);
+
+/**
+ * writes the same lines printSnapshot logs to a text file on the SD card
+ * @return false if there is no card or the write failed
+ */
+bool saveSnapshot(const metricsSnapshot &snapshot, const char *fileName = "metrics.txt");
+
+/**
+ * formats one metric of a snapshot for the brain screen
+ * @param index metric (0 to snapshot.count - 1)
+ * @param text where to write it
+ * @param size size of text
+ */
+void formatMetric(const metricsSnapshot &snapshot, int index, char *text, int size);
+
+} // namespace telemetry3142a
@@ -0,0 +1,23 @@
+#pragma once
+
+/*
+* Binary telemetry records (see Telemetry/recordLog.h)
+*
+* Every record carries RECORD_FIELDS floats. This list is the only place a record is described:
+* the recordID enum and the record names are generated from it, and tools/decode_telemetry.py
+* reads it to name the CSV columns. Add new records at the end (the id is the position in the list)
+* and leave unused fields as ""
+*
+*   X(record name,             field 1,           field 2,            field 3,       field 4)
+*/
+
+#define TELEMETRY_RECORDS(X)                                                                        \
+  X(DRIVE_STRAIGHT_RECORD,   "profilePosition", "measuredPosition", "leftVoltage", "rightVoltage")  \
+  X(TURN_RECORD,             "targetAngle",     "heading",          "output",      "")              \
+  X(FLYWHEEL_RECORD,         "rpm",             "topLine",          "outyLine",    "voltage")       \
+  X(INDEXER_RECORD,          "topLine",         "middleLine",       "voltage",     "")              \
+  /* triggered captures (see Telemetry/capture.h) */                                                \
+  X(CAPTURE_TRIGGER_RECORD,  "captureRecord",   "reason",           "value",       "samplesBefore") \
+  X(DRIVE_CAPTURE_RECORD,    "profilePosition", "measuredPosition", "leftVoltage", "rightVoltage")  \
+  X(TURN_CAPTURE_RECORD,     "targetAngle",     "heading",          "output",      "")              \
+  X(FLYWHEEL_CAPTURE_RECORD, "rpm",             "voltage",          "topLine",     "outyLine")
@@ -0,0 +1,95 @@
+#pragma once
+#include "Telemetry/recordDefs.h"
+#include <atomic>
+#include <stdint.h>
+
+/*
+* Binary record log
+*
+* Control loops write small fixed size records (which record, when, four numbers) into a lock free
+* ring shared by every task. Writing is a few atomics and a 24 byte copy and never waits: when the
+* ring is full the record is dropped and counted. recordDrainTask empties the ring in the background
+* and writes whole batches at once to the SD card or the USB serial port.
+* tools/decode_telemetry.py turns the result back into CSV
+*/
+
+namespace telemetry3142a {
+
+const int RECORD_FIELDS = 4;
+
+/**
+ * enum recordID. One per line of TELEMETRY_RECORDS (see Telemetry/recordDefs.h)
+ */
+
+enum recordID {
+#define TELEMETRY_RECORD_ID(name, f1, f2, f3, f4) name,
+  TELEMETRY_RECORDS(TELEMETRY_RECORD_ID)
+#undef TELEMETRY_RECORD_ID
+  RECORD_COUNT
+};
+
+/**
+ * struct telemetryRecord
+ * What is stored (and written out) for each record, 24 bytes
+ */
+
+struct telemetryRecord {
+  uint32_t time;     // us since power on
+  uint16_t id;       // recordID
+  uint16_t sequence; // counts every record written (wraps), gaps in the output are drops
+  float fields[RECORD_FIELDS];
+};
+
+static_assert(sizeof(telemetryRecord) == 24, "the decoder expects 24 byte records");
+
+/**
+ * struct recordBatchHeader
+ * Written in front of every batch so the decoder can find the records again in telemetry.bin
+ */
+
+struct recordBatchHeader {
+  uint32_t magic;   // RECORD_BATCH_MAGIC
+  uint16_t count;   // records after the header
+  uint16_t size;    // sizeof(telemetryRecord)
+  uint32_t dropped; // records dropped since power on
+};
+
+const uint32_t RECORD_BATCH_MAGIC = 0x52323431; // "142R" read as little endian bytes
+
+const int RECORD_SLOT_SIZE = 4 + sizeof(telemetryRecord); // a record and the turn word in front of it
+const int RECORD_RING_SIZE = 512; // records waiting to be written (power of two), 512 * 28 bytes = 14 KB
+const int RECORD_BATCH_SIZE = 64; // most records written at once
+const int RECORD_DRAIN_MS = 20;   // how often the drain task empties the ring
+
+/**
+ * enum recordSink. Where the drain task writes the records
+ */
+
+enum recordSink {
+  SD_CARD_SINK, // appended to RECORD_FILE (default, records are thrown away if there is no card)
+  SERIAL_SINK,  // sent as frames on the USB serial port (see Telemetry/serialFrame.h)
+  NO_SINK       // thrown away
+};
+
+const char RECORD_FILE[] = "telemetry.bin";
+
+/**
+ * Writes a record. Safe from any task, cheap and never blocks
+ * @param id which record
+ * @return false if the ring was full and the record was dropped
+ */
+bool logRecord(recordID id, float a = 0, float b = 0, float c = 0, float d = 0);
+
+/// sets where the drain task writes the records
+void setRecordSink(recordSink sink);
+
+/// records dropped since power on because the ring was full
+uint32_t getDroppedRecords();
+
+/// name of a record (as in recordDefs.h)
+const char *getRecordName(recordID id);
+
+/// low priority task that empties the ring every RECORD_DRAIN_MS (started in pre_auto)
+int recordDrainTask();
+
+} // namespace telemetry3142a
@@ -0,0 +1,61 @@
+#pragma once
+#include <stdint.h>
+
+/*
+* Framed binary protocol for the USB serial port
+*
+* A frame on the wire is COBS(sequence, type, payload, CRC) followed by a 0 byte:
+*
+*   sequence  uint16, counts every frame sent (wraps), so the host can see lost frames
+*   type      uint8, frameType
+*   payload   up to MAX_FRAME_PAYLOAD bytes
+*   CRC       uint16, CRC-16/CCITT-FALSE of everything before it
+*
+* COBS removes every 0 byte from the frame, so 0 only ever marks the end of one. The host can start
+* listening at any point, and the plain text LOG lines on the same port show up as "frames" that
+* fail their CRC (tools/telemetry_client.py prints those as text). Lines and frames are both written
+* whole under one lock (see log3142a::writeSerial), so neither cuts into the other. Everything is
+* little endian
+*/
+
+namespace telemetry3142a {
+
+/**
+ * enum frameType. What a frame carries
+ */
+
+enum frameType {
+  RECORD_BATCH_FRAME = 1 // recordBatchHeader + records (see Telemetry/recordLog.h)
+};
+
+const int MAX_FRAME_PAYLOAD = 1600;
+// sequence + type + payload + CRC, plus one COBS byte per 254 and the 0 at the end
+const int MAX_FRAME_SIZE = (3 + MAX_FRAME_PAYLOAD + 2) + (3 + MAX_FRAME_PAYLOAD + 2) / 254 + 2;
+
+/**
+ * CRC-16/CCITT-FALSE (polynomial 0x1021, starts at 0xFFFF)
+ * @param data bytes to check
+ * @param length number of bytes
+ * @param crc CRC so far, to continue over several pieces
+ */
+uint16_t crc16(const uint8_t *data, int length, uint16_t crc = 0xFFFF);
+
+/**
+ * builds a frame
+ * @param type what the payload is
+ * @param sequence frame number
+ * @param payload bytes to send
+ * @param length number of payload bytes (at most MAX_FRAME_PAYLOAD)
+ * @param out buffer of at least MAX_FRAME_SIZE bytes
+ * @return bytes of out used (including the closing 0), 0 if the payload is too long
+ */
+int encodeFrame(frameType type, uint16_t sequence, const void *payload, int length, uint8_t *out);
+
+/**
+ * sends a frame on the USB serial port (stdout, through log3142a::writeSerial), numbering it.
+ * Only call from one task
+ * @return false if the payload is too long
+ */
+bool sendFrame(frameType type, const void *payload, int length);
+
+} // namespace telemetry3142a
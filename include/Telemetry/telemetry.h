@@ -0,0 +1,102 @@
+#pragma once
+#include "Util/vex.h"
+#include <atomic>
+
+namespace telemetry3142a {
+
+/**
+ * Class SampleRing. Lock free ring buffer of samples for one signal
+ *
+ * One control loop pushes samples and never waits. When the ring is full the
+ * oldest sample is overwritten. Any other task can copy out the newest samples
+ * without locking (used by the dashboard page of the selector)
+ */
+
+template <class T, int N>
+class SampleRing {
+public:
+  SampleRing() : m_written(0) {}
+
+  /**
+   * Adds a sample. Only one task may push into a ring
+   * @param sample value to add
+   */
+  void push(const T &sample) {
+    uint32_t written = m_written.load(std::memory_order_relaxed);
+    m_samples[written % N] = sample;
+    m_written.store(written + 1, std::memory_order_release); // publish the sample
+  }
+
+  /// total number of samples ever pushed (used to tell if anything new came in)
+  uint32_t getWritten() const { return (m_written.load(std::memory_order_acquire)); }
+
+  /**
+   * Copies out the newest samples, oldest first
+   * At most half the ring is copied, the other half is slack so the control
+   * loop can keep pushing while we copy without overwriting what we read
+   * @param out array to copy the samples into
+   * @param count number of samples wanted
+   * @return number of samples copied
+   */
+  int copyLatest(T *out, int count) const {
+    uint32_t written = getWritten();
+
+    if (count > N / 2)
+      count = N / 2;
+    if ((uint32_t)count > written)
+      count = written;
+
+    uint32_t first = written - count;
+    for (int i = 0; i < count; i++) {
+      out[i] = m_samples[(first + i) % N];
+    }
+    return (count);
+  }
+
+private:
+  T m_samples[N];
+  std::atomic<uint32_t> m_written;
+};
+
+/**
+ * enum signalID. Signals the control loops record for the dashboard
+ */
+
+enum signalID {
+  PROFILE_POSITION,  // where the motion profile wants us to be (m)
+  MEASURED_POSITION, // where the drive encoders say we are (m)
+  LEFT_VOLTAGE,      // voltage the motion loops send to the left side of the drive
+  RIGHT_VOLTAGE,     // voltage the motion loops send to the right side of the drive
+  HEADING,           // inertial heading the motion loops see (degrees, counter clockwise = positive, -180..180)
+  FLYWHEEL_RPM,      // flywheel velocity
+  SIGNAL_COUNT
+};
+
+static const int RING_SIZE = 256; // samples kept per signal (power of two)
+static const int DECIMATION = 2;  // only every second sample is kept (10 msec loops show up at 50 Hz)
+
+typedef SampleRing<float, RING_SIZE> SignalRing;
+
+/**
+ * Records a sample of a signal from a control loop. Cheap and never blocks
+ * Each signal must only be recorded from one task
+ * @param signal signal the sample belongs to
+ * @param value value of the sample
+ */
+void record(signalID signal, float value);
+
+/**
+ * gets the ring buffer of a signal (for reading)
+ * @param signal signal wanted
+ * @return ring buffer with the recent samples of the signal
+ */
+const SignalRing &getSignal(signalID signal);
+
+/**
+ * gets the name of a signal
+ * @param signal signal wanted
+ * @return short name of the signal
+ */
+const char *getSignalName(signalID signal);
+
+}
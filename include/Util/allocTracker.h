@@ -0,0 +1,75 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+* Heap allocation tracking
+*
+* Every operator new in the program is counted (src/Util_src/allocTracker.cpp replaces the global
+* operator new/delete). Motion commands open a ControlCriticalSection for as long as they drive;
+* an allocation from that task while it is open means the control loop hit the heap, which can
+* stall on the allocator lock or fragment the heap mid match. Depending on the mode we count it
+* and report it when the section closes, or stop right there so the debugger shows who did it
+*/
+
+namespace math3142a {
+
+/**
+ * enum allocationMode. What happens when a control critical section allocates
+ */
+
+enum allocationMode {
+  ALLOCATION_REPORT, // count it and log it when the section closes
+  ALLOCATION_TRAP    // stop the program on the allocation
+};
+
+/**
+ * struct allocationStats
+ * Counters since power on
+ */
+
+struct allocationStats {
+  uint32_t allocations;         // calls to operator new
+  uint32_t frees;               // calls to operator delete with a non null pointer
+  uint32_t allocatedBytes;      // total bytes asked for
+  uint32_t criticalAllocations; // allocations inside a control critical section
+  uint32_t largestCritical;     // biggest allocation inside a control critical section (bytes)
+};
+
+/// sets what happens when a control critical section allocates (ALLOCATION_REPORT by default)
+void setAllocationMode(allocationMode mode);
+
+/// gets the counters since power on
+allocationStats getAllocationStats();
+
+/// logs the counters since power on (part of the boot report, and again after the skills run)
+void printAllocationStats();
+
+/**
+ * Class ControlCriticalSection. While one is alive, the task that made it must not allocate
+ *
+ *   void FourMotorDrive::driveStraightFeedforward(...) {
+ *     math3142a::ControlCriticalSection critical("driveStraightFeedforward");
+ *     ...
+ *
+ * Sections can nest (a motion that calls another motion), only the outermost one reports.
+ * Each task is tracked on its own, so sections in different tasks can be open at the same time
+ */
+
+class ControlCriticalSection {
+public:
+  /// @param name what to call the section in the report (must be a string literal)
+  explicit ControlCriticalSection(const char *name);
+  ~ControlCriticalSection();
+
+private:
+  const char *m_name;
+  uint32_t m_startCount; // allocations of this task's slot when the section opened
+  struct sectionSlot *m_slot; // this task's slot, NULL if there was no free one
+  bool m_outermost;
+
+  ControlCriticalSection(const ControlCriticalSection &);
+  ControlCriticalSection &operator=(const ControlCriticalSection &);
+};
+
+} // namespace math3142a
@@ -0,0 +1,75 @@
+#pragma once
+#include "Util/fastMath.h"
+#include "Util/units.h"
+
+namespace math3142a {
+
+/**
+ * Class Angle. A heading or turn, stored as plain radians
+ *
+ * The angle is kept continuous (turning 2 full turns gives 4 pi, so it can be summed and
+ * differenced freely). wrapped() gives the same direction in [-pi, pi] when one is needed, and
+ * shortestTo() is the turn that gets from one heading to another the short way round, so nothing
+ * has to flip signs at +-180. It is the angle unit of Util/units.h (Angle / Time is an
+ * AngularVelocity), and like the other units it is a single double with everything inline, so it
+ * costs the same as doing the math on raw doubles
+ */
+
+class Angle : public Quantity<0, 1, 0, 0> {
+public:
+  constexpr Angle() : Quantity<0, 1, 0, 0>() {}
+
+  /// so the result of unit math in radians (AngularVelocity * Time) is an Angle again
+  constexpr Angle(Quantity<0, 1, 0, 0> radians) : Quantity<0, 1, 0, 0>(radians) {}
+
+  static constexpr Angle fromRadians(double value) { return Angle(value); }
+  static constexpr Angle fromDegrees(double value) { return Angle(value * (PI_D / 180)); }
+
+  constexpr double inRadians() const { return (value()); }
+  constexpr double inDegrees() const { return (value() * (180 / PI_D)); }
+
+  /// the same direction in [-pi, pi] (see wrapRadians, no loops)
+  Angle wrapped() const { return Angle(wrapRadians(value())); }
+
+  /**
+   * the shortest turn from this heading to target
+   * @param target heading to get to
+   * @return turn in [-pi, pi], positive is counter clockwise
+   */
+  Angle shortestTo(Angle target) const { return Angle(wrapRadians(target.value() - value())); }
+
+  // the same as Quantity's, but staying an Angle (comparisons come from Quantity and compare the
+  // continuous values, wrap first to compare directions)
+  constexpr Angle operator+(Angle other) const { return Angle(value() + other.value()); }
+  constexpr Angle operator-(Angle other) const { return Angle(value() - other.value()); }
+  constexpr Angle operator-() const { return Angle(-value()); }
+  constexpr Angle operator*(double scale) const { return Angle(value() * scale); }
+  constexpr Angle operator/(double scale) const { return Angle(value() / scale); }
+
+  /// size of the angle, whichever way it turns
+  constexpr Angle magnitude() const { return Angle(value() < 0 ? -value() : value()); }
+
+private:
+  explicit constexpr Angle(double radians) : Quantity<0, 1, 0, 0>(radians) {}
+};
+
+/**
+ * Class Rotation. An angle together with its sine and cosine, worked out once
+ * (trigSinCos, so it follows FAST_TRIG) for code that uses them more than once per tick
+ */
+
+class Rotation {
+public:
+  explicit Rotation(Angle angle) : m_angle(angle) { trigSinCos(angle.inRadians(), m_sin, m_cos); }
+
+  Angle angle() const { return (m_angle); }
+  double sin() const { return (m_sin); }
+  double cos() const { return (m_cos); }
+
+private:
+  Angle m_angle;
+  double m_sin;
+  double m_cos;
+};
+
+} // namespace math3142a
@@ -0,0 +1,29 @@
+#pragma once
+#include "Util/vex.h"
+
+namespace display3142a {
+
+static const int CONTROLLER_ROWS = 3;            // lines on the controller screen
+static const int CONTROLLER_COLUMNS = 19;        // characters that fit on a line
+static const uint32_t CONTROLLER_WRITE_MS = 50;  // the controller link takes about one screen write per 50 msec
+
+/**
+ * Posts text for one line of the controller screen. Never blocks
+ *
+ * Any task can call this as often as it wants. Only the newest text of each line
+ * is kept, and controllerDisplayTask sends it when the link has time
+ * @param row line of the controller screen (1-3)
+ * @param format printf style format string
+ */
+
+void postControllerLine(int row, const char *format, ...);
+
+/**
+ * Tasked function that owns the controller screen (start at low priority)
+ * Sends at most one changed line every CONTROLLER_WRITE_MS, lines that did not
+ * change are never resent
+ */
+
+int controllerDisplayTask();
+
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace math3142a {
+
+/**
+ * Class Deferred. Storage for a global object that is built when we say so instead of during
+ * static initialization (where the order between files is unspecified and the time is invisible)
+ *
+ * Only use it for globals: it has no constructor so the storage is just zeroed memory before main,
+ * and the object is never destroyed. Globals keep their name by being a reference to object()
+ *
+ *   static Deferred<motor> flywheelStorage;
+ *   motor &Flywheel = flywheelStorage.object();
+ *   ...
+ *   flywheelStorage.construct(PORT19, ratio6_1, true); // in initDevices()
+ */
+
+template <class T>
+class Deferred {
+public:
+  /**
+   * Builds the object in place. Call it exactly once, before anything uses the object
+   * @param args constructor arguments of T
+   * @return the object
+   */
+  template <class... Args>
+  T &construct(Args &&... args) {
+    new (&m_storage) T(std::forward<Args>(args)...);
+    m_built = true;
+    return (object());
+  }
+
+  /// the object (only valid once construct has been called)
+  T &object() { return (*reinterpret_cast<T *>(&m_storage)); }
+
+  /// if construct has been called
+  bool isBuilt() const { return (m_built); }
+
+private:
+  typename std::aligned_storage<sizeof(T), std::alignment_of<T>::value>::type m_storage;
+  bool m_built;
+};
+
+} // namespace math3142a
@@ -0,0 +1,211 @@
+#pragma once
+#include <cmath>
+#include <stdint.h>
+
+/*
+* Fast trig and angle kernels
+*
+* Polynomial sin, cos, sincos and atan2, in float and double, plus angle wrapping without loops.
+* They trade the last few digits of libm for speed: the polynomials are short, and the argument
+* reduction is a single multiply instead of libm's exact reduction. The coefficients come from
+* tools/fit_trig.py
+*
+* Largest error against libm, checked on the host over a dense sweep of the inputs:
+*
+*   float   sin, cos, sincos   9e-7    (|angle| < 1000 rad)
+*           atan2              4e-7 rad
+*   double  sin, cos, sincos   6e-14   (|angle| < 1000 rad)
+*           atan2              2e-13 rad
+*
+* The odometry loops use the trig* functions below. They are libm unless the project is built with
+* -DFAST_TRIG=1 (DEFINES in the makefile), so switching to the kernels is one flag
+*/
+
+#ifndef FAST_TRIG
+#define FAST_TRIG 0
+#endif
+
+namespace math3142a {
+
+constexpr float PI_F = 3.14159265f;
+constexpr float HALF_PI_F = 1.57079633f;
+constexpr float TWO_PI_F = 6.28318531f;
+constexpr double PI_D = 3.14159265358979324;
+constexpr double HALF_PI_D = 1.57079632679489662;
+constexpr double TWO_PI_D = 6.28318530717958648;
+
+// odd polynomials x * (c0 + c1 x^2 + ...), fitted by tools/fit_trig.py
+// sin on [-pi/2, pi/2]
+const float SIN_POLY_F[] = {9.999966025e-01f, -1.666482836e-01f, 8.306325413e-03f, -1.836365409e-04f};
+const double SIN_POLY[] = {9.99999999999594658e-01, -1.66666666660777812e-01, 8.33333330765501090e-03,
+                           -1.98412649078826003e-04, 2.75568326040016249e-06, -2.50263629986501588e-08,
+                           1.53625555860625350e-10};
+// atan on [-tan(pi/8), tan(pi/8)]
+const float ATAN_POLY_F[] = {9.999976158e-01f, -3.331416845e-01f, 1.958097368e-01f, -1.077971235e-01f};
+const double ATAN_POLY[] = {9.99999999994174882e-01, -3.33333331675110534e-01, 1.99999862098379472e-01,
+                            -1.42851975634345901e-01, 1.11007753316959487e-01, -8.97216224692796438e-02,
+                            6.89519515157554080e-02, -3.64302343558180752e-02};
+constexpr float TAN_PI_8_F = 0.414213562f;
+constexpr double TAN_PI_8 = 0.414213562373095049;
+
+// 2 pi split in two (Cody-Waite): turns * TWO_PI_HI is exact, so wrapping a large angle only loses what TWO_PI_LO rounds
+constexpr float TWO_PI_HI_F = 6.28125f;
+constexpr float TWO_PI_LO_F = 1.93530717958647692e-3f;
+constexpr double TWO_PI_HI = 6.28125;
+constexpr double TWO_PI_LO = 1.93530717958647692e-3;
+
+/**
+ * wraps an angle into [-pi, pi] without looping: the nearest number of turns is taken off in one go
+ * (the result can be past +-pi by a rounding error, which the kernels don't mind)
+ * @param angle (radians), |angle| below about 1e8
+ * @return the same angle in [-pi, pi]
+ */
+inline float wrapRadians(float angle) {
+  float turns = (float)(int32_t)(angle * (1 / TWO_PI_F) + (angle < 0 ? -0.5f : 0.5f));
+  return ((angle - turns * TWO_PI_HI_F) - turns * TWO_PI_LO_F);
+}
+
+inline double wrapRadians(double angle) {
+  double turns = (double)(int32_t)(angle * (1 / TWO_PI_D) + (angle < 0 ? -0.5 : 0.5));
+  return ((angle - turns * TWO_PI_HI) - turns * TWO_PI_LO);
+}
+
+/**
+ * wraps an angle into [-180, 180] without looping, exactly like subtracting 360 until it fits
+ * (180 stays 180 and -180 stays -180)
+ * @param angle (degrees), |angle| below about 1e8
+ */
+inline float wrapDegrees(float angle) {
+  angle -= 360.0f * (float)(int32_t)(angle * (1 / 360.0f));
+  angle -= angle > 180.0f ? 360.0f : 0.0f;
+  angle += angle < -180.0f ? 360.0f : 0.0f;
+  return (angle);
+}
+
+inline double wrapDegrees(double angle) {
+  angle -= 360.0 * (double)(int32_t)(angle * (1 / 360.0));
+  angle -= angle > 180.0 ? 360.0 : 0.0;
+  angle += angle < -180.0 ? 360.0 : 0.0;
+  return (angle);
+}
+
+// evaluates an odd polynomial (Horner in x^2)
+template <class T, int N>
+inline T oddPolynomial(const T (&coefficients)[N], T x) {
+  T x2 = x * x;
+  T result = coefficients[N - 1];
+  for (int i = N - 2; i >= 0; i--)
+    result = result * x2 + coefficients[i];
+  return (result * x);
+}
+
+// sin of an angle already in [-pi, pi]: folded into [-pi/2, pi/2] where the polynomial is fitted
+inline float wrappedSin(float angle) {
+  angle = angle > HALF_PI_F ? PI_F - angle : angle;
+  angle = angle < -HALF_PI_F ? -PI_F - angle : angle;
+  return (oddPolynomial(SIN_POLY_F, angle));
+}
+
+inline double wrappedSin(double angle) {
+  angle = angle > HALF_PI_D ? PI_D - angle : angle;
+  angle = angle < -HALF_PI_D ? -PI_D - angle : angle;
+  return (oddPolynomial(SIN_POLY, angle));
+}
+
+// cos of an angle already in [-pi, pi], as the sin of the angle a quarter turn on
+// (shifted after the wrap, so a large angle doesn't lose the quarter turn to rounding)
+inline float wrappedCos(float angle) {
+  angle += HALF_PI_F; // in [-pi/2, 3 pi/2], back into [-pi, pi]
+  angle -= angle > PI_F ? TWO_PI_F : 0.0f;
+  return (wrappedSin(angle));
+}
+
+inline double wrappedCos(double angle) {
+  angle += HALF_PI_D;
+  angle -= angle > PI_D ? TWO_PI_D : 0.0;
+  return (wrappedSin(angle));
+}
+
+/**
+ * sine
+ * @param angle (radians)
+ */
+inline float fastSin(float angle) { return (wrappedSin(wrapRadians(angle))); }
+inline double fastSin(double angle) { return (wrappedSin(wrapRadians(angle))); }
+
+/**
+ * cosine
+ * @param angle (radians)
+ */
+inline float fastCos(float angle) { return (wrappedCos(wrapRadians(angle))); }
+inline double fastCos(double angle) { return (wrappedCos(wrapRadians(angle))); }
+
+/**
+ * sine and cosine of the same angle, sharing the wrap
+ * @param angle (radians)
+ * @param sine where to put the sine
+ * @param cosine where to put the cosine
+ */
+inline void fastSinCos(float angle, float &sine, float &cosine) {
+  angle = wrapRadians(angle);
+  sine = wrappedSin(angle);
+  cosine = wrappedCos(angle);
+}
+
+inline void fastSinCos(double angle, double &sine, double &cosine) {
+  angle = wrapRadians(angle);
+  sine = wrappedSin(angle);
+  cosine = wrappedCos(angle);
+}
+
+/**
+ * angle of the point (x, y), like std::atan2 (including atan2(0, 0) = 0)
+ * |y/x| is folded into [0, 1] by swapping, then [tan(pi/8), 1] is shifted down by pi/4
+ * (atan(t) = pi/4 + atan((t - 1) / (t + 1))), so there is only one divide
+ * @return angle (radians) in [-pi, pi]
+ */
+inline float fastAtan2(float y, float x) {
+  float ay = std::fabs(y), ax = std::fabs(x);
+  bool swapped = ay > ax;
+  float low = swapped ? ax : ay, high = swapped ? ay : ax; // low / high is in [0, 1]
+  bool shifted = low > TAN_PI_8_F * high;
+  float numerator = shifted ? low - high : low;
+  float denominator = shifted ? low + high : high;
+
+  float angle = denominator == 0 ? 0.0f : oddPolynomial(ATAN_POLY_F, numerator / denominator);
+  angle += shifted ? PI_F / 4 : 0.0f;
+  angle = swapped ? HALF_PI_F - angle : angle;
+  angle = std::signbit(x) ? PI_F - angle : angle;
+  return (std::signbit(y) ? -angle : angle);
+}
+
+inline double fastAtan2(double y, double x) {
+  double ay = std::fabs(y), ax = std::fabs(x);
+  bool swapped = ay > ax;
+  double low = swapped ? ax : ay, high = swapped ? ay : ax;
+  bool shifted = low > TAN_PI_8 * high;
+  double numerator = shifted ? low - high : low;
+  double denominator = shifted ? low + high : high;
+
+  double angle = denominator == 0 ? 0.0 : oddPolynomial(ATAN_POLY, numerator / denominator);
+  angle += shifted ? PI_D / 4 : 0.0;
+  angle = swapped ? HALF_PI_D - angle : angle;
+  angle = std::signbit(x) ? PI_D - angle : angle;
+  return (std::signbit(y) ? -angle : angle);
+}
+
+// the trig the control loops call: the kernels above with FAST_TRIG, otherwise libm
+inline double trigSin(double angle) { return (FAST_TRIG ? fastSin(angle) : std::sin(angle)); }
+inline double trigCos(double angle) { return (FAST_TRIG ? fastCos(angle) : std::cos(angle)); }
+inline double trigAtan2(double y, double x) { return (FAST_TRIG ? fastAtan2(y, x) : std::atan2(y, x)); }
+
+inline void trigSinCos(double angle, double &sine, double &cosine) {
+  if (FAST_TRIG) {
+    fastSinCos(angle, sine, cosine);
+  } else {
+    sine = std::sin(angle);
+    cosine = std::cos(angle);
+  }
+}
+
+} // namespace math3142a
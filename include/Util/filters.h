@@ -0,0 +1,266 @@
+#pragma once
+#include <cmath>
+
+/*
+* Streaming filters
+*
+* Small filters for conditioning sensor values and control terms one sample at a time: exponential
+* moving average, biquad low pass, moving median, Savitzky-Golay derivative and rate limiter.
+* Each is a plain object with its memory inside (windows are template sized arrays), so they can
+* sit in a control loop or a subsystem without touching the heap (see Util/allocTracker.h).
+*
+* They all work the same way: update(sample) takes the next sample and returns the filtered
+* value, value() is the last one returned and reset() forgets the history. The first sample after
+* a reset fills the whole history, so a filter starts out settled on it instead of ramping up
+* from 0 (the same idea as posPID::reset, no kick at the start of a motion).
+*
+* T is the sample type (float or double, see Util/matrix.h for which), N the window size where
+* there is one. The cost of a sample doesn't depend on how long the filter has been running,
+* only on N for the windowed ones, and the windows are meant to be small (3 to 9)
+*/
+
+namespace math3142a {
+
+/**
+ * Class ExponentialAverage. value += alpha * (sample - value)
+ * alpha = 1 passes samples straight through, smaller is smoother and slower
+ */
+
+template <class T>
+class ExponentialAverage {
+public:
+  /// @param alpha weight of the newest sample, in (0, 1]
+  explicit ExponentialAverage(T alpha = 1) : m_alpha(alpha) { reset(); }
+
+  void setAlpha(T alpha) { m_alpha = alpha; }
+  T getAlpha() const { return (m_alpha); }
+
+  T update(T sample) {
+    m_value = m_seeded ? m_value + m_alpha * (sample - m_value) : sample;
+    m_seeded = true;
+    return (m_value);
+  }
+
+  T value() const { return (m_value); }
+
+  void reset() {
+    m_value = 0;
+    m_seeded = false;
+  }
+
+private:
+  T m_alpha;
+  T m_value;
+  bool m_seeded;
+};
+
+/**
+ * Class LowPassBiquad. Second order low pass (the RBJ cookbook filter), run in transposed direct
+ * form II so it only keeps two values of state. The default Q is a Butterworth response (flat,
+ * no overshoot in the pass band)
+ */
+
+template <class T>
+class LowPassBiquad {
+public:
+  /**
+   * @param cutoff cutoff frequency (Hz), below half the sample rate
+   * @param sampleRate how often update is called (Hz), e.g. 100 for a 10 ms loop
+   * @param q quality factor
+   */
+  LowPassBiquad(double cutoff, double sampleRate, double q = 0.70710678118654752) {
+    // the coefficients are worked out once, in double whatever T is
+    double w0 = 2 * 3.14159265358979324 * cutoff / sampleRate;
+    double cosW0 = std::cos(w0);
+    double alpha = std::sin(w0) / (2 * q);
+    double a0 = 1 + alpha;
+    m_b0 = (T)((1 - cosW0) / 2 / a0);
+    m_b1 = (T)((1 - cosW0) / a0);
+    m_b2 = m_b0;
+    m_a1 = (T)(-2 * cosW0 / a0);
+    m_a2 = (T)((1 - alpha) / a0);
+    reset();
+  }
+
+  T update(T sample) {
+    if (!m_seeded) { // the state a constant input settles to
+      m_z2 = (m_b2 - m_a2) * sample;
+      m_z1 = (m_b1 - m_a1) * sample + m_z2;
+      m_seeded = true;
+    }
+    m_value = m_b0 * sample + m_z1;
+    m_z1 = m_b1 * sample - m_a1 * m_value + m_z2;
+    m_z2 = m_b2 * sample - m_a2 * m_value;
+    return (m_value);
+  }
+
+  T value() const { return (m_value); }
+
+  void reset() {
+    m_z1 = 0;
+    m_z2 = 0;
+    m_value = 0;
+    m_seeded = false;
+  }
+
+private:
+  T m_b0, m_b1, m_b2, m_a1, m_a2; // normalized so a0 = 1
+  T m_z1, m_z2;
+  T m_value;
+  bool m_seeded;
+};
+
+/**
+ * Class MovingMedian. Median of the last N samples, throws away single sample spikes
+ * (a line sensor glitch, a velocity reading across a stall) that an average would smear out.
+ * The window is kept sorted as it slides, so a sample is one pass over N values, not a sort
+ */
+
+template <class T, int N>
+class MovingMedian {
+  static_assert(N % 2 == 1 && N > 0, "MovingMedian needs an odd window");
+
+public:
+  MovingMedian() { reset(); }
+
+  T update(T sample) {
+    if (!m_seeded) {
+      for (int i = 0; i < N; i++)
+        m_window[i] = m_sorted[i] = sample;
+      m_seeded = true;
+      return (sample);
+    }
+
+    // the sample that falls out of the window is replaced by the new one in the sorted copy,
+    // which is then moved along until the order is right again
+    T oldest = m_window[m_next];
+    m_window[m_next] = sample;
+    m_next = m_next + 1 == N ? 0 : m_next + 1;
+
+    int i = 0;
+    while (i < N - 1 && m_sorted[i] != oldest)
+      i++;
+    while (i > 0 && m_sorted[i - 1] > sample) {
+      m_sorted[i] = m_sorted[i - 1];
+      i--;
+    }
+    while (i < N - 1 && m_sorted[i + 1] < sample) {
+      m_sorted[i] = m_sorted[i + 1];
+      i++;
+    }
+    m_sorted[i] = sample;
+    return (value());
+  }
+
+  T value() const { return (m_seeded ? m_sorted[N / 2] : 0); }
+
+  void reset() {
+    m_next = 0;
+    m_seeded = false;
+  }
+
+private:
+  T m_window[N]; // in arrival order, m_next is the oldest
+  T m_sorted[N];
+  int m_next;
+  bool m_seeded;
+};
+
+/**
+ * Class SavitzkyGolayDerivative. Slope of the least squares line through the last N samples
+ * (the first order Savitzky-Golay derivative). N = 2 is the plain difference of the last two
+ * samples, a longer window averages the noise out of the difference at the cost of (N - 1) / 2
+ * samples of lag. The weights are i - (N - 1) / 2 over the sum of their squares
+ */
+
+template <class T, int N>
+class SavitzkyGolayDerivative {
+  static_assert(N >= 2, "SavitzkyGolayDerivative needs at least 2 samples");
+
+public:
+  /// @param samplePeriod time between samples, the derivative is per unit of it (1 = per sample)
+  explicit SavitzkyGolayDerivative(T samplePeriod = 1) {
+    T sumSquares = 0;
+    for (int i = 0; i < N; i++)
+      sumSquares += (i - (N - 1) / (T)2) * (i - (N - 1) / (T)2);
+    for (int i = 0; i < N; i++)
+      m_weights[i] = (i - (N - 1) / (T)2) / (sumSquares * samplePeriod);
+    reset();
+  }
+
+  T update(T sample) {
+    if (!m_seeded) {
+      for (int i = 0; i < N; i++)
+        m_window[i] = sample;
+      m_seeded = true;
+    }
+    m_window[m_next] = sample;
+    m_next = m_next + 1 == N ? 0 : m_next + 1;
+
+    // m_next is the oldest sample again, it gets the first weight
+    T slope = 0;
+    int sampleIndex = m_next;
+    for (int i = 0; i < N; i++) {
+      slope += m_weights[i] * m_window[sampleIndex];
+      sampleIndex = sampleIndex + 1 == N ? 0 : sampleIndex + 1;
+    }
+    m_value = slope;
+    return (m_value);
+  }
+
+  T value() const { return (m_value); }
+
+  void reset() {
+    m_next = 0;
+    m_value = 0;
+    m_seeded = false;
+  }
+
+private:
+  T m_weights[N];
+  T m_window[N]; // ring buffer, m_next is the oldest
+  int m_next;
+  T m_value;
+  bool m_seeded;
+};
+
+/**
+ * Class RateLimiter. Follows the input but moves at most maxStep per sample,
+ * e.g. to keep voltage changes from spinning the wheels
+ */
+
+template <class T>
+class RateLimiter {
+public:
+  /// @param maxStep largest change per sample (same unit as the samples)
+  explicit RateLimiter(T maxStep) : m_maxStep(maxStep) { reset(); }
+
+  void setMaxStep(T maxStep) { m_maxStep = maxStep; }
+
+  T update(T sample) {
+    if (!m_seeded) {
+      m_value = sample;
+      m_seeded = true;
+      return (m_value);
+    }
+    T step = sample - m_value;
+    step = step > m_maxStep ? m_maxStep : step;
+    step = step < -m_maxStep ? -m_maxStep : step;
+    m_value += step;
+    return (m_value);
+  }
+
+  T value() const { return (m_value); }
+
+  void reset() {
+    m_value = 0;
+    m_seeded = false;
+  }
+
+private:
+  T m_maxStep;
+  T m_value;
+  bool m_seeded;
+};
+
+} // namespace math3142a
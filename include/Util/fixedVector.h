@@ -0,0 +1,51 @@
+#pragma once
+
+namespace math3142a {
+
+/**
+ * Class FixedVector. A std::vector look-alike whose storage is inside the object
+ *
+ * It never touches the heap, so it is safe to use anywhere near the control loops
+ * (see Util/allocTracker.h). The price is a capacity fixed at compile time:
+ * push_back just refuses once it is full
+ */
+
+template <class T, int N>
+class FixedVector {
+public:
+  FixedVector() : m_size(0) {}
+
+  /**
+   * adds an item to the end
+   * @param item item to add
+   * @return false (and nothing is added) if the vector is already full
+   */
+  bool push_back(const T &item) {
+    if (m_size >= N)
+      return false;
+    m_items[m_size++] = item;
+    return true;
+  }
+
+  /// removes every item (capacity stays the same)
+  void clear() { m_size = 0; }
+
+  int size() const { return (m_size); }
+  bool empty() const { return (m_size == 0); }
+  bool full() const { return (m_size == N); }
+  static int capacity() { return (N); }
+
+  T &operator[](int index) { return (m_items[index]); }
+  const T &operator[](int index) const { return (m_items[index]); }
+
+  T *begin() { return (m_items); }
+  T *end() { return (m_items + m_size); }
+  const T *begin() const { return (m_items); }
+  const T *end() const { return (m_items + m_size); }
+
+private:
+  T m_items[N];
+  int m_size;
+};
+
+} // namespace math3142a
@@ -1,24 +1,50 @@
+#pragma once
 #include "Util/vex.h"
+#include "Util/units.h"
+#include "Util/angle.h"
+#include <cmath>
+
+// constexpr so constants like the chassis dimensions can be written with units and still be
+// worked out at compile time (see Config/chassis-config.h)
+// Each literal gives a typed unit (see Util/units.h) in SI units, so 8.0_in is a Length of
+// 0.2032 m and can only go where a Length is expected. The conversion is done in long double,
+// like the literals always have, so the values are the same as before they had units
+
 /// inches operator (coverted to meters)
-long double operator"" _in(long double x);
+constexpr math3142a::Length operator"" _in(long double x) { return math3142a::Length(x * 0.0254); }
+constexpr math3142a::Length operator"" _in(unsigned long long x) { return math3142a::Length(x * 0.0254L); }
 
 /// meters operator
-long double operator"" _m(long double x);
+constexpr math3142a::Length operator"" _m(long double x) { return math3142a::Length(x); }
+constexpr math3142a::Length operator"" _m(unsigned long long x) { return math3142a::Length(x); }
 
 /// radians operator
-long double operator"" _rad(long double x);
+constexpr math3142a::Angle operator"" _rad(long double x) { return math3142a::Angle::fromRadians(x); }
 
 /// degree operator (converted to radians)
-long double operator"" _deg(long double x);
+constexpr math3142a::Angle operator"" _deg(long double x) { return math3142a::Angle::fromRadians(x * M_PI / 180); }
+constexpr math3142a::Angle operator"" _deg(unsigned long long x) { return math3142a::Angle::fromRadians(x * M_PI / 180); }
+
+/// seconds operator
+constexpr math3142a::Time operator"" _s(long double x) { return math3142a::Time(x); }
+constexpr math3142a::Time operator"" _s(unsigned long long x) { return math3142a::Time(x); }
+
+/// milliseconds operator (converted to seconds)
+constexpr math3142a::Time operator"" _ms(long double x) { return math3142a::Time(x / 1000); }
+constexpr math3142a::Time operator"" _ms(unsigned long long x) { return math3142a::Time(x / 1000.0L); }
 
 /// meters per second operator
-long double operator"" _mps(long double x);
+constexpr math3142a::Velocity operator"" _mps(long double x) { return math3142a::Velocity(x); }
 
 /// meters per second^2 operator
-long double operator"" _mps2(long double x);
+constexpr math3142a::Acceleration operator"" _mps2(long double x) { return math3142a::Acceleration(x); }
 
 /// radians per second operator
-long double operator"" _radps(long double x);
+constexpr math3142a::AngularVelocity operator"" _radps(long double x) { return math3142a::AngularVelocity(x); }
 
-/// radians per second operator
-long double operator"" _radps2(long double x);
\ No newline at end of file
+/// radians per second^2 operator
+constexpr math3142a::AngularAcceleration operator"" _radps2(long double x) { return math3142a::AngularAcceleration(x); }
+
+/// volts operator
+constexpr math3142a::Voltage operator"" _volt(long double x) { return math3142a::Voltage(x); }
+constexpr math3142a::Voltage operator"" _volt(unsigned long long x) { return math3142a::Voltage(x); }
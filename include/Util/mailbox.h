@@ -0,0 +1,93 @@
+#pragma once
+#include "Util/vex.h"
+#include <atomic>
+#include <stdint.h>
+
+namespace math3142a {
+
+/**
+ * Class Mailbox. Hands a small value (like a set of gains) from one task to another
+ *
+ * Writers can post whenever they want. The reader takes the newest value at the
+ * top of its control loop, so the value only ever changes between two control ticks
+ * and the reader never sees half of an update. The reader never blocks: if a writer is
+ * in the middle of a post, take() just tries again next tick.
+ * Any task may post (the config stage and the selector both do), posts take turns on a
+ * lock held for the copy. There is one reader: only the task that runs the loop may take(),
+ * anyone else peek()s
+ */
+
+template <class T>
+class Mailbox {
+public:
+  Mailbox() : m_sequence(0), m_taken(0) { m_posting.clear(); }
+
+  /**
+   * Posts a new value. Safe from any task, waits only for another post to finish
+   * @param value value to hand over
+   */
+  void post(const T &value) {
+    while (m_posting.test_and_set(std::memory_order_acquire))
+      this_thread::yield(); // the brain's tasks are cooperative, let the other writer finish
+
+    m_sequence = m_sequence + 1; // odd while we are writing
+    std::atomic_thread_fence(std::memory_order_release);
+    m_value = value;
+    std::atomic_thread_fence(std::memory_order_release);
+    m_sequence = m_sequence + 1; // even again, the value is complete
+
+    m_posting.clear(std::memory_order_release);
+  }
+
+  /**
+   * Takes the newest value if there is one we haven't taken yet
+   * @param value set to the posted value
+   * @return true if value was set
+   */
+  bool take(T &value) {
+    uint32_t before = m_sequence;
+    if (before == m_taken || (before & 1))
+      return false;
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    T copy = m_value;
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    if (m_sequence != before) // a new post started while we copied
+      return false;
+
+    value = copy;
+    m_taken = before;
+    return true;
+  }
+
+  /**
+   * Reads the newest value without taking it, for tasks that only show or save what was
+   * asked for last (e.g. the selector). Only the reader that acts on the value may take()
+   * @param value set to the posted value
+   * @return true if value was set, false if nothing was posted yet or a post is under way
+   */
+  bool peek(T &value) const {
+    uint32_t before = m_sequence;
+    if (before == 0 || (before & 1))
+      return false;
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    T copy = m_value;
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    if (m_sequence != before)
+      return false;
+
+    value = copy;
+    return true;
+  }
+
+private:
+  volatile uint32_t m_sequence; // number of post() halves done
+  T m_value;
+  uint32_t m_taken; // m_sequence of the value we took last
+  std::atomic_flag m_posting;  // held by the writer that is posting
+};
+
+}
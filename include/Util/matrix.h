@@ -0,0 +1,515 @@
+#pragma once
+#include <cmath>
+
+/*
+* Fixed size matrices
+*
+* Small dense matrices (2x2 up to about 6x6) for estimators, controllers and fits: products,
+* transpose, Cholesky and LU (partial pivoting) factorizations, solves, inverse and least squares.
+* The sizes are template arguments, so a size mismatch doesn't compile, and the storage is a plain
+* array inside the object, so nothing touches the heap (see Util/allocTracker.h).
+*
+* A Matrix is an aggregate, so constant ones can be written out and checked at compile time:
+*
+*   constexpr math3142a::Matrix<float, 2, 2> A = {{{4, 1}, {1, 3}}};
+*   static_assert(A(1, 0) == 1, "");
+*
+* The arithmetic itself is plain inline code (C++11 constexpr functions can't have loops).
+* Products, factorizations and solves are unrolled at compile time up to MAX_UNROLL (see Repeat).
+* The triangular loops of the factorizations run every index with an if in front (if (k < j)),
+* which is a constant once unrolled, so only the steps that do something are left.
+*
+* The brain's Cortex-A9 does float and double in hardware, but double multiplies take twice as
+* long and only float has NEON, so use float unless the numbers need double. real is float
+* unless the project is built with -DMATRIX_DOUBLE=1 (DEFINES in the makefile)
+*/
+
+#ifndef MATRIX_DOUBLE
+#define MATRIX_DOUBLE 0
+#endif
+
+namespace math3142a {
+
+#if MATRIX_DOUBLE
+typedef double real;
+#else
+typedef float real;
+#endif
+
+/**
+ * Struct Unroll. Runs body(I), body(I + 1) ... body(N - 1), as N - I copies of body
+ * The compiler doesn't unroll loops at -Os, so the products are unrolled with templates instead.
+ * always_inline matters: without it -Os keeps every step as a call and the product gets 3x
+ * slower than the plain loops
+ */
+
+template <int I, int N>
+struct Unroll {
+  template <class Body>
+  __attribute__((always_inline)) static inline void loop(Body &body) {
+    body(I);
+    Unroll<I + 1, N>::loop(body);
+  }
+};
+
+template <int N>
+struct Unroll<N, N> {
+  template <class Body>
+  __attribute__((always_inline)) static inline void loop(Body &) {}
+};
+
+// longest loop that is unrolled, past it the copies cost more code than they save time
+const int MAX_UNROLL = 8;
+
+/**
+ * Struct Repeat. body(0) ... body(N - 1), unrolled up to MAX_UNROLL and a plain loop past it
+ * (a least squares fit over hundreds of samples would otherwise inline thousands of steps)
+ */
+
+template <int N, bool UNROLLED = (N <= MAX_UNROLL)>
+struct Repeat {
+  template <class Body>
+  __attribute__((always_inline)) static inline void loop(Body &body) {
+    Unroll<0, N>::loop(body);
+  }
+};
+
+template <int N>
+struct Repeat<N, false> {
+  template <class Body>
+  static inline void loop(Body &body) {
+    for (int i = 0; i < N; i++)
+      body(i);
+  }
+};
+
+/**
+ * Struct Matrix. R rows by C columns of T, row major
+ */
+
+template <class T, int R, int C>
+struct Matrix {
+  T m_data[R][C];
+
+  static constexpr int rows() { return (R); }
+  static constexpr int cols() { return (C); }
+
+  constexpr const T &operator()(int row, int col) const { return (m_data[row][col]); }
+  T &operator()(int row, int col) { return (m_data[row][col]); }
+
+  /// element of a vector (a one column matrix)
+  constexpr const T &operator[](int row) const { return (m_data[row][0]); }
+  T &operator[](int row) { return (m_data[row][0]); }
+
+  static Matrix zeros() {
+    Matrix result;
+    for (int r = 0; r < R; r++)
+      for (int c = 0; c < C; c++)
+        result.m_data[r][c] = 0;
+    return (result);
+  }
+
+  static Matrix identity() {
+    Matrix result = zeros();
+    for (int i = 0; i < R && i < C; i++)
+      result.m_data[i][i] = 1;
+    return (result);
+  }
+
+  Matrix<T, C, R> transpose() const {
+    Matrix<T, C, R> result;
+    for (int r = 0; r < R; r++)
+      for (int c = 0; c < C; c++)
+        result.m_data[c][r] = m_data[r][c];
+    return (result);
+  }
+
+  Matrix operator+(const Matrix &other) const {
+    Matrix result;
+    for (int r = 0; r < R; r++)
+      for (int c = 0; c < C; c++)
+        result.m_data[r][c] = m_data[r][c] + other.m_data[r][c];
+    return (result);
+  }
+
+  Matrix operator-(const Matrix &other) const {
+    Matrix result;
+    for (int r = 0; r < R; r++)
+      for (int c = 0; c < C; c++)
+        result.m_data[r][c] = m_data[r][c] - other.m_data[r][c];
+    return (result);
+  }
+
+  Matrix operator*(T scale) const {
+    Matrix result;
+    for (int r = 0; r < R; r++)
+      for (int c = 0; c < C; c++)
+        result.m_data[r][c] = m_data[r][c] * scale;
+    return (result);
+  }
+
+  Matrix &operator+=(const Matrix &other) { return (*this = *this + other); }
+  Matrix &operator-=(const Matrix &other) { return (*this = *this - other); }
+};
+
+/// a column vector
+template <class T, int N>
+using Vector = Matrix<T, N, 1>;
+
+// one element of a product, the sum over k unrolled
+template <class T, int R, int K, int C>
+struct ProductElement {
+  const Matrix<T, R, K> &left;
+  const Matrix<T, K, C> &right;
+  int row, col;
+  T sum;
+
+  __attribute__((always_inline)) inline void operator()(int k) { sum += left.m_data[row][k] * right.m_data[k][col]; }
+};
+
+// one row of a product, every column unrolled
+template <class T, int R, int K, int C>
+struct ProductRow {
+  const Matrix<T, R, K> &left;
+  const Matrix<T, K, C> &right;
+  Matrix<T, R, C> &result;
+  int row;
+
+  __attribute__((always_inline)) inline void operator()(int col) {
+    ProductElement<T, R, K, C> element = {left, right, row, col, 0};
+    Repeat<K>::loop(element);
+    result.m_data[row][col] = element.sum;
+  }
+};
+
+// the whole product, every row unrolled
+template <class T, int R, int K, int C>
+struct ProductRows {
+  const Matrix<T, R, K> &left;
+  const Matrix<T, K, C> &right;
+  Matrix<T, R, C> &result;
+
+  __attribute__((always_inline)) inline void operator()(int row) {
+    ProductRow<T, R, K, C> rowBody = {left, right, result, row};
+    Repeat<C>::loop(rowBody);
+  }
+};
+
+template <class T, int R, int K, int C>
+inline Matrix<T, R, C> operator*(const Matrix<T, R, K> &left, const Matrix<T, K, C> &right) {
+  Matrix<T, R, C> result;
+  ProductRows<T, R, K, C> rows = {left, right, result};
+  Repeat<R>::loop(rows);
+  return (result);
+}
+
+template <class T, int R, int C>
+inline Matrix<T, R, C> operator*(T scale, const Matrix<T, R, C> &matrix) {
+  return (matrix * scale);
+}
+
+/// dot product of two vectors
+template <class T, int N>
+inline T dot(const Vector<T, N> &left, const Vector<T, N> &right) {
+  return ((left.transpose() * right)(0, 0));
+}
+
+// sum -= lower(i, k) * lower(j, k) for every k < j
+template <class T, int N>
+struct CholeskySum {
+  const Matrix<T, N, N> &lower;
+  int i, j;
+  T sum;
+
+  __attribute__((always_inline)) inline void operator()(int k) {
+    if (k < j)
+      sum -= lower.m_data[i][k] * lower.m_data[j][k];
+  }
+};
+
+// column j of L below the diagonal
+template <class T, int N>
+struct CholeskyBelow {
+  const Matrix<T, N, N> &a;
+  Matrix<T, N, N> &lower;
+  int j;
+  T inverse; // 1 / lower(j, j)
+
+  __attribute__((always_inline)) inline void operator()(int i) {
+    if (i > j) {
+      CholeskySum<T, N> sum = {lower, i, j, a.m_data[i][j]};
+      Repeat<N>::loop(sum);
+      lower.m_data[i][j] = sum.sum * inverse;
+    }
+  }
+};
+
+// column j of L, the diagonal then what is below it
+template <class T, int N>
+struct CholeskyColumn {
+  const Matrix<T, N, N> &a;
+  Matrix<T, N, N> &lower;
+  bool positive;
+
+  __attribute__((always_inline)) inline void operator()(int j) {
+    CholeskySum<T, N> diagonal = {lower, j, j, a.m_data[j][j]};
+    Repeat<N>::loop(diagonal);
+    if (!(diagonal.sum > 0)) { // also catches NaN. The rest is thrown away, it only has to finish
+      positive = false;
+      diagonal.sum = 1;
+    }
+    T root = std::sqrt(diagonal.sum);
+    lower.m_data[j][j] = root;
+
+    CholeskyBelow<T, N> below = {a, lower, j, 1 / root};
+    Repeat<N>::loop(below);
+  }
+};
+
+/**
+ * Cholesky factorization A = L * L^T of a symmetric positive definite matrix
+ * @param a matrix to factor (only the lower triangle is read)
+ * @param lower where to put L (the upper triangle is set to 0)
+ * @return false if a is not positive definite (lower is then not usable)
+ */
+template <class T, int N>
+bool choleskyDecompose(const Matrix<T, N, N> &a, Matrix<T, N, N> &lower) {
+  lower = Matrix<T, N, N>::zeros();
+  CholeskyColumn<T, N> columns = {a, lower, true};
+  Repeat<N>::loop(columns);
+  return (columns.positive);
+}
+
+// sum -= factor(i, k) * x(k, c), for every k below i (lower) or above it (upper)
+template <class T, int N, int C, bool LOWER, bool TRANSPOSED>
+struct SubstituteSum {
+  const Matrix<T, N, N> &factor;
+  const Matrix<T, N, C> &x;
+  int i, c;
+  T sum;
+
+  __attribute__((always_inline)) inline void operator()(int k) {
+    if (LOWER ? k < i : k > i)
+      sum -= (TRANSPOSED ? factor.m_data[k][i] : factor.m_data[i][k]) * x.m_data[k][c];
+  }
+};
+
+// one row of a forward (L y = b) or backward (U x = y) substitution, the backward one counts down
+template <class T, int N, int C, bool LOWER, bool TRANSPOSED, bool UNIT_DIAGONAL>
+struct SubstituteRow {
+  const Matrix<T, N, N> &factor;
+  Matrix<T, N, C> &x;
+  int c;
+
+  __attribute__((always_inline)) inline void operator()(int step) {
+    int i = LOWER ? step : N - 1 - step;
+    SubstituteSum<T, N, C, LOWER, TRANSPOSED> sum = {factor, x, i, c, x.m_data[i][c]};
+    Repeat<N>::loop(sum);
+    x.m_data[i][c] = UNIT_DIAGONAL ? sum.sum : sum.sum / factor.m_data[i][i];
+  }
+};
+
+// both substitutions for one column of the right hand side
+template <class T, int N, int C, bool CHOLESKY>
+struct SubstituteColumn {
+  const Matrix<T, N, N> &factor;
+  Matrix<T, N, C> &x;
+
+  __attribute__((always_inline)) inline void operator()(int c) {
+    SubstituteRow<T, N, C, true, false, !CHOLESKY> forward = {factor, x, c}; // L y = b (LU's L has ones on the diagonal)
+    Repeat<N>::loop(forward);
+    SubstituteRow<T, N, C, false, CHOLESKY, false> backward = {factor, x, c}; // L^T x = y, or U x = y
+    Repeat<N>::loop(backward);
+  }
+};
+
+/**
+ * solves A x = b from the Cholesky factor of A
+ * @param lower L from choleskyDecompose
+ * @param b right hand side (a vector, or several as columns)
+ * @return x
+ */
+template <class T, int N, int C>
+Matrix<T, N, C> choleskySolve(const Matrix<T, N, N> &lower, const Matrix<T, N, C> &b) {
+  Matrix<T, N, C> x = b;
+  SubstituteColumn<T, N, C, true> columns = {lower, x};
+  Repeat<C>::loop(columns);
+  return (x);
+}
+
+// the row at or below j with the biggest entry in column j
+template <class T, int N>
+struct PivotSearch {
+  const Matrix<T, N, N> &lu;
+  int j;
+  int best;
+
+  __attribute__((always_inline)) inline void operator()(int i) {
+    if (i > j && std::fabs(lu.m_data[i][j]) > std::fabs(lu.m_data[best][j]))
+      best = i;
+  }
+};
+
+template <class T, int N>
+struct RowSwap {
+  Matrix<T, N, N> &lu;
+  int first, second;
+
+  __attribute__((always_inline)) inline void operator()(int c) {
+    T swap = lu.m_data[first][c];
+    lu.m_data[first][c] = lu.m_data[second][c];
+    lu.m_data[second][c] = swap;
+  }
+};
+
+// row i -= factor * row j, right of column j
+template <class T, int N>
+struct RowEliminate {
+  Matrix<T, N, N> &lu;
+  int i, j;
+  T factor;
+
+  __attribute__((always_inline)) inline void operator()(int c) {
+    if (c > j)
+      lu.m_data[i][c] -= factor * lu.m_data[j][c];
+  }
+};
+
+// every row below j, keeping the factors where the zeros would go
+template <class T, int N>
+struct LuBelow {
+  Matrix<T, N, N> &lu;
+  int j;
+  T inverse; // 1 / lu(j, j)
+
+  __attribute__((always_inline)) inline void operator()(int i) {
+    if (i > j) {
+      T factor = lu.m_data[i][j] * inverse;
+      lu.m_data[i][j] = factor;
+      RowEliminate<T, N> row = {lu, i, j, factor};
+      Repeat<N>::loop(row);
+    }
+  }
+};
+
+// column j: pick the pivot, swap it up, eliminate below it
+template <class T, int N>
+struct LuColumn {
+  Matrix<T, N, N> &lu;
+  int (&pivot)[N];
+  bool regular;
+
+  __attribute__((always_inline)) inline void operator()(int j) {
+    PivotSearch<T, N> search = {lu, j, j};
+    Repeat<N>::loop(search);
+    if (lu.m_data[search.best][j] == 0) { // singular. The rest is thrown away, it only has to finish
+      regular = false;
+      return;
+    }
+
+    if (search.best != j) {
+      RowSwap<T, N> swap = {lu, j, search.best};
+      Repeat<N>::loop(swap);
+      int swapped = pivot[j];
+      pivot[j] = pivot[search.best];
+      pivot[search.best] = swapped;
+    }
+
+    LuBelow<T, N> below = {lu, j, 1 / lu.m_data[j][j]};
+    Repeat<N>::loop(below);
+  }
+};
+
+/**
+ * LU factorization P A = L U with partial pivoting, L and U packed in one matrix
+ * (L below the diagonal with an implied diagonal of ones, U on and above it)
+ * @param a matrix to factor
+ * @param lu where to put L and U
+ * @param pivot where to put P, row i of P A is row pivot[i] of A
+ * @return false if a is singular (a zero pivot)
+ */
+template <class T, int N>
+bool luDecompose(const Matrix<T, N, N> &a, Matrix<T, N, N> &lu, int (&pivot)[N]) {
+  lu = a;
+  for (int i = 0; i < N; i++)
+    pivot[i] = i;
+
+  LuColumn<T, N> columns = {lu, pivot, true};
+  Repeat<N>::loop(columns);
+  return (columns.regular);
+}
+
+// x = P b, row by row
+template <class T, int N, int C>
+struct PivotRows {
+  const Matrix<T, N, C> &b;
+  const int (&pivot)[N];
+  Matrix<T, N, C> &x;
+
+  __attribute__((always_inline)) inline void operator()(int i) {
+    for (int c = 0; c < C; c++)
+      x.m_data[i][c] = b.m_data[pivot[i]][c];
+  }
+};
+
+/**
+ * solves A x = b from the LU factorization of A
+ * @param lu L and U from luDecompose
+ * @param pivot row order from luDecompose
+ * @param b right hand side (a vector, or several as columns)
+ * @return x
+ */
+template <class T, int N, int C>
+Matrix<T, N, C> luSolve(const Matrix<T, N, N> &lu, const int (&pivot)[N], const Matrix<T, N, C> &b) {
+  Matrix<T, N, C> x;
+  PivotRows<T, N, C> rows = {b, pivot, x};
+  Repeat<N>::loop(rows);
+  SubstituteColumn<T, N, C, false> columns = {lu, x};
+  Repeat<C>::loop(columns);
+  return (x);
+}
+
+/**
+ * solves A x = b (LU with partial pivoting)
+ * @param x where to put the solution
+ * @return false if a is singular (x is left alone)
+ */
+template <class T, int N, int C>
+bool solve(const Matrix<T, N, N> &a, const Matrix<T, N, C> &b, Matrix<T, N, C> &x) {
+  Matrix<T, N, N> lu;
+  int pivot[N];
+  if (!luDecompose(a, lu, pivot))
+    return false;
+  x = luSolve(lu, pivot, b);
+  return true;
+}
+
+/**
+ * inverse of A (LU with partial pivoting). Solving is cheaper and more accurate when that is all
+ * the inverse is for
+ * @return false if a is singular (inverse is left alone)
+ */
+template <class T, int N>
+bool invert(const Matrix<T, N, N> &a, Matrix<T, N, N> &inverse) {
+  return (solve(a, Matrix<T, N, N>::identity(), inverse));
+}
+
+/**
+ * least squares fit: the x that minimizes |A x - b|, from the normal equations A^T A x = A^T b
+ * (Cholesky). Fine for the well conditioned fits we do (feedforward gains, sensor calibration),
+ * M is the number of samples and N the number of unknowns. The sums over the samples are loops
+ * once M is past MAX_UNROLL, so a long fit doesn't inline one step per sample
+ * @param x where to put the fit
+ * @return false if the columns of a are not independent (x is left alone)
+ */
+template <class T, int M, int N>
+bool leastSquares(const Matrix<T, M, N> &a, const Vector<T, M> &b, Vector<T, N> &x) {
+  Matrix<T, N, M> aTransposed = a.transpose();
+  Matrix<T, N, N> lower;
+  if (!choleskyDecompose(aTransposed * a, lower))
+    return false;
+  x = choleskySolve(lower, aTransposed * b);
+  return true;
+}
+
+} // namespace math3142a
@@ -1,39 +1,149 @@
 #pragma once
+#include <stddef.h>
+#include <stdint.h>
 
-#include <iostream>
+/*
+* Logging
+*
+*   LOG_DEBUG(FLYWHEEL, "SCORING", topLine.value(analogUnits::range10bit));
+*
+* prints its arguments separated by spaces, one line per call, after the time it was logged at
+* (seconds since power on, to the microsecond, see Util/timestamp.h). Which logs exist is decided
+* at compile time by LOG_LEVEL and one LOG_MODULE_* switch per subsystem (set them in the
+* makefile's DEFINES).
+* A log that is switched off is an if (0), so its arguments are never evaluated and the optimizer
+* removes the call completely; it still has to compile, so it can't rot while it is off.
+*
+* The line is formatted into a buffer on the caller's stack and copied into one shared buffer that
+* the log task (logTask) writes out every LOG_FLUSH_MS. Control loops never wait on the serial port,
+* unlike std::endl which flushed on every call: if the buffer is full the line is dropped and counted,
+* and the log task says how many went missing. LOG_ERROR lines are written out straight away.
+* Whoever writes, it goes through writeSerial, which the telemetry frames share
+*/
 
-template <class T>
-void LOG(T x)
-{
-    std::cout << x << std::endl;
-}
+#define LOG_LEVEL_NONE 0
+#define LOG_LEVEL_ERROR 1 // something is wrong (bad config, heap use while driving)
+#define LOG_LEVEL_INFO 2  // once per event (boot reports, autonomous starting)
+#define LOG_LEVEL_DEBUG 3 // every tick of a loop, only for tuning
 
-template <class T, class U>
-void LOG(T x, U y)
-{
-    std::cout << x << " " << y << std::endl;
-}
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_INFO
+#endif
 
-template <class T, class U, class V>
-void LOG(T x, U y, V z)
-{
-    std::cout << x << " " << y << " " << z << std::endl;
-}
+// per subsystem switches, 0 removes every log of that subsystem whatever its level
+#ifndef LOG_MODULE_GENERAL
+#define LOG_MODULE_GENERAL 1
+#endif
+#ifndef LOG_MODULE_BOOT
+#define LOG_MODULE_BOOT 1
+#endif
+#ifndef LOG_MODULE_CONFIG
+#define LOG_MODULE_CONFIG 1
+#endif
+#ifndef LOG_MODULE_CHASSIS
+#define LOG_MODULE_CHASSIS 1
+#endif
+#ifndef LOG_MODULE_FLYWHEEL
+#define LOG_MODULE_FLYWHEEL 1
+#endif
+#ifndef LOG_MODULE_INDEXER
+#define LOG_MODULE_INDEXER 1
+#endif
+#ifndef LOG_MODULE_INTAKES
+#define LOG_MODULE_INTAKES 1
+#endif
+
+/// true (at compile time) when logs of this module and level are compiled in
+#define LOG_ENABLED(module, level) (LOG_MODULE_##module && (level) <= LOG_LEVEL)
+
+#define LOG_AT(module, level, ...)                                                                 \
+  do {                                                                                             \
+    if (LOG_ENABLED(module, level))                                                                \
+      log3142a::writeLog((level) == LOG_LEVEL_ERROR, __VA_ARGS__);                                 \
+  } while (0)
+
+#define LOG_ERROR(module, ...) LOG_AT(module, LOG_LEVEL_ERROR, __VA_ARGS__)
+#define LOG_INFO(module, ...) LOG_AT(module, LOG_LEVEL_INFO, __VA_ARGS__)
+#define LOG_DEBUG(module, ...) LOG_AT(module, LOG_LEVEL_DEBUG, __VA_ARGS__)
+
+// what LOG always was, an info line that belongs to no subsystem in particular
+#define LOG(...) LOG_INFO(GENERAL, __VA_ARGS__)
+
+namespace log3142a {
+
+const int LOG_LINE_SIZE = 128;    // longest line, longer ones are cut
+const int LOG_BUFFER_SIZE = 2048; // lines waiting for the log task
+const int LOG_FLUSH_MS = 50;      // how often the log task writes them out
+
+/**
+ * struct logLine
+ * One line being formatted
+ */
 
-template <class T, class U, class V, class W>
-void LOG(T x, U y, V z, W a)
-{
-    std::cout << x << " " << y << " " << z << " " << a << std::endl;
+struct logLine {
+  char text[LOG_LINE_SIZE];
+  int length;
+};
+
+// one per type we log, everything else converts to one of these
+void append(logLine &line, const char *value);
+void append(logLine &line, char value);
+void append(logLine &line, bool value);
+void append(logLine &line, int value);
+void append(logLine &line, unsigned int value);
+void append(logLine &line, long value);
+void append(logLine &line, unsigned long value);
+void append(logLine &line, long long value);
+void append(logLine &line, unsigned long long value);
+void append(logLine &line, double value);
+
+/// the time the line is logged at, in front of it
+void appendTimestamp(logLine &line);
+
+inline void appendAll(logLine &) {}
+
+template <class T, class... Rest>
+void appendAll(logLine &line, const T &first, const Rest &... rest) {
+  append(line, first);
+  if (sizeof...(rest) > 0)
+    append(line, ' ');
+  appendAll(line, rest...);
 }
 
-template <class T, class U, class V, class W, class X>
-void LOG(T x, U y, V z, W a, X b)
-{
-    std::cout << x << " " << y << " " << z << " " << a << " " << b << std::endl;
+/**
+ * queues a finished line for the log task. Never waits on the serial port unless urgent
+ * @param line the line (a newline is added)
+ * @param urgent write it out now instead of on the next flush
+ */
+
+void queueLine(logLine &line, bool urgent);
+
+/// use the LOG macros instead, they are what removes disabled logs
+template <class... Args>
+void writeLog(bool urgent, const Args &... args) {
+  logLine line;
+  line.length = 0;
+  appendTimestamp(line);
+  appendAll(line, args...);
+  queueLine(line, urgent);
 }
 
-template <class T, class U, class V, class W, class X, class Y>
-void LOG(T x, U y, V z, W a, X b, Y c)
-{
-    std::cout << x << " " << y << " " << z << " " << a << " " << b << " " << c << std::endl;
-}
\ No newline at end of file
+/// writes every queued line out now, then a LOG DROPPED line if any were dropped since the last one
+void flushLog();
+
+/// lines dropped since power on because the buffer was full
+uint32_t getDroppedLogLines();
+
+/**
+ * writes bytes to the serial port (stdout) in one piece. Everything that goes out on the port
+ * (log lines, telemetry frames) is written through here, under one lock, so a frame never
+ * ends up in the middle of a line or the other way round
+ * @param data bytes to write
+ * @param length number of bytes
+ */
+void writeSerial(const void *data, int length);
+
+/// low priority task that calls flushLog every LOG_FLUSH_MS (started in pre_auto)
+int logTask();
+
+} // namespace log3142a
@@ -0,0 +1,63 @@
+#pragma once
+#include "Util/vex.h"
+#include <stdint.h>
+
+/*
+* Timestamps
+*
+* One monotonic clock for everything that needs the time: logs, telemetry records, boot profiling,
+* metrics and the motion profiles. On the brain it is the system's microsecond timer (the best
+* clock there is, a single register read), on the host it is the stand-in's timer, which reads
+* std::chrono::steady_clock, or the virtual clock when the simulator runs (see host/include/v5_vcs.h).
+* Neither goes backwards or jumps when something else resets a timer, unlike Brain.timer, which the
+* motion profiles used to read as a double of seconds.
+*
+* The time counts from power on (on the host, from when the program started). 64 bits of
+* microseconds never wrap, the 32 bit versions used in records (micros32, millis) wrap after
+* 71 minutes and 49 days, which differences in unsigned math don't mind
+*/
+
+namespace math3142a {
+
+/// microseconds since power on
+inline uint64_t micros() { return (vex::timer::systemHighResolution()); }
+
+/// micros() cut to 32 bits, for records and fields that store it
+inline uint32_t micros32() { return ((uint32_t)micros()); }
+
+/// milliseconds on the same clock, for timeouts and UI timing
+inline uint32_t millis() { return ((uint32_t)(micros() / 1000)); }
+
+/**
+ * Class Stopwatch. Measures time from when it was started, e.g. a motion profile's time or
+ * how long a load took. Reading it is one clock read and a subtraction
+ */
+
+class Stopwatch {
+public:
+  Stopwatch() : m_start(micros()) {}
+
+  /// starts counting from now again
+  void restart() { m_start = micros(); }
+
+  uint64_t elapsedMicros() const { return (micros() - m_start); }
+  uint32_t elapsedMillis() const { return ((uint32_t)(elapsedMicros() / 1000)); }
+  double elapsedSeconds() const { return (elapsedMicros() * 1e-6); }
+
+  /**
+   * time since the start (or the last lap), then starts counting from now,
+   * for timing consecutive steps without missing the time between them
+   * @return elapsed time (us)
+   */
+  uint64_t lap() {
+    uint64_t now = micros();
+    uint64_t elapsed = now - m_start;
+    m_start = now;
+    return (elapsed);
+  }
+
+private:
+  uint64_t m_start; // micros() when started
+};
+
+} // namespace math3142a
@@ -0,0 +1,80 @@
+#pragma once
+
+namespace math3142a {
+
+/**
+ * Class Quantity. A value with its unit checked by the compiler
+ *
+ * The unit is the powers of meters (L), radians (A), seconds (T) and volts (V) in the template,
+ * and the value is a plain double in those SI units. Adding needs the same unit on both sides,
+ * multiplying and dividing add and subtract the powers, so driving an angle or passing a
+ * velocity as an acceleration doesn't compile. Radians are kept as their own unit so angular
+ * and linear velocities can't be mixed up either.
+ *
+ * There is nothing else in the class and everything is constexpr and inline, so the compiler
+ * ends up with exactly the double math it would have done without the units.
+ * Literals to write them with are in Util/literals.h
+ */
+
+template <int L, int A, int T, int V>
+class Quantity {
+public:
+  constexpr Quantity() : m_value(0) {}
+  explicit constexpr Quantity(double value) : m_value(value) {}
+
+  /// the value in SI units (m, rad, s, V)
+  constexpr double value() const { return (m_value); }
+
+  constexpr Quantity operator+(Quantity other) const { return Quantity(m_value + other.m_value); }
+  constexpr Quantity operator-(Quantity other) const { return Quantity(m_value - other.m_value); }
+  constexpr Quantity operator-() const { return Quantity(-m_value); }
+  constexpr Quantity operator*(double scale) const { return Quantity(m_value * scale); }
+  constexpr Quantity operator/(double scale) const { return Quantity(m_value / scale); }
+  Quantity &operator+=(Quantity other) {
+    m_value += other.m_value;
+    return *this;
+  }
+  Quantity &operator-=(Quantity other) {
+    m_value -= other.m_value;
+    return *this;
+  }
+
+  constexpr bool operator<(Quantity other) const { return (m_value < other.m_value); }
+  constexpr bool operator>(Quantity other) const { return (m_value > other.m_value); }
+  constexpr bool operator<=(Quantity other) const { return (m_value <= other.m_value); }
+  constexpr bool operator>=(Quantity other) const { return (m_value >= other.m_value); }
+  constexpr bool operator==(Quantity other) const { return (m_value == other.m_value); }
+  constexpr bool operator!=(Quantity other) const { return (m_value != other.m_value); }
+
+private:
+  double m_value;
+};
+
+template <int L, int A, int T, int V>
+constexpr Quantity<L, A, T, V> operator*(double scale, Quantity<L, A, T, V> quantity) {
+  return (quantity * scale);
+}
+
+template <int L1, int A1, int T1, int V1, int L2, int A2, int T2, int V2>
+constexpr Quantity<L1 + L2, A1 + A2, T1 + T2, V1 + V2> operator*(Quantity<L1, A1, T1, V1> left,
+                                                                 Quantity<L2, A2, T2, V2> right) {
+  return Quantity<L1 + L2, A1 + A2, T1 + T2, V1 + V2>(left.value() * right.value());
+}
+
+template <int L1, int A1, int T1, int V1, int L2, int A2, int T2, int V2>
+constexpr Quantity<L1 - L2, A1 - A2, T1 - T2, V1 - V2> operator/(Quantity<L1, A1, T1, V1> left,
+                                                                 Quantity<L2, A2, T2, V2> right) {
+  return Quantity<L1 - L2, A1 - A2, T1 - T2, V1 - V2>(left.value() / right.value());
+}
+
+typedef Quantity<0, 0, 0, 0> Scalar; // what is left after dividing two of the same unit
+typedef Quantity<1, 0, 0, 0> Length;
+typedef Quantity<0, 0, 1, 0> Time;
+typedef Quantity<1, 0, -1, 0> Velocity;
+typedef Quantity<1, 0, -2, 0> Acceleration;
+typedef Quantity<0, 1, -1, 0> AngularVelocity;
+typedef Quantity<0, 1, -2, 0> AngularAcceleration;
+typedef Quantity<0, 0, 0, 1> Voltage;
+// angles are the Angle class in Util/angle.h, a Quantity<0, 1, 0, 0> with wrapping on top
+
+} // namespace math3142a
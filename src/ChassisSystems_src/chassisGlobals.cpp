@@ -1,18 +1,25 @@
 #include "ChassisSystems/chassisGlobals.h"
+#include "ChassisSystems/ChassisBuilder.h"
 #include "Util/vex.h"
+#include "Util/fastMath.h"
 
-FourMotorDrive::FourMotorDrive( const std::array<int32_t, 2> &leftGroup,
-                 const std::array<int32_t, 2> &rightGroup,
-                 const gearSetting setting, const double gearRatio,
-                 const Dimensions chassisDimensions, const Limits linLimits,
+template <int N>
+DifferentialDrive<N>::DifferentialDrive( std::array<motor, N> &leftGroup,
+                 std::array<motor, N> &rightGroup,
+                 const ChassisConstants &constants,
+                 const Limits linLimits,
                  const Limits angLimits,
-                 const std::initializer_list<PDcontroller> PDGains)
+                 const std::array<PDcontroller, 3> &PDGains,
+                 const feedforwardGains feedforward,
+                 const encoderReduction reduction)
 
-    : m_chassisDimensions(chassisDimensions), m_chassisLinearLimits(linLimits),
-    m_chassisAngularLimits(angLimits),
-      leftFront(leftGroup[FRONT], setting),
-      rightFront(rightGroup[FRONT], setting),
-      leftBack(leftGroup[BACK], setting), rightBack(rightGroup[BACK], setting) {
+    : m_constants(constants), m_chassisLinearLimits(linLimits),
+    m_chassisAngularLimits(angLimits), m_feedforwardGains(feedforward),
+      m_leftMotors(leftGroup), m_rightMotors(rightGroup),
+      leftFront(leftGroup[FRONT]),
+      rightFront(rightGroup[FRONT]),
+      leftBack(leftGroup[BACK]), rightBack(rightGroup[BACK]),
+      m_reduction(reduction) {
 
   enum posPIDType { DISTANCEPID, ANGLEPID, TURNPID };
   int count = 0;
@@ -33,68 +40,78 @@ FourMotorDrive::FourMotorDrive( const std::array<int32_t, 2> &leftGroup,
 
     count++;
   }
-  this->gearRatio = gearRatio;
-  this->setting = setting;
 }
-void FourMotorDrive::setReverseSettings(
-    const std::array<bool, 2> &LeftReverseVals,
-    const std::array<bool, 2> &RightReverseVals) {
-  leftFront.setReversed(LeftReverseVals[0]);
-  leftBack.setReversed(LeftReverseVals[1]);
-  rightFront.setReversed(RightReverseVals[0]);
-  rightBack.setReversed(RightReverseVals[1]);
+
+template <int N>
+DifferentialDrive<N>::DifferentialDrive(const Builder &builder)
+    : DifferentialDrive(*builder.m_leftGroup, *builder.m_rightGroup, builder.m_constants,
+                     builder.b_chassisLinearLimits, builder.b_chassisAngularLimits, builder.m_PDGains, builder.m_feedforward,
+                     builder.m_reduction) {}
+
+template <int N>
+void DifferentialDrive<N>::setReverseSettings(
+    const std::array<bool, N> &LeftReverseVals,
+    const std::array<bool, N> &RightReverseVals) {
+  MotorGroup<N>::setReversed(m_leftMotors, LeftReverseVals);
+  MotorGroup<N>::setReversed(m_rightMotors, RightReverseVals);
+}
+
+template <int N>
+void DifferentialDrive<N>::requestFeedforward(const feedforwardGains &gains) {
+  m_pendingFeedforward.post(gains);
 }
 
-void FourMotorDrive::resetPosition() {
-  this->leftFront.resetPosition();
-  this->leftBack.resetPosition();
-  this->rightFront.resetPosition();
-  this->rightBack.resetPosition();
+template <int N>
+feedforwardGains DifferentialDrive<N>::getRequestedFeedforward() const {
+  feedforwardGains gains;
+  if (!m_pendingFeedforward.peek(gains))
+    gains = m_feedforwardGains;
+  return (gains);
 }
 
-void FourMotorDrive::resetRotation() {
-  this->leftFront.resetRotation();
-  this->leftBack.resetRotation();
-  this->rightFront.resetRotation();
-  this->rightBack.resetRotation();
+template <int N>
+void DifferentialDrive<N>::resetPosition() {
+  MotorGroup<N>::resetPosition(m_leftMotors);
+  MotorGroup<N>::resetPosition(m_rightMotors);
 }
 
-Dimensions::Dimensions( const long double trackWidth,  const long double wheelRadius, const long double ticksToDegrees)
-    : m_trackWidth(trackWidth), m_wheelRadius(wheelRadius) {}
+template <int N>
+void DifferentialDrive<N>::resetRotation() {
+  MotorGroup<N>::resetRotation(m_leftMotors);
+  MotorGroup<N>::resetRotation(m_rightMotors);
+}
+
+// every drive size we build (a 6 motor drive adds DifferentialDrive<3> here and in chassisfunctions.cpp)
+template class DifferentialDrive<2>;
+
+Dimensions::Dimensions( const math3142a::Length trackWidth,  const math3142a::Length wheelRadius, const double ticksToDegrees)
+    : m_trackWidth(trackWidth.value()), m_wheelRadius(wheelRadius.value()), ticksToDegrees(ticksToDegrees) {}
 
-Limits::Limits(  long double maxVelocity,   long double maxAcceleration)
+Limits::Limits(  math3142a::Velocity maxVelocity,   math3142a::Acceleration maxAcceleration)
+    : m_maxVelocity(maxVelocity.value()), m_maxAcceleration(maxAcceleration.value()) {}
+
+Limits::Limits(  math3142a::AngularVelocity maxVelocity,   math3142a::AngularAcceleration maxAcceleration)
+    : m_maxVelocity(maxVelocity.value()), m_maxAcceleration(maxAcceleration.value()) {}
+
+Limits::Limits(  double maxVelocity,   double maxAcceleration)
     : m_maxVelocity(maxVelocity), m_maxAcceleration(maxAcceleration) {}
 
-Tracking::Tracking(WheelDistances wheels, double wheelRadius,
-                   std::vector<triportIndex> enocoderPorts, int GyroPort,
-                   double ticksPerRev)
-    : m_odomImpl(wheels),
-      rightEncoder(brained.ThreeWirePort.Port[enocoderPorts[RIGHT_ENCODER]]),
-      leftEncoder(brained.ThreeWirePort.Port[enocoderPorts[LEFT_ENCODER]]),
-      backEncoder(brained.ThreeWirePort.Port[enocoderPorts[BACK_ENCODER]]),
-      inert(GyroPort) {
+Tracking::Tracking(WheelDistances wheels, double wheelRadius, encoder &rightEncoder,
+                   encoder &backEncoder, inertial &inert, double ticksPerRev)
+    : m_odomImpl(wheels), rightEncoder(rightEncoder), backEncoder(backEncoder), inert(inert) {
   this->ticksPerRev = ticksPerRev;
 
   this->wheelRadius = wheelRadius;
 }
 
-double FourMotorDrive::convertMetersToTicks( const double num_meters) const {
-  return (num_meters * (360 / (m_chassisDimensions.m_wheelRadius * M_PI)) * this->gearRatio);
-}
-double FourMotorDrive::convertTicksToMeters( const double num_ticks) const {
-  return (num_ticks * (m_chassisDimensions.m_wheelRadius * M_PI / 360) * this->gearRatio);
-}
  double Tracking::getInertialHeading() {
   // change the direction to counter clockwise = positive
   double fixedRotation = -1 * this->inert.rotation();
 
-  // Fix the inertial value between [-180,180]
-  while (fixedRotation > 180) {
-    (fixedRotation -= 360);
-  }
-  while (fixedRotation < -180) {
-    (fixedRotation += 360);
-  }
+  // Fix the inertial value between [-180,180] (no loop, however many turns the IMU has counted)
+  return (math3142a::wrapDegrees(fixedRotation));
+}
 
-  return (fixedRotation);
+math3142a::Angle Tracking::getHeading() {
+  return (math3142a::Angle::fromDegrees(-1 * this->inert.rotation())); // counter clockwise = positive
 }
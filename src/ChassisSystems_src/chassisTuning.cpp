@@ -0,0 +1,26 @@
+#include "ChassisSystems/chassisTuning.h"
+#include "Config/chassis-config.h"
+#include "Config/configStore.h"
+
+chassisGains getChassisGains(const FourMotorDrive &drive) {
+  // peek, never take: only the motion loops apply requests, this may run on any task
+  chassisGains gains;
+  gains.distance = drive.distancePID.getRequestedPD();
+  gains.angle = drive.anglePID.getRequestedPD();
+  gains.turn = drive.turnPID.getRequestedPD();
+  gains.feedforward = drive.getRequestedFeedforward();
+  return (gains);
+}
+
+void requestChassisGains(FourMotorDrive &drive, const chassisGains &gains) {
+  drive.distancePID.requestPD(gains.distance.kP, gains.distance.kD);
+  drive.anglePID.requestPD(gains.angle.kP, gains.angle.kD);
+  drive.turnPID.requestPD(gains.turn.kP, gains.turn.kD);
+  drive.requestFeedforward(gains.feedforward);
+}
+
+bool saveChassisGains(const chassisGains &gains) {
+  // the gains are part of the robot config, so saving them rewrites config.bin
+  getRobotConfig().gains = gains;
+  return (saveRobotConfig());
+}
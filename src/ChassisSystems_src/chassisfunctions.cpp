@@ -3,16 +3,46 @@
 #include "Util/mathAndConstants.h"
 #include "ChassisSystems/motionprofile.h"
 #include "Config/chassis-config.h"
+#include "Telemetry/telemetry.h"
+#include "Telemetry/recordLog.h"
+#include "Telemetry/capture.h"
+#include "Telemetry/metrics.h"
+#include "Util/allocTracker.h"
+#include "Util/timestamp.h"
 
 #include <algorithm>
 #include "Util/literals.h"
-#include <memory>
 
+// chassis metrics (see Telemetry/metrics.h)
+static const float DRIVE_ERROR_BOUNDS[] = {0.005f, 0.01f, 0.02f, 0.05f, 0.1f}; // m
+static const float TURN_TIME_BOUNDS[] = {250, 500, 750, 1000, 1500, 2000, 3000}; // ms
+static telemetry3142a::metricID driveCount = telemetry3142a::METRICS_FULL;
+static telemetry3142a::metricID driveError = telemetry3142a::METRICS_FULL;
+static telemetry3142a::metricID turnCount = telemetry3142a::METRICS_FULL;
+static telemetry3142a::metricID turnTime = telemetry3142a::METRICS_FULL;
+
+void addChassisMetrics() {
+  driveCount = telemetry3142a::addCounter("drive.count");
+  driveError = telemetry3142a::addHistogram("drive.endError", DRIVE_ERROR_BOUNDS, 5);
+  turnCount = telemetry3142a::addCounter("turn.count");
+  turnTime = telemetry3142a::addHistogram("turn.settleMs", TURN_TIME_BOUNDS, 7);
+}
+
+// the drive voltages and the heading for the dashboard. Recorded by the motion loops, not setDrive,
+// which driver control and the selector call from their own tasks (a signal only has one task recording it)
+static void recordDriveSignals(double leftVoltage, double rightVoltage) {
+  telemetry3142a::record(telemetry3142a::LEFT_VOLTAGE, leftVoltage);
+  telemetry3142a::record(telemetry3142a::RIGHT_VOLTAGE, rightVoltage);
+  telemetry3142a::record(telemetry3142a::HEADING, poseTracker.getHeading().wrapped().inDegrees());
+}
 
 
 
-void FourMotorDrive::turnToDegreeGyro(const double angle)
+template <int N>
+void DifferentialDrive<N>::turnToDegreeGyro(const math3142a::Angle target)
 {
+  math3142a::ControlCriticalSection critical("turnToDegreeGyro");
+  const math3142a::Stopwatch turnClock;
   bool atAngle = false;
   /***************************************************************************************************************************/
 
@@ -21,25 +51,30 @@ void FourMotorDrive::turnToDegreeGyro(const double angle)
   // <https://github.com/Team-Optimistic/Team_Optimistic/blob/d6b11f7d5a9e58c72e2c5dd9d944369602bc20a7/turningFunctions.c#L69>
 
   /****************************************************************************************************************************/
-  pidTimer turnTimer;
-  posPID hi = posPID(28, 65);
+  pidTimer turnTimer = {0, 0};
+  turnPID.reset(); // gains live in turnPID so the selector PID tuner can change them (see Config_src/chassis-config.cpp)
 
   const double timeoutPeriod = 200;
 
-  const double acceptableError = 3.0_deg; // give three degrees of error
+  const math3142a::Angle acceptableError = 3.0_deg; // give three degrees of error
+
+  double startSign = 0;   // sign of the error the turn started with, 0 until there is one
+  bool overshot = false;  // the overshoot capture was triggered (once per turn)
 
   while (!atAngle)
   {
-    double currentAngleRadians = math3142a::toRadians(poseTracker.getInertialHeading());
+    const math3142a::Angle current = poseTracker.getHeading().wrapped();
 
-    double angleOutput = hi.calculatePower(angle, currentAngleRadians); //no need to initilze turnPID here becuase it is in the initlizer list (see Config_src/chassis-config.cpp)
-    
-    adjustOutput(angle,angleOutput);
+    // the short way round, so the error never jumps when the heading crosses +-180
+    const math3142a::Angle turnError = current.shortestTo(target);
+
+    double angleOutput = turnPID.calculatePower(turnError.inRadians(), 0); //no need to initilze turnPID here becuase it is in the initlizer list (see Config_src/chassis-config.cpp)
     
     this->setDrive(-1 * angleOutput, angleOutput );
+    recordDriveSignals(-1 * angleOutput, angleOutput);
     
     //If we are close to the target start incrementing timeout
-    if (std::abs(angle - currentAngleRadians) < acceptableError)
+    if (turnError.magnitude() < acceptableError)
     {
       turnTimer.close += 10;
     }
@@ -55,18 +90,35 @@ void FourMotorDrive::turnToDegreeGyro(const double angle)
       atAngle = true;
     }
 
-    LOG(math3142a::toDegrees(angle),math3142a::toDegrees(currentAngleRadians));
+    LOG_DEBUG(CHASSIS, target.inDegrees(), current.inDegrees());
+    telemetry3142a::logRecord(telemetry3142a::TURN_RECORD, target.inDegrees(), current.inDegrees(), angleOutput);
+
+    telemetry3142a::captureSample(telemetry3142a::TURN_CAPTURE, target.inDegrees(), current.inDegrees(), angleOutput);
+    double error = turnError.inDegrees();
+    if (startSign == 0)
+      startSign = (error > 0) - (error < 0);
+    // went past the target: the error has the other sign from the start, and grew over the limit since
+    if (!overshot && error * startSign < 0 && std::abs(error) > telemetry3142a::TURN_OVERSHOOT_LIMIT) {
+      telemetry3142a::captureTrigger(telemetry3142a::TURN_CAPTURE, telemetry3142a::ERROR_TRIGGER, error);
+      overshot = true;
+    }
     
     task::sleep(10);
   }
   this->setDrive(0, 0);
+
+  telemetry3142a::countMetric(turnCount);
+  telemetry3142a::observeMetric(turnTime, turnClock.elapsedMillis());
 }
 
-void FourMotorDrive::driveStraightFeedforward(const double distance, bool backwards)
+template <int N>
+void DifferentialDrive<N>::driveStraightFeedforward(const math3142a::Length distance, bool backwards)
 {
-    const double startTime = Brain.timer(timeUnits::sec); //"resetting" timer
+    math3142a::ControlCriticalSection critical("driveStraightFeedforward");
 
-    TrapezoidalMotionProfile trap(getMaxLinearVelocity(), getMaxLinearAcceleration(), distance);
+    const math3142a::Stopwatch profileClock; // the motion profile's time starts here
+
+    TrapezoidalMotionProfile trap(getMaxLinearVelocity(), getMaxLinearAcceleration(), distance.value());
 
     double mpVel, mpAcc; //forward ref for motion profile velocity and acceleration
 
@@ -83,24 +135,37 @@ void FourMotorDrive::driveStraightFeedforward(const double distance, bool backwa
     // Our estamate for kV was 11V / maxVel as the inputted max velocity in the FourMotorDrive constructor was base on the robot travelling at 11V
     // the values for kA had to be tuned, but again it took consideriably less time than tuning PID
 
-    const Feedfoward rFeedforwardConstants(11/trap.getMpMaxVelocity(),.1);
+    // These gains can be changed by the selector PID tuner while we drive, so they are picked up again every tick
+
+    Feedfoward rFeedforwardConstants(m_feedforwardGains.maxVoltage/trap.getMpMaxVelocity(),m_feedforwardGains.rightKa);
 
-    const Feedfoward lFeedforwardConstants(11/trap.getMpMaxVelocity(),.08);
+    Feedfoward lFeedforwardConstants(m_feedforwardGains.maxVoltage/trap.getMpMaxVelocity(),m_feedforwardGains.leftKa);
 
-    posPID rFeedback(0, 0);
+    distancePID.applyPendingGains();
 
-    posPID lFeedback(0,  0);
+    posPID rFeedback(distancePID.getKp(), distancePID.getKd());
+
+    posPID lFeedback(distancePID.getKp(), distancePID.getKd());
 
     double rPower, lPower;
 
     while (currentTime <= trap.getMpTotalTime())
     {
+      if (m_pendingFeedforward.take(m_feedforwardGains)) // new gains only ever land between two ticks
+      {
+        rFeedforwardConstants = Feedfoward(m_feedforwardGains.maxVoltage/trap.getMpMaxVelocity(),m_feedforwardGains.rightKa);
+        lFeedforwardConstants = Feedfoward(m_feedforwardGains.maxVoltage/trap.getMpMaxVelocity(),m_feedforwardGains.leftKa);
+      }
+
+      distancePID.applyPendingGains();
+      rFeedback.setPD(distancePID.getKp(), distancePID.getKd());
+      lFeedback.setPD(distancePID.getKp(), distancePID.getKd());
 
       double currLeftMoved = this->convertTicksToMeters(this->getLeftEncoderValueMotors()) - initialMetersLeft; // (in meters)
 
       double currRightMoved = this->convertTicksToMeters(this->getRightEncoderValueMotors()) - initialMetersRight; // (in meters)
 
-      currentTime = Brain.timer(timeUnits::sec) - startTime;
+      currentTime = profileClock.elapsedSeconds();
 
       mpVel = trap.calculateMpVelocity(currentTime); //velocity of motion profile
       
@@ -120,6 +185,7 @@ void FourMotorDrive::driveStraightFeedforward(const double distance, bool backwa
      checkBackwards(lVoltage,rVoltage,backwards);
      
      this->setDrive(lVoltage,rVoltage);
+     recordDriveSignals(lVoltage, rVoltage);
 
      if (!backwards)
      {
@@ -132,12 +198,27 @@ void FourMotorDrive::driveStraightFeedforward(const double distance, bool backwa
      }
 
      prevTime = currentTime; 
-     LOG("DRIVING STRAIGHT");
+
+     telemetry3142a::record(telemetry3142a::PROFILE_POSITION, pose);
+     telemetry3142a::record(telemetry3142a::MEASURED_POSITION, (currLeftMoved + currRightMoved) / 2);
+     telemetry3142a::logRecord(telemetry3142a::DRIVE_STRAIGHT_RECORD, pose, (currLeftMoved + currRightMoved) / 2, lVoltage, rVoltage);
+
+     telemetry3142a::captureSample(telemetry3142a::DRIVE_CAPTURE, pose, (currLeftMoved + currRightMoved) / 2, lVoltage, rVoltage);
+     double followingError = pose - (currLeftMoved + currRightMoved) / 2;
+     if (std::abs(followingError) > telemetry3142a::DRIVE_ERROR_LIMIT)
+       telemetry3142a::captureTrigger(telemetry3142a::DRIVE_CAPTURE, telemetry3142a::ERROR_TRIGGER, followingError);
+
+     LOG_DEBUG(CHASSIS, "DRIVING STRAIGHT");
      task::sleep(10);
       
     }
 
   this->setDrive(0, 0); //stopping bot
+
+  double endLeft = this->convertTicksToMeters(this->getLeftEncoderValueMotors()) - initialMetersLeft;
+  double endRight = this->convertTicksToMeters(this->getRightEncoderValueMotors()) - initialMetersRight;
+  telemetry3142a::countMetric(driveCount);
+  telemetry3142a::observeMetric(driveError, std::abs(pose - (endLeft + endRight) / 2));
 }
 
 
@@ -145,31 +226,23 @@ void FourMotorDrive::driveStraightFeedforward(const double distance, bool backwa
 
 
 
-void FourMotorDrive::setVelDrive(double leftVelocity, double rightVelocity, velocityUnits units)
+template <int N>
+void DifferentialDrive<N>::setVelDrive(double leftVelocity, double rightVelocity, velocityUnits units)
 {
-    leftFront.spin(fwd, leftVelocity, units);
-    leftBack.spin(fwd, leftVelocity, units);
-    rightFront.spin(fwd, rightVelocity, units);
-    rightBack.spin(fwd, rightVelocity, units);
+    MotorGroup<N>::spin(m_leftMotors, leftVelocity, units);
+    MotorGroup<N>::spin(m_rightMotors, rightVelocity, units);
 }
 
-void FourMotorDrive::setDrive(double leftVoltage, double rightVoltage)
+template <int N>
+void DifferentialDrive<N>::setDrive(double leftVoltage, double rightVoltage)
 {
-    leftFront.spin(fwd, leftVoltage, volt);
-    leftBack.spin(fwd, leftVoltage, volt);
-    rightFront.spin(fwd, rightVoltage, volt);
-    rightBack.spin(fwd, rightVoltage, volt);
+    MotorGroup<N>::spin(m_leftMotors, leftVoltage, volt);
+    MotorGroup<N>::spin(m_rightMotors, rightVoltage, volt);
 }
 
 
-inline void FourMotorDrive::adjustOutput(double targetAngle,double& angleOutput) {
-    if(targetAngle - math3142a::toRadians(poseTracker.getInertialHeading()) > M_PI || targetAngle - math3142a::toRadians(poseTracker.getInertialHeading()) < -1 * M_PI ) {
-
-    angleOutput = -1*angleOutput;
-    }
-}
-
-inline void FourMotorDrive::checkBackwards(double& lVoltage , double& rVoltage , bool backwards) {
+template <int N>
+inline void DifferentialDrive<N>::checkBackwards(double& lVoltage , double& rVoltage , bool backwards) {
   if(backwards) {
     lVoltage = lVoltage * -1;
     rVoltage = rVoltage * -1;
@@ -179,37 +252,42 @@ inline void FourMotorDrive::checkBackwards(double& lVoltage , double& rVoltage ,
 
 
 
-double FourMotorDrive::getAverageEncoderValueMotors()
+template <int N>
+double DifferentialDrive<N>::getAverageEncoderValueMotors()
 {
-  return ((leftFront.position(degrees) + rightFront.position(degrees) + leftBack.position(degrees) + rightBack.position(degrees)) / 4);
+  return ((getLeftEncoderValueMotors() + getRightEncoderValueMotors()) / 2);
 }
 
-double FourMotorDrive::getRightEncoderValueMotors()
+template <int N>
+double DifferentialDrive<N>::getRightEncoderValueMotors()
 {
-  return ((rightFront.position(degrees) + rightBack.position(degrees)) / 2);
+  std::array<double, N> positions;
+  MotorGroup<N>::position(m_rightMotors, positions);
+  return (reduceEncoders<N>(positions, m_reduction));
 }
 
-double FourMotorDrive::getLeftEncoderValueMotors()
-{
-  return ((leftFront.position(degrees) + leftBack.position(degrees)) / 2);
-}
-double Tracking::getAverageEncoderValueEncoders() 
+template <int N>
+double DifferentialDrive<N>::getLeftEncoderValueMotors()
 {
-  return ((this->leftEncoder.position(degrees) + this->rightEncoder.position(degrees)) / 2);
+  std::array<double, N> positions;
+  MotorGroup<N>::position(m_leftMotors, positions);
+  return (reduceEncoders<N>(positions, m_reduction));
 }
 
 
 /// NOT USED. PART OF PATH FINDING PROJECT
-void FourMotorDrive::driveArcFeedforward(const double radius, const double exitAngle) {
+template <int N>
+void DifferentialDrive<N>::driveArcFeedforward(const math3142a::Length radius, const math3142a::Angle exitAngle) {
+  math3142a::ControlCriticalSection critical("driveArcFeedforward");
 
-  double startTimeA = Brain.timer(timeUnits::sec);
+  const math3142a::Stopwatch profileClock;
 
-  const double distance = radius *exitAngle;
+  const double distance = radius.value() * exitAngle.inRadians();
 
-  double rRadius = radius + .15;
-  double lRadius = radius - .15;
-  double rDistance = rRadius * exitAngle;
-  double lDistance = lRadius * exitAngle;
+  double rRadius = radius.value() + .15;
+  double lRadius = radius.value() - .15;
+  double rDistance = rRadius * exitAngle.inRadians();
+  double lDistance = lRadius * exitAngle.inRadians();
 
   double ratio = lDistance/rDistance;
   TrapezoidalMotionProfile trap(getMaxLinearVelocity(),getMaxLinearAcceleration(), distance);
@@ -246,6 +324,8 @@ void FourMotorDrive::driveArcFeedforward(const double radius, const double exitA
 
     double lastLeft, lastRight;
 
+    const double trackCurvature = m_constants.trackWidth() / radius.value(); // same every tick
+
   while(t <= trap.getMpTotalTime()) {
 
     double currLeftMoved = this->convertTicksToMeters(this->getLeftEncoderValueMotors()) - initialMetersLeft;
@@ -255,16 +335,16 @@ void FourMotorDrive::driveArcFeedforward(const double radius, const double exitA
   
     drift = currLeftMoved - currRightMoved;
 
-    currentTime = Brain.timer(timeUnits::sec) - startTimeA;
+    currentTime = profileClock.elapsedSeconds();
 
     mpVel = trap.calculateMpVelocity(currentTime);
       
     mpAcc = trap.calculateMpAcceleration(currentTime);
 
 
-    double rAdjust = mpVel * (2 - this->m_chassisDimensions.m_trackWidth * (1/radius)) / 2;
+    double rAdjust = mpVel * (2 - trackCurvature) / 2;
 
-    double lAdjust = mpVel * (2 + this->m_chassisDimensions.m_trackWidth * (1/radius)) / 2;
+    double lAdjust = mpVel * (2 + trackCurvature) / 2;
 
    // chassis.normalize(lAdjust, rAdjust);
 
@@ -272,16 +352,17 @@ void FourMotorDrive::driveArcFeedforward(const double radius, const double exitA
     double rightVel = (currRightMoved-lastRight)/.01;
     double leftVel = (currLeftMoved-lastLeft)/.01;
 
-    std::cout << lPose <<" " << this->convertTicksToMeters(this->getLeftEncoderValueMotors()) << " "
-    << rPose << " " << this->convertTicksToMeters(this->getRightEncoderValueMotors()) <<  " " << 
-    this->convertTicksToMeters(this->getAverageEncoderValueMotors()) << " " << (rPose+lPose)/2<< " "
-    << rAdjust << " " << lAdjust << std::endl;
+    LOG_DEBUG(CHASSIS, lPose, this->convertTicksToMeters(this->getLeftEncoderValueMotors()),
+    rPose, this->convertTicksToMeters(this->getRightEncoderValueMotors()),
+    this->convertTicksToMeters(this->getAverageEncoderValueMotors()), (rPose+lPose)/2,
+    rAdjust, lAdjust);
 
 
     auto rPower = rPush.calculatePower(rPose, currRightMoved);
     auto lPower = lPush.calculatePower(lPose, currLeftMoved);
 
     setDrive(lAdjust*lFeed.kV + lPower ,rAdjust*rFeed.kV+rPower);
+    recordDriveSignals(lAdjust*lFeed.kV + lPower, rAdjust*rFeed.kV+rPower);
     //setVelDrive(chassis.convertMetersToTicks(lAdjust), chassis.convertMetersToTicks(rAdjust));
     t = currentTime;
 
@@ -301,17 +382,18 @@ void FourMotorDrive::driveArcFeedforward(const double radius, const double exitA
 }
 
 /// DEPRECEATED. USED COMPLETE FEEDBACK FOR POINT TURNS
-void FourMotorDrive::turnToDegreeFeedforward(const double angle) {
+template <int N>
+void DifferentialDrive<N>::turnToDegreeFeedforward(const math3142a::Angle angle) {
+  math3142a::ControlCriticalSection critical("turnToDegreeFeedforward");
+
   const double initialEncodersLeft = this->getLeftEncoderValueMotors();
   const double initialEncodersRight = this->getRightEncoderValueMotors();
 
-  const double totalEncoderTicks = math3142a::toDegrees(angle)*m_chassisDimensions.ticksToDegrees;
+  const double totalEncoderTicks = angle.inDegrees()*m_constants.ticksToDegrees();
 
-  //TrapezoidalMotionProfile trap(getMaxAngularVelocity(),getMaxAngularAcceleration(),totalEncoderTicks);
+  TrapezoidalMotionProfile trap(getMaxAngularVelocity(),getMaxAngularAcceleration(),totalEncoderTicks);
 
-  std::unique_ptr<TrapezoidalMotionProfile> trap(new TrapezoidalMotionProfile(getMaxAngularVelocity(),getMaxAngularAcceleration(),totalEncoderTicks));
-
-  const double startTime = Brain.timer(timeUnits::sec); //"resetting" timer
+  const math3142a::Stopwatch profileClock; // the motion profile's time starts here
 
 
   double mpVel, mpAcc; //forward ref for motion profile velocity and acceleration
@@ -326,9 +408,9 @@ void FourMotorDrive::turnToDegreeFeedforward(const double angle) {
   // Our estamate for kV was 11V / maxVel as the inputted max velocity in the FourMotorDrive constructor was base on the robot travelling at 11V
   // the values for kA had to be tuned, but again it took consideriably less time than tuning PID
 
-  const Feedfoward rFeedforwardConstants(11/trap->getMpMaxVelocity(),.1);
+  const Feedfoward rFeedforwardConstants(11/trap.getMpMaxVelocity(),.1);
 
-  const Feedfoward lFeedforwardConstants(11/trap->getMpMaxVelocity(),.08);
+  const Feedfoward lFeedforwardConstants(11/trap.getMpMaxVelocity(),.08);
 
   posPID rFeedback(2, 0);
 
@@ -336,32 +418,33 @@ void FourMotorDrive::turnToDegreeFeedforward(const double angle) {
 
   double rPower, lPower;
 
-  while (currentTime <= trap->getMpTotalTime())
+  while (currentTime <= trap.getMpTotalTime())
     {
 
       double currLeftMoved = this->getLeftEncoderValueMotors() - initialEncodersLeft; // amount we have moved in left (in meters)
 
       double currRightMoved = this->getRightEncoderValueMotors() - initialEncodersRight; // amount we have moved in right (in meters)
 
-      currentTime = Brain.timer(timeUnits::sec) - startTime;
+      currentTime = profileClock.elapsedSeconds();
 
-      mpVel = trap->calculateMpVelocity(currentTime); //velocity of motion profile
+      mpVel = trap.calculateMpVelocity(currentTime); //velocity of motion profile
       
-      mpAcc = trap->calculateMpAcceleration(currentTime); //acceleration of motion profile
+      mpAcc = trap.calculateMpAcceleration(currentTime); //acceleration of motion profile
 
-      auto currentStatus = trap->getMpStatus(currentTime);
+      auto currentStatus = trap.getMpStatus(currentTime);
 
       rPower = rFeedback.calculatePower(rPose, currRightMoved);
 
       lPower = lFeedback.calculatePower(lPose, currLeftMoved);
       
-      LOG(currLeftMoved,currRightMoved,rPose,lPower,rPower);
+      LOG_DEBUG(CHASSIS, currLeftMoved,currRightMoved,rPose,lPower,rPower);
 
      double lVoltage =  -1* lFeedforwardConstants.kV * mpVel + lFeedforwardConstants.kA * mpAcc + lPower; //kV * velocity + kA* acceleration + kP*(pose-measuredPose)
      double rVoltage =  rFeedforwardConstants.kV * mpVel + rFeedforwardConstants.kA * mpAcc + rPower; //kV * velocity + kA* acceleration + kP*(pose-measuredPose)
      
      
      this->setDrive(lVoltage,rVoltage);
+     recordDriveSignals(lVoltage, rVoltage);
 
      rPose += mpVel * (currentTime - prevTime); //Way of apporoximating position on the profile: pose_t += velocity_t * dt
      lPose -= mpVel * (currentTime - prevTime); //Way of apporoximating position on the profile: pose_t += velocity_t * dt
@@ -377,3 +460,6 @@ void FourMotorDrive::turnToDegreeFeedforward(const double angle) {
   
 
 }
+
+// every drive size we build (a 6 motor drive adds DifferentialDrive<3> here and in chassisGlobals.cpp)
+template class DifferentialDrive<2>;
@@ -1,6 +1,5 @@
 #include "ChassisSystems/motionprofile.h"
 #include <cmath>
-#include <string>
 
 
 TrapezoidalMotionProfile::TrapezoidalMotionProfile(const double maxVel,
@@ -66,7 +65,7 @@ double TrapezoidalMotionProfile::calculateMpAcceleration(const double t) const {
   return 0;
 }
 
-std::string TrapezoidalMotionProfile::getMpStatus(const double t) const {
+const char *TrapezoidalMotionProfile::getMpStatus(const double t) const {
 
   if (t < m_accelTime) {
     return ("accelerating");
@@ -1,6 +1,10 @@
 #include "ChassisSystems/odometry.h"
 #include "ChassisSystems/chassisGlobals.h"
 #include "Util/mathAndConstants.h"
+#include "Util/fastMath.h"
+#include "Util/angle.h"
+#include "Telemetry/metrics.h"
+#include "Config/initStages.h"
 #include <cmath>
 
 
@@ -24,6 +28,26 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
 
+// odometry metrics (see Telemetry/metrics.h), METRICS_FULL until addOdomMetrics
+static telemetry3142a::metricID odomX = telemetry3142a::METRICS_FULL;
+static telemetry3142a::metricID odomY = telemetry3142a::METRICS_FULL;
+static telemetry3142a::metricID odomTheta = telemetry3142a::METRICS_FULL;
+static telemetry3142a::metricID odomUpdates = telemetry3142a::METRICS_FULL;
+
+void addOdomMetrics() {
+  odomX = telemetry3142a::addGauge("odom.x");
+  odomY = telemetry3142a::addGauge("odom.y");
+  odomTheta = telemetry3142a::addGauge("odom.theta");
+  odomUpdates = telemetry3142a::addCounter("odom.updates");
+}
+
+static void updateOdomMetrics() {
+  telemetry3142a::setGauge(odomX, positionArray[ODOM_X]);
+  telemetry3142a::setGauge(odomY, positionArray[ODOM_Y]);
+  telemetry3142a::setGauge(odomTheta, positionArray[ODOM_THETA]);
+  telemetry3142a::countMetric(odomUpdates);
+}
+
 /// WE WOULD LIKE TO THANK 5225A FOR SHARING AND EXPLAINING THEIR ODOM SYSTEM AND CODE
 int trackPosition()
 {
@@ -33,7 +57,7 @@ int trackPosition()
   position.backLst = 0;
   position.x = positionArray[ODOM_X];
   position.y = positionArray[ODOM_Y];
-  position.a = positionArray[ODOM_THETA] * (M_PI / 180);
+  position.a = math3142a::Angle::fromDegrees(positionArray[ODOM_THETA]);
   while (true)
   {
     int left = chassis.leftFront.position(degrees);
@@ -55,7 +79,7 @@ int trackPosition()
     {
       double r = deltaL / a; // The radius of the circle the robot travel's around with the right side of the robot
       i = a / 2.0;
-      double sinI = sin(i);
+      double sinI = math3142a::trigSin(i);
       h = ((r + L_DISTANCE_IN) * sinI) * 2.0;
 
       double r2 = deltaB / a; // The radius of the circle the robot travel's around with the back of the robot
@@ -68,9 +92,9 @@ int trackPosition()
 
       h2 = deltaB;
     }
-    double p = i + position.a; // The global ending angle of the robot
-    double cosP = cos(p);
-    double sinP = sin(p);
+    const math3142a::Rotation p(position.a + math3142a::Angle::fromRadians(i)); // The global ending angle of the robot
+    const double cosP = p.cos();
+    const double sinP = p.sin();
 
     // conversion from polar to cartesian
     position.y += h * sinP;
@@ -79,15 +103,12 @@ int trackPosition()
     position.y += h2 * cosP;
     position.x += h2 * -sinP;
 
-    position.a += a;
-    while (position.a > 2 * M_PI)
-      position.a -= 2 * M_PI;
-    while (position.a < -2 * M_PI)
-      position.a += 2 * M_PI;
+    position.a += math3142a::Angle::fromRadians(a);
     //cout << "hi" <<SPIN_TO_IN_LR <<endl;
     positionArray[ODOM_X] = position.x;
     positionArray[ODOM_Y] = position.y;
-    positionArray[ODOM_THETA] = position.a * (180 / M_PI);
+    positionArray[ODOM_THETA] = position.a.wrapped().inDegrees();
+    updateOdomMetrics();
     // std::cout << positionArray[ODOM_X] << "," << positionArray[ODOM_Y] << " " <<positionArray[ODOM_THETA] <<" " << a<<std::endl;
     //cout << positionArray[ODOM_X] << "," << positionArray[ODOM_Y] << " " <<positionArray[ODOM_THETA] <<" " << left<< " " <<right<<endl;
     //cout << positionArray[ODOM_X] << "," << positionArray[ODOM_Y] <<endl;;
@@ -100,14 +121,17 @@ int trackPosition()
 
 int trackPositionGyro()
 {
+  // the encoders have to be reset and the IMU calibrated before we count from them
+  boot3142a::waitForStages(boot3142a::MOTION_STAGES);
+
   sPos position;
   position.leftLst = 0;
   position.rightLst = 0;
   position.backLst = 0;
-  position.angleLst = 0;
+  position.angleLst = poseTracker.getHeading();
   position.x = positionArray[ODOM_X];
   position.y = positionArray[ODOM_Y];
-  position.a = (M_PI/180)*(positionArray[ODOM_THETA]);
+  position.a = math3142a::Angle::fromDegrees(positionArray[ODOM_THETA]);
   while (true)
   {
     int left = chassis.leftFront.position(degrees);
@@ -125,7 +149,8 @@ int trackPositionGyro()
     double h;                                                                   // The hypotenuse of the triangle formed by the middle of the robot on the starting position and ending position and the middle of the circle it travels around
     double i;                                                                   // Half on the angle that I've traveled
     double h2;                                                                  // The same as h but using the back instead of the side wheels
-    double a = (M_PI/180)*(poseTracker.getInertialHeading()) - position.angleLst; // The angle that I've traveled
+    const math3142a::Angle heading = poseTracker.getHeading();
+    double a = position.angleLst.shortestTo(heading).inRadians(); // The angle that I've traveled
     //if(a <(toRadians(.0001))) {
     //  a = 0;
     //}
@@ -133,7 +158,7 @@ int trackPositionGyro()
     {
       double r = L / a; // The radius of the circle the robot travel's around with the right side of the robot
       i = a / 2.0;
-      double sinI = sin(i);
+      double sinI = math3142a::trigSin(i);
       h = ((r + L_DISTANCE_IN) * sinI) * 2.0;
 
       double r2 = S / a; // The radius of the circle the robot travel's around with the back of the robot
@@ -146,9 +171,9 @@ int trackPositionGyro()
 
       h2 = S;
     }
-    double p = i + position.a; // The global ending angle of the robot
-    double cosP = cos(p);
-    double sinP = sin(p);
+    const math3142a::Rotation p(position.a + math3142a::Angle::fromRadians(i)); // The global ending angle of the robot
+    const double cosP = p.cos();
+    const double sinP = p.sin();
 
     // Update the global position
     /*if((h * sinP >-.0001 && h* sinP <.0001) && 
@@ -167,20 +192,17 @@ int trackPositionGyro()
     position.y += h2 * cosP;  // -sin(x) = sin(-x)
     position.x += h2 * -sinP; // cos(x) = cos(-x)
 
-    position.a += a;
-    while (position.a > 2 * M_PI)
-      position.a -= 2 * M_PI;
-    while (position.a < -2 * M_PI)
-      position.a += 2 * M_PI;
+    position.a += math3142a::Angle::fromRadians(a);
     //cout << "hi" <<SPIN_TO_IN_LR <<endl;
     positionArray[ODOM_X] = position.x;
     positionArray[ODOM_Y] = position.y;
-    positionArray[ODOM_THETA] = (180/M_PI)*(position.a);
+    positionArray[ODOM_THETA] = position.a.wrapped().inDegrees();
+    updateOdomMetrics();
     //std::cout << positionArray[ODOM_X] << "," << positionArray[ODOM_Y] << ", " <<positionArray[ODOM_THETA] <<" ," << h * sinP << ", " <<h2<<std::endl;
     //cout << positionArray[ODOM_X] << "," << positionArray[ODOM_Y] <<endl;;
     //cout << positionArray[ODOM_X] << "," << positionArray[ODOM_Y] << " " << positionArray[ODOM_THETA] << " " << leftFront.position(degrees)<< " " << rightFront.position(degrees)<< " "<<
     //    (leftFront.position(degrees)/rightFront.position(degrees)) <<endl;
-    position.angleLst = (M_PI/180)*(poseTracker.getInertialHeading());
+    position.angleLst = heading;
     task::sleep(20);
   }
   return 1;
@@ -195,8 +217,7 @@ void setOdomOrigin(double x, double y, double a)
 
 void printPosition()
 {
-  std::cout << positionArray[ODOM_X] << " "
-            << positionArray[ODOM_Y] << " " << positionArray[ODOM_THETA] << std::endl;
+  LOG(positionArray[ODOM_X], positionArray[ODOM_Y], positionArray[ODOM_THETA]);
 }
 
 
@@ -231,6 +252,6 @@ void computeDistanceAndAngleToPoint(const double x, const double y, pointVals *o
   out->length = sqrt((xDiff * xDiff) + (yDiff * yDiff));
 
   //Compute difference in angle
-  out->theta = ((atan2(yDiff, xDiff) * (180 / M_PI))) - positionArray[ODOM_THETA];
+  out->theta = ((math3142a::trigAtan2(yDiff, xDiff) * (180 / M_PI))) - positionArray[ODOM_THETA];
 }
 
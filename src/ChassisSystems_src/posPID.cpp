@@ -1,19 +1,47 @@
 #include "ChassisSystems/posPID.h"
 #include "Util/premacros.h"
-posPID::posPID() {}
+posPID::posPID() : m_kP(0), m_kD(0) { reset(); }
 
-posPID::posPID(double kP, double kD) : m_kP(kP), m_kD(kD) {}
+posPID::posPID(double kP, double kD) : m_kP(kP), m_kD(kD) { reset(); }
 
 void posPID::setPD(double kP, double kD) {
   m_kP = kP;
   m_kD = kD;
 }
 
+void posPID::requestPD(double kP, double kD) {
+  m_pendingGains.post(PDcontroller{kP, kD});
+}
+
+void posPID::applyPendingGains() {
+  PDcontroller gains;
+  if (m_pendingGains.take(gains))
+    setPD(gains.kP, gains.kD);
+}
+
+PDcontroller posPID::getRequestedPD() const {
+  PDcontroller gains;
+  if (!m_pendingGains.peek(gains))
+    gains = PDcontroller{m_kP, m_kD};
+  return (gains);
+}
+
+void posPID::reset() {
+  m_error = 0;
+  m_prevError = 0;
+  m_proportional = 0;
+  m_derivative = 0;
+  m_derivativeFilter.reset();
+  m_power = 0;
+}
+
 double posPID::calculatePower(double targetPos, double currentPos) {
 
+  applyPendingGains(); // gains only ever change here, between two ticks
+
   m_error = targetPos - currentPos;
 
-  m_derivative = m_error - m_prevError;
+  m_derivative = m_derivativeFilter.update(m_error - m_prevError);
 
 
   m_power = (m_error * m_kP) + (m_derivative * m_kD); // error*kP + deltaError*kD
@@ -0,0 +1,51 @@
+#include "Config/bootProfile.h"
+#include "Util/premacros.h"
+#include "Util/timestamp.h"
+#include "Util/vex.h"
+#include <atomic>
+
+namespace boot3142a {
+
+/**
+ * struct bootStep
+ * A named timestamp
+ */
+
+struct bootStep {
+  const char *name;
+  uint32_t time; // us since power on
+};
+
+static bootStep steps[MAX_BOOT_STEPS];
+static std::atomic<int> stepCount(0);
+
+void profileStep(const char *name) {
+  uint32_t now = math3142a::micros32();
+
+  int index = stepCount.fetch_add(1);
+  if (index >= MAX_BOOT_STEPS)
+    return;
+
+  steps[index].time = now;
+  steps[index].name = name;
+}
+
+void printBootProfile() {
+  int count = stepCount.load();
+  if (count > MAX_BOOT_STEPS)
+    count = MAX_BOOT_STEPS;
+
+  // steps from different tasks can land slightly out of order, so the delta is from the
+  // latest step before each one instead of the one printed above it
+  LOG_INFO(BOOT, "BOOT STEP", "AT (us)", "+ (us)");
+  for (int i = 0; i < count; i++) {
+    uint32_t previous = 0;
+    for (int j = 0; j < count; j++) {
+      if (steps[j].time <= steps[i].time && steps[j].time > previous && j != i)
+        previous = steps[j].time;
+    }
+    LOG_INFO(BOOT, steps[i].name, steps[i].time, steps[i].time - previous);
+  }
+}
+
+} // namespace boot3142a
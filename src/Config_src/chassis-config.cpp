@@ -4,33 +4,48 @@
 #include "Impl/api.h"
 #include "ChassisSystems/odometry.h"
 #include "Config/other-config.h"
+#include "Config/configStore.h"
+#include "Config/bootProfile.h"
+#include "Util/deferred.h"
+#include "Util/controllerDisplay.h"
 using namespace vex;
 
-/// Our FourMotorDrive implementation. Inspiried by OkapiLib (c) Ryan Benesautti WPI
-FourMotorDrive chassis = FourMotorDrive::FourMotorDriveBuilder{}
-                          .withMotors({PORT8, PORT7}, {PORT9, PORT10})
-                          .withGearSetting(ratio18_1)
-                          .withGearRatio(1.6666667)
-                          .withDimensions({12.0_in, 3.25_in, 26})
+// built by initChassisDevices() after initDevices(), not during static init (see Util/deferred.h)
+static math3142a::Deferred<FourMotorDrive> chassisStorage;
+static math3142a::Deferred<Tracking> poseTrackerStorage;
+
+FourMotorDrive &chassis = chassisStorage.object();
+Tracking &poseTracker = poseTrackerStorage.object();
+
+void initChassisDevices() {
+  /// Our FourMotorDrive implementation. Inspiried by OkapiLib (c) Ryan Benesautti WPI
+  /// built in place from the builder, the motors (and their gear cartridge) are the ones in the device registry
+  chassisStorage.construct(FourMotorDrive::FourMotorDriveBuilder{}
+                          .withMotors(devices.driveLeft, devices.driveRight)
+                          .withConstants(CHASSIS_CONSTANTS) //gear ratio and dimensions (see Config/chassis-config.h)
                           .withLinearLimits({1.2_mps, 1.9_mps2})
                           .withAngularLimits( {1.0_radps,3.0_radps2} )
                           .withPDGains( {
                                         {0, 0},  //Distance PD (deprecated thanks to feedforwards control)
                                         {0, 0},  //Angle PD (deprecated thanks to feedforwards control)
-                                        {25, 65} //Turn PD (used for inertial sensor based turns))
+                                        {28, 65} //Turn PD (used for inertial sensor based turns))
                                                 }) 
-                          .buildChassis();
-
-
-/**
- * This is the implementation of the poseTracker.
- * The only part that we use is the interial port. We don't use the quad encoders becuase since the encoders were very close together,
- * the turning resolution was bad so we resorted to using the integrated motor encoders in the motors
- */
-Tracking poseTracker({4, 4, 5}, //Tracking wheel distances (left, right, back)
- 2.75, //Tracking wheel radius
- {Tracking::G, Tracking::C, Tracking::A}, //Tracking wheel ports (left, right, back)
- PORT4); //Intertial Sensor port
+                          .withFeedforward({11, .08, .1})); //11V at max velocity, left kA, right kA
+  addChassisMetrics();
+  boot3142a::profileStep("chassis");
+
+  /**
+   * This is the implementation of the poseTracker.
+   * The only part that we use is the interial port. We don't use the quad encoders becuase since the encoders were very close together,
+   * the turning resolution was bad so we resorted to using the integrated motor encoders in the motors
+   */
+  poseTrackerStorage.construct(WheelDistances{4, 4, 5}, //Tracking wheel distances (left, right, back)
+   2.75, //Tracking wheel radius
+   devices.rightTracker, devices.testEncoder, //Tracking wheels, right and back (see Config/deviceRegistry.h)
+   devices.inert); //Intertial Sensor
+  addOdomMetrics();
+  boot3142a::profileStep("poseTracker");
+}
 
 
 //TEST CHASSIS CONFIG
@@ -56,19 +71,20 @@ Tracking poseTracker({4, 4, 5}, //Tracking wheel distances (left, right, back)
 
 ); */
 
-line intakeDetect = line(Brain.ThreeWirePort.G);
-encoder testEncoder = encoder(Brain.ThreeWirePort.A);
 
 
 // VEXcode generated functions
 // define variable for remote controller enable/disable
 bool RemoteControlCodeEnabled = true;
 
-/**
- * Used to initialize code/tasks/devices in the chassis
- */
-void initChassis(void)
-{
+int loadConfigStage() {
+  // limits, gains, thresholds and timeouts saved on the SD card win over the ones compiled in above
+  loadRobotConfig(chassis);
+  applyRobotConfig(chassis);
+  return 0;
+}
+
+int resetMotorsStage() {
   //right side of bot reversed and left is not
   chassis.setReverseSettings( {true, true} , {false, false} );
   // chassis.setReverseSettings({false, false}, {true, true});
@@ -77,18 +93,19 @@ void initChassis(void)
   chassis.resetRotation();
 
   setOdomOrigin(0, 0, 0);
+  return 0;
+}
 
+int calibrateImuStage() {
   poseTracker.inert.calibrate();
 
-  do {
-
-    BigBrother.Screen.print("Calibrating Inert");
-    task::sleep(200);
+  // the controller display task sends these when the link has time, we never wait on the controller
+  display3142a::postControllerLine(3, "Calibrating Inert");
 
-    BigBrother.Screen.clearLine(3);
+  do {
+    task::sleep(20);
   } while((poseTracker.inert.isCalibrating()) );
 
-  
-
-  BigBrother.Screen.print("DONE!");
-}
\ No newline at end of file
+  display3142a::postControllerLine(3, "DONE!");
+  return 0;
+}
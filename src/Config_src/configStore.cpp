@@ -0,0 +1,116 @@
+#include "Config/configStore.h"
+#include "Config/chassis-config.h"
+#include "Config/other-config.h"
+#include "NonChassisSystems/flywheel.h"
+#include "Util/premacros.h"
+#include "Util/timestamp.h"
+
+static const char *CONFIG_FILE = "config.bin";
+static const uint32_t CONFIG_MAGIC = 0x47464E43; // "CNFG"
+
+/**
+ * struct configFile
+ * Layout of the config file on the SD card, the struct is written as is
+ */
+
+struct configFile {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t size;     // sizeof(robotConfig), catches a layout change someone forgot to version
+  uint32_t checksum; // CRC-32 of config
+  robotConfig config;
+};
+
+static robotConfig loadedConfig;
+
+static uint32_t loadTime = 0;
+
+// bitwise CRC-32 (the zip one), the file is a couple hundred bytes so a table isnt worth the space
+static uint32_t crc32(const uint8_t *data, int length) {
+  uint32_t crc = 0xFFFFFFFF;
+  for (int i = 0; i < length; i++) {
+    crc ^= data[i];
+    for (int bit = 0; bit < 8; bit++)
+      crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+  }
+  return (~crc);
+}
+
+robotConfig &getRobotConfig() { return (loadedConfig); }
+
+robotConfig makeDefaultConfig(FourMotorDrive &drive) {
+  robotConfig config;
+
+  config.maxLinearVelocity = drive.getMaxLinearVelocity();
+  config.maxLinearAcceleration = drive.getMaxLinearAcceleration();
+  config.maxAngularVelocity = drive.getMaxAngularVelocity();
+  config.maxAngularAcceleration = drive.getMaxAngularAcceleration();
+
+  config.gains = getChassisGains(drive);
+
+  config.topLineThreshold = TOP_LINE_THRESHOLD;
+  config.topLineEmptyThreshold = TOP_LINE_EMPTY_THRESHOLD;
+  config.middleLineThreshold = MIDDLE_LINE_THRESHOLD;
+  config.bottomLineThreshold = BOTTOM_LINE_THRESHOLD;
+  config.outyLineThreshold = OUTY_LINE_THRESHOLD;
+  config.intakeStopLineThreshold = INTAKE_STOP_LINE_THRESHOLD;
+
+  config.scoreTimeout = Scorer::SCORE_TIMEOUT;
+  config.ejectTimeout = Scorer::EJECT_TIMEOUT;
+
+  return (config);
+}
+
+bool loadRobotConfig(FourMotorDrive &drive) {
+  math3142a::Stopwatch loadTimer;
+
+  loadedConfig = makeDefaultConfig(drive);
+
+  bool fromCard = false;
+
+  if (Brain.SDcard.isInserted()) {
+    configFile file;
+    int32_t read = Brain.SDcard.loadfile(CONFIG_FILE, (uint8_t *)&file, sizeof(file));
+
+    if (read != sizeof(file) || file.magic != CONFIG_MAGIC) {
+      LOG_INFO(CONFIG, "NO CONFIG ON SD CARD, USING DEFAULTS");
+    } else if (file.version != CONFIG_VERSION || file.size != sizeof(robotConfig)) {
+      LOG_ERROR(CONFIG, "CONFIG VERSION MISMATCH, USING DEFAULTS", file.version, CONFIG_VERSION);
+    } else if (file.checksum != crc32((const uint8_t *)&file.config, sizeof(robotConfig))) {
+      LOG_ERROR(CONFIG, "CONFIG CHECKSUM FAILED, USING DEFAULTS");
+    } else {
+      loadedConfig = file.config;
+      fromCard = true;
+    }
+  }
+
+  loadTime = (uint32_t)loadTimer.elapsedMicros();
+  LOG_INFO(CONFIG, "CONFIG LOADED (us)", loadTime, fromCard);
+  return (fromCard);
+}
+
+void applyRobotConfig(FourMotorDrive &drive) {
+  // only called before any motion runs, so the limits can be written directly
+  drive.m_chassisLinearLimits = Limits(loadedConfig.maxLinearVelocity, loadedConfig.maxLinearAcceleration);
+  drive.m_chassisAngularLimits = Limits(loadedConfig.maxAngularVelocity, loadedConfig.maxAngularAcceleration);
+
+  requestChassisGains(drive, loadedConfig.gains);
+}
+
+bool saveRobotConfig() {
+  if (!Brain.SDcard.isInserted())
+    return false;
+
+  configFile file;
+  file.magic = CONFIG_MAGIC;
+  file.version = CONFIG_VERSION;
+  file.size = sizeof(robotConfig);
+  file.config = loadedConfig;
+  file.checksum = crc32((const uint8_t *)&file.config, sizeof(robotConfig));
+
+  int32_t written = Brain.SDcard.savefile(CONFIG_FILE, (uint8_t *)&file, sizeof(file));
+  LOG_INFO(CONFIG, "SAVED CONFIG", written);
+  return (written == sizeof(file));
+}
+
+uint32_t getConfigLoadTime() { return (loadTime); }
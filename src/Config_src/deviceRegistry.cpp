@@ -0,0 +1,69 @@
+#include "Config/deviceRegistry.h"
+#include "Config/bootProfile.h"
+#include "Config/chassis-config.h"
+#include "Config/other-config.h"
+#include "NonChassisSystems/flywheel.h"
+#include "Util/deferred.h"
+#include "Util/premacros.h"
+
+// built by initDevices() at the top of main, not during static init (see Util/deferred.h)
+static math3142a::Deferred<deviceRegistry> registryStorage;
+
+deviceRegistry &devices = registryStorage.object();
+
+// the names the rest of the code uses, all of them point into the registry.
+// They live here so they are bound in the same file as the storage (no static init order between files)
+motor &Flywheel = registryStorage.object().flywheel;
+motor &IntakeL = registryStorage.object().intakeL;
+motor &IntakeR = registryStorage.object().intakeR;
+motor &Indexer = registryStorage.object().indexer;
+
+triport &Expander21 = registryStorage.object().expander;
+line &bottomLine = registryStorage.object().bottomLine;
+line &middleLine = registryStorage.object().middleLine;
+line &topLine = registryStorage.object().topLine;
+line &outyLine = registryStorage.object().outyLine;
+
+line &intakeDetect = registryStorage.object().intakeDetect;
+encoder &testEncoder = registryStorage.object().testEncoder;
+
+deviceRegistry::deviceRegistry()
+    // the drive's gear cartridge is only set here, the chassis takes these motors as they are
+    : driveLeft{{motor(PORT8, ratio18_1), motor(PORT7, ratio18_1)}},
+      driveRight{{motor(PORT9, ratio18_1), motor(PORT10, ratio18_1)}},
+
+      flywheel(PORT19, ratio6_1, true),
+      intakeL(PORT18, ratio6_1, false),
+      intakeR(PORT6, ratio6_1, true),
+      indexer(PORT5, ratio6_1, false),
+
+      // declared before the line sensors so it is built before them
+      expander(PORT21),
+      bottomLine(expander.F),
+      middleLine(expander.G),
+      topLine(expander.H),
+      outyLine(expander.E),
+
+      intakeDetect(Brain.ThreeWirePort.G),
+      testEncoder(Brain.ThreeWirePort.A),
+
+      // one device per port: G is the intake line sensor, so there is no left tracking wheel,
+      // and the back tracking wheel is testEncoder on A (see poseTracker)
+      rightTracker(Brain.ThreeWirePort.C),
+      inert(PORT4) {}
+
+void initDevices() {
+  registryStorage.construct();
+  Scorer::addFlywheelMetrics();
+  boot3142a::profileStep("devices");
+}
+
+void printDeviceReport() {
+  // Tracking used to carry its own brain (with its own screen, SD card and triports) and its own
+  // encoders, and the chassis was copied out of its builder. Now each device exists once.
+  // These are object sizes of this build's types (the stand-in's on the host), not a before and after
+  LOG_INFO(BOOT, "SIZEOF deviceRegistry (bytes)", sizeof(deviceRegistry));
+  LOG_INFO(BOOT, "SIZEOF FourMotorDrive (bytes)", sizeof(FourMotorDrive));
+  LOG_INFO(BOOT, "SIZEOF Tracking (bytes)", sizeof(Tracking));
+  LOG_INFO(BOOT, "SIZEOF brain, one per Tracking before the registry (bytes)", sizeof(brain));
+}
@@ -0,0 +1,118 @@
+#include "Config/initStages.h"
+#include "Config/chassis-config.h"
+#include "Config/bootProfile.h"
+#include "Config/deviceRegistry.h"
+#include "Util/allocTracker.h"
+#include "Util/premacros.h"
+#include "Util/timestamp.h"
+#include "Util/vex.h"
+#include <atomic>
+
+namespace boot3142a {
+
+/**
+ * struct stageInfo
+ * What a stage runs and which stages have to be ready before it can start
+ */
+
+struct stageInfo {
+  const char *name;
+  int (*run)();        // NULL if the stage finishes inside some other task (see markStageDone)
+  stageMask dependsOn;
+};
+
+// the IMU only needs power, so it starts right away with the config load and motor resets.
+// The selector draws its first frame from its own task (see selector3142a#makeDisplay)
+static const stageInfo stages[STAGE_COUNT] = {
+  {"CONFIG", loadConfigStage, 0},
+  {"MOTORS", resetMotorsStage, 0},
+  {"IMU", calibrateImuStage, 0},
+  {"SELECTOR", NULL, 0}
+};
+
+static std::atomic<uint32_t> readyStages(0);
+static std::atomic<uint32_t> runningStages(0);
+static std::atomic<bool> reported(false);
+
+static uint32_t startTime[STAGE_COUNT];
+static uint32_t doneTime[STAGE_COUNT];
+
+static int runStage(void *arg) {
+  initStage stage = (initStage)(intptr_t)arg;
+
+  waitForStages(stages[stage].dependsOn);
+
+  startTime[stage] = math3142a::millis();
+  stages[stage].run();
+  markStageDone(stage);
+  return 0;
+}
+
+void startInitStages() {
+  uint32_t now = math3142a::millis();
+
+  for (int i = 0; i < STAGE_COUNT; i++) {
+    startTime[i] = now;
+    startStage((initStage)i);
+  }
+}
+
+void startStage(initStage stage) {
+  if (stages[stage].run == NULL)
+    return;
+
+  if (runningStages.fetch_or(stageBit(stage)) & stageBit(stage))
+    return; // already running, it will mark itself ready when it is done
+
+  readyStages.fetch_and(~stageBit(stage));
+  task stageTask(runStage, (void *)(intptr_t)stage);
+}
+
+void markStageDone(initStage stage) {
+  doneTime[stage] = math3142a::millis();
+  profileStep(stages[stage].name);
+  runningStages.fetch_and(~stageBit(stage));
+
+  uint32_t ready = readyStages.fetch_or(stageBit(stage)) | stageBit(stage);
+
+  // report the first full boot only, not every recalibration after it
+  if (ready == ALL_STAGES && !reported.exchange(true))
+    printBootReport();
+}
+
+bool stagesReady(stageMask stages) {
+  return ((readyStages.load() & stages) == stages);
+}
+
+bool waitForStages(stageMask stages, uint32_t timeout) {
+  uint32_t start = math3142a::millis();
+
+  while (!stagesReady(stages)) {
+    if (timeout != 0 && math3142a::millis() - start > timeout)
+      return false;
+    task::sleep(10);
+  }
+  return true;
+}
+
+void printBootReport() {
+  uint32_t ready = 0;
+
+  printBootProfile();
+  printDeviceReport();
+  math3142a::printAllocationStats();
+
+  LOG_INFO(BOOT, "BOOT STAGE", "START", "DONE", "TOOK (ms)");
+  for (int i = 0; i < STAGE_COUNT; i++) {
+    if (!stagesReady(stageBit((initStage)i))) {
+      LOG_INFO(BOOT, stages[i].name, startTime[i], "NOT READY");
+      continue;
+    }
+    LOG_INFO(BOOT, stages[i].name, startTime[i], doneTime[i], doneTime[i] - startTime[i]);
+    if (doneTime[i] > ready)
+      ready = doneTime[i];
+  }
+  LOG_INFO(BOOT, "READY AT (ms)", ready);
+}
+
+} // namespace boot3142a
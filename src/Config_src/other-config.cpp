@@ -10,14 +10,4 @@ brain Brain;
 
 controller BigBrother = controller(primary);
 
-motor Flywheel = motor(PORT19, ratio6_1, true);
-motor IntakeL = motor(PORT18, ratio6_1, false);
-motor IntakeR = motor(PORT6, ratio6_1, true);
-motor Indexer = motor(PORT5, ratio6_1, false);
-
-
-triport Expander21 = triport(PORT21);
-line bottomLine = line(Expander21.F);
-line middleLine = line(Expander21.G);
-line topLine = line(Expander21.H);
-line outyLine = line(Expander21.E);
+// every other device is owned by the device registry (see Config/deviceRegistry.h)
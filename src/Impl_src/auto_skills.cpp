@@ -1,12 +1,25 @@
 #include "Impl/auto_skills.h"
 #include "Impl/api.h"
+#include "Util/allocTracker.h"
 
 
 bool atGoal = false;
 
 void runAutoSkills() {
 
+  runAutoSkillsRoute();
+
+  while(true) {
+    task::sleep(100);
+  }
+}
+
+void runAutoSkillsRoute() {
+
   LOG("Running Auto Skills!");
+
+  // config, motors and the IMU have to be ready before we move (the selector doesn't matter)
+  boot3142a::waitForStages(boot3142a::MOTION_STAGES);
   
   task intakes(Intakes::intakeTask );
 
@@ -14,6 +27,9 @@ void runAutoSkills() {
   
   task fly(Scorer::flywheelTask);
 
+  // static, a snapshot is too big for the stack. Compared against the one at the end of the run
+  static telemetry3142a::metricsSnapshot runStart;
+  telemetry3142a::takeSnapshot(runStart);
 
 
   chassis.driveStraightFeedforward(8.0_in);
@@ -56,14 +72,12 @@ void runAutoSkills() {
   Intakes::backUp = false;
   Intakes::IntakesStop = true;
 
-
-
-
-  while(true) {
-    task::sleep(100);
-  }
-
-
+  static telemetry3142a::metricsSnapshot runEnd;
+  telemetry3142a::takeSnapshot(runEnd);
+  telemetry3142a::printSnapshotDiff(runStart, runEnd);
+  math3142a::printAllocationStats(); // anything the motions allocated shows up as control allocations
+  if (!telemetry3142a::saveSnapshot(runEnd))
+    LOG_ERROR(GENERAL, "COULD NOT SAVE METRICS");
 }
 
 
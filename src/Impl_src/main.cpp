@@ -16,20 +16,35 @@ using namespace vex;
 
 void pre_auto(void) {
 
-  initChassis(); //initalizing chassis (see Config_src/chassis-config.cpp)
+  // owns the controller screen, everything else just posts lines to it (see Util/controllerDisplay.h)
+  task controllerScreen( display3142a::controllerDisplayTask, task::taskPriorityLow );
+
+  // writes the log buffer to the serial port, so logging never waits on it (see Util/premacros.h)
+  task logWriter( log3142a::logTask, task::taskPriorityLow );
+
+  // writes the binary telemetry records out in batches (see Telemetry/recordLog.h)
+  task recordWriter( telemetry3142a::recordDrainTask, task::taskPriorityLow );
+
+  // config load, motor resets and IMU calibration all run in parallel (see Config/initStages.h)
+  // autonomous waits on the stages it needs, so we don't block here
+  boot3142a::startInitStages();
 
   Brain.Screen.pressed( selector3142a::userTouchCallbackPressed ); // set up callback for brain screen press
   Brain.Screen.released( selector3142a::userTouchCallbackReleased ); // set up callback for brain screen release
 
-  // make background
-  selector3142a::makeBackground();
-
-  // auton selector task
-  task autonSelect( selector3142a::makeDisplay );
+  // auton selector task (draws the background on its first frame)
+  // low priority so drawing never holds up the control loops
+  task autonSelect( selector3142a::makeDisplay, task::taskPriorityLow );
 
 }
 
 int main() {
+  // everything before this was static init (and the vex runtime starting up)
+  boot3142a::profileStep("main");
+
+  // build the devices ourselves, in order, instead of leaving it to static init
+  initDevices(); //every motor and sensor (see Config/deviceRegistry.h)
+  initChassisDevices(); //chassis and pose tracker (see Config_src/chassis-config.cpp)
 
   pre_auto();
 
@@ -1,7 +1,12 @@
 #include "NonChassisSystems/flywheel.h"
 #include "Config/other-config.h"
+#include "Config/configStore.h"
 #include "NonChassisSystems/indexer.h"
 #include "NonChassisSystems/intakes.h"
+#include "Telemetry/telemetry.h"
+#include "Telemetry/recordLog.h"
+#include "Telemetry/capture.h"
+#include "Telemetry/metrics.h"
 #include <mutex>
 
 namespace Scorer {
@@ -11,6 +16,16 @@ namespace Scorer {
 static mutex scoreLock;
 static mutex outyLock;
 
+// flywheel metrics (see Telemetry/metrics.h), METRICS_FULL until addFlywheelMetrics
+static telemetry3142a::metricID scoredCount = telemetry3142a::METRICS_FULL;
+static telemetry3142a::metricID ejectedCount = telemetry3142a::METRICS_FULL;
+static telemetry3142a::metricID jamCount = telemetry3142a::METRICS_FULL;
+
+void addFlywheelMetrics() {
+  scoredCount = telemetry3142a::addCounter("flywheel.scored");
+  ejectedCount = telemetry3142a::addCounter("flywheel.ejected");
+  jamCount = telemetry3142a::addCounter("flywheel.jams");
+}
 
 bool FlywheelStopWhenTopDetected = false;
 
@@ -21,43 +36,70 @@ int flywheelTask() {
 
   bool ballEjected = false;
 
+  bool ballAtTop = false; // the top line saw a ball while scoring, it has scored once the line is empty again
+
   // We dont want to stop the flywheel as soon as a ball exits because we stil need momentum. Therefore, we have timers that activate once the ball leaves
 
-  math3142a::TimeoutTimer scoreTimeout(10,1250);
+  math3142a::TimeoutTimer scoreTimeout(10, getRobotConfig().scoreTimeout);
+
+  math3142a::TimeoutTimer ejectorTimeout(10, getRobotConfig().ejectTimeout);
 
-  math3142a::TimeoutTimer ejectorTimeout(10,1000);
+  int stalledTicks = 0; // ticks in a row the flywheel has been powered but not turning
 
 
   while (true) {
 
+      telemetry3142a::record(telemetry3142a::FLYWHEEL_RPM, Flywheel.velocity(rpm));
+      telemetry3142a::logRecord(telemetry3142a::FLYWHEEL_RECORD, Flywheel.velocity(rpm), topLine.value(analogUnits::range10bit),
+                                outyLine.value(analogUnits::range10bit), Flywheel.voltage());
+
+      telemetry3142a::captureSample(telemetry3142a::FLYWHEEL_CAPTURE, Flywheel.velocity(rpm), Flywheel.voltage(),
+                                    topLine.value(analogUnits::range10bit), outyLine.value(analogUnits::range10bit));
+      if (std::abs(Flywheel.voltage()) > 6 && std::abs(Flywheel.velocity(rpm)) < telemetry3142a::FLYWHEEL_JAM_RPM)
+        stalledTicks++;
+      else
+        stalledTicks = 0;
+      if (stalledTicks == telemetry3142a::FLYWHEEL_JAM_TICKS) {
+        telemetry3142a::captureTrigger(telemetry3142a::FLYWHEEL_CAPTURE, telemetry3142a::JAM_TRIGGER, Flywheel.velocity(rpm));
+        telemetry3142a::countMetric(jamCount);
+      }
 
       if (FlywheelStopWhenTopDetected) {
          // index the ball up to the top line sensor
-        LOG("FLYWHEEL INDEXING TO TOP LINE", topLine.value(analogUnits::range10bit), TOP_LINE_THRESHOLD);
-        if (topLine.value(analogUnits::range10bit) < TOP_LINE_THRESHOLD) {
-          LOG("BALL AT TOP"); // if the line sensor detects stop the flywheel
+        LOG_DEBUG(FLYWHEEL, "FLYWHEEL INDEXING TO TOP LINE", topLine.value(analogUnits::range10bit), getRobotConfig().topLineThreshold);
+        if (topLine.value(analogUnits::range10bit) < getRobotConfig().topLineThreshold) {
+          LOG_DEBUG(FLYWHEEL, "BALL AT TOP"); // if the line sensor detects stop the flywheel
           Flywheel.spin(fwd, FLYWHEEL_STOP_VOLTAGE, volt);
         } else { // if it hasnt detected then run them
           Flywheel.spin(fwd, 9, volt);
         }
       }
       if (atGoal) {
-        LOG("AT GOAL");
+        LOG_DEBUG(FLYWHEEL, "AT GOAL");
 
         FlywheelStopWhenTopDetected = false; //turn off the top line macro. these two are mutually exclusive
 
         if (!Scored) { // run while we havent scored a ball
           Flywheel.spin(fwd, SCORE_VOLTAGE, volt);
-          LOG("SCORING",topLine.value(analogUnits::range10bit), TOP_LINE_EMPTY_THRESHOLD);
-          if (topLine.value(analogUnits::range10bit) > TOP_LINE_EMPTY_THRESHOLD) { //if the top line is empty then we can start the timeout to stop intake
+          LOG_DEBUG(FLYWHEEL, "SCORING",topLine.value(analogUnits::range10bit), getRobotConfig().topLineEmptyThreshold);
+
+          // every ball that goes past the top line counts, however many the goal takes before the timeout
+          if (topLine.value(analogUnits::range10bit) < getRobotConfig().topLineThreshold) {
+            ballAtTop = true;
+          } else if (ballAtTop && topLine.value(analogUnits::range10bit) > getRobotConfig().topLineEmptyThreshold) {
+            ballAtTop = false;
+            telemetry3142a::countMetric(scoredCount);
+          }
+          if (topLine.value(analogUnits::range10bit) > getRobotConfig().topLineEmptyThreshold) { //if the top line is empty then we can start the timeout to stop intake
 
             scoreTimeout.m_currentTime += scoreTimeout.m_delay; //10 because it is the delay time
-            LOG("SCORED");
+            LOG_DEBUG(FLYWHEEL, "SCORED");
             scoreLock.lock(); //lock the mutex as we are accessing the "scored" bool that is used in mutiple threads
 
             if (scoreTimeout.m_currentTime > scoreTimeout.m_timeout) { //once we have delayed for long enough, we have scored
-              LOG("DONE SCORING"); 
+              LOG_DEBUG(FLYWHEEL, "DONE SCORING"); 
               Scored = true;
+              ballAtTop = false;
             }
             scoreLock.unlock(); //unlock mutex
           }
@@ -66,24 +108,25 @@ int flywheelTask() {
 
         else { // if we have scored (eject code)
 
-          LOG("EJECTING",outyLine.value(analogUnits::range10bit),OUTY_LINE_THRESHOLD);
+          LOG_DEBUG(FLYWHEEL, "EJECTING",outyLine.value(analogUnits::range10bit),getRobotConfig().outyLineThreshold);
           Flywheel.spin(fwd, FLYWHEEL_OUTY_VOLTAGE, volt); //spin flywheel to reverse
 
-          if (outyLine.value(analogUnits::range10bit) < OUTY_LINE_THRESHOLD) {
+          if (outyLine.value(analogUnits::range10bit) < getRobotConfig().outyLineThreshold) {
              //very similar "timeout" procedure as the scoring macro
-            LOG("EJECTED BALL DETECTED");
+            LOG_DEBUG(FLYWHEEL, "EJECTED BALL DETECTED");
             ballEjected = true;
           }
 
           if (ballEjected) {
-            LOG("BALL EJECTED",ejectorTimeout.m_currentTime , ejectorTimeout.m_timeout);
+            LOG_DEBUG(FLYWHEEL, "BALL EJECTED",ejectorTimeout.m_currentTime , ejectorTimeout.m_timeout);
 
             ejectorTimeout.m_currentTime += ejectorTimeout.m_delay; //increment timer by a delay
 
             outyLock.lock();
 
             if (ejectorTimeout.m_currentTime > ejectorTimeout.m_timeout) { // if we have elasped enough time since first ejected ball detection, we have outied
-              LOG("DONE EJECTING and FINSIHED GOAL TASK");
+              LOG_DEBUG(FLYWHEEL, "DONE EJECTING and FINSIHED GOAL TASK");
+              telemetry3142a::countMetric(ejectedCount);
               atGoal = false;
               Flywheel.spin(fwd,FLYWHEEL_STOP_VOLTAGE,volt);
               Intakes::backUp = true; //reverse intakes for a smooth exit
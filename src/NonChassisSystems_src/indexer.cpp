@@ -1,5 +1,7 @@
 #include "NonChassisSystems/indexer.h"
+#include "Config/configStore.h"
 #include "NonChassisSystems/flywheel.h"
+#include "Telemetry/recordLog.h"
 #include <iostream>
 
 namespace Rollers {
@@ -18,8 +20,8 @@ int indexerTask() {
       
 
 
-      if (topLine.value(analogUnits::range10bit) < TOP_LINE_THRESHOLD) {
-        LOG(" Top Ball detected");
+      if (topLine.value(analogUnits::range10bit) < getRobotConfig().topLineThreshold) {
+        LOG_DEBUG(INDEXER, " Top Ball detected");
         Indexer.spin(fwd, INDEXER_STOP_VOLTAGE, volt); //stop when detected
       } else { //run Indexer as long as we ghaven't detected anything
         Indexer.spin(fwd, INDEXER_VOLTAGE, volt);
@@ -28,9 +30,9 @@ int indexerTask() {
 
     if (IndexerStopWhenMiddleDetected) {// similar to StopWhenTopDetected but for the middle line sensor
     IndexerStop = false;
-      LOG("INDEXING TO MIDDLE SENSOR");
-      if (middleLine.value(analogUnits::range10bit) < MIDDLE_LINE_THRESHOLD) {
-        LOG(" Middle Ball detected");
+      LOG_DEBUG(INDEXER, "INDEXING TO MIDDLE SENSOR");
+      if (middleLine.value(analogUnits::range10bit) < getRobotConfig().middleLineThreshold) {
+        LOG_DEBUG(INDEXER, " Middle Ball detected");
         Indexer.spin(fwd, INDEXER_STOP_VOLTAGE, volt);
       } else {
         Indexer.spin(fwd, 12, volt);
@@ -43,7 +45,7 @@ int indexerTask() {
       Indexer.spin(fwd, INDEXER_VOLTAGE, volt);
     }
     if (IndexerStop) { //stop indexer
-      LOG("STOPPING INDEXER");
+      LOG_DEBUG(INDEXER, "STOPPING INDEXER");
 
 
       Indexer.spin(fwd, INDEXER_STOP_VOLTAGE, volt);
@@ -64,6 +66,9 @@ int indexerTask() {
       }
     }
 
+    telemetry3142a::logRecord(telemetry3142a::INDEXER_RECORD, topLine.value(analogUnits::range10bit),
+                              middleLine.value(analogUnits::range10bit), Indexer.voltage());
+
     task::sleep(10);
   }
 }
@@ -1,4 +1,5 @@
 #include "NonChassisSystems/intakes.h"
+#include "Config/configStore.h"
 #include "Util/premacros.h"
 #include "Util/vex.h"
 
@@ -30,7 +31,7 @@ int intakeTask() {
         IntakeL.spin(fwd, INTAKE_INDEX_BALL_VOLTAGE, volt);
         IntakeR.spin(fwd, INTAKE_INDEX_BALL_VOLTAGE, volt);
 
-        if (intakeDetect.value(analogUnits::range10bit) < INTAKE_STOP_LINE_THRESHOLD) { //once the line sensor detects a ball, we can set our ballIn value to true: stopping the intakes
+        if (intakeDetect.value(analogUnits::range10bit) < getRobotConfig().intakeStopLineThreshold) { //once the line sensor detects a ball, we can set our ballIn value to true: stopping the intakes
           ballIn = true;
         }
 
@@ -45,7 +46,7 @@ int intakeTask() {
 
      if (backUp) { //reverse the intakes as we back up
 
-      LOG("BACKING UP");
+      LOG_DEBUG(INTAKES, "BACKING UP");
       ballIn = false; //roundabout way of "resetting" the bool as we backUp right after atGoal becomes false. ( we always back up after at a goal)
 
       IntakeL.spin(fwd, INTAKE_BACK_UP_VOLTAGE, volt);
@@ -55,7 +56,7 @@ int intakeTask() {
 
      if (IntakesRunContinously) { //run intakes at max voltage
 
-     LOG("INTAKES AT FULL SPEED");
+     LOG_DEBUG(INTAKES, "INTAKES AT FULL SPEED");
 
       IntakeL.spin(fwd, INTAKE_VOLTAGE, volt);
       IntakeR.spin(fwd, INTAKE_VOLTAGE, volt);
@@ -63,7 +64,7 @@ int intakeTask() {
 
     if (IntakesStop) { //run intakes at min voltage
 
-      LOG("INTAKES STOPPED");
+      LOG_DEBUG(INTAKES, "INTAKES STOPPED");
 
       IntakeL.spin(fwd, INTAKE_STOP_VOLTAGE, volt);
       IntakeR.spin(fwd, INTAKE_STOP_VOLTAGE, volt);
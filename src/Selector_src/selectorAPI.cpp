@@ -1,5 +1,7 @@
 #include "Selector/selectorAPI.h"
 #include "Selector/selectorImpl.h"
+#include <algorithm>
+#include <stdarg.h>
 
 /* ***************************************************************************************************** */
 
@@ -13,8 +15,7 @@
 
 ButtonGroupMaker::ButtonGroupMaker(std::initializer_list<button> butonList) {
 
-  this->buttonList.reserve(butonList.size()); // we need to convert initializer list to vector so we can index
-
+  // we need to convert initializer list to a list so we can index. Anything past MAX_GROUP_BUTTONS is dropped
   for (auto &aButton : butonList)  {
     buttonList.push_back(button
     { 
@@ -29,6 +30,7 @@ ButtonGroupMaker::ButtonGroupMaker(std::initializer_list<button> butonList) {
     }
     );
   }
+  m_drawnMask = 0; // nothing has been drawn yet
 }
 
 int ButtonGroupMaker::findButton(int16_t xpos, int16_t ypos) {
@@ -65,70 +67,174 @@ void ButtonGroupMaker::switchStates(int index) {
     
 }
 
-int ButtonGroupMaker::displayButtonControls(int index, bool pressed, bool permanant) {
-  vex::color c;
+void ButtonGroupMaker::drawButton(int index) {
+  button *pButton = &buttonList[ index ];
+  vex::color c = pButton->state ? pButton->onColor : pButton->offColor;
+
+  // button fill
   Brain.Screen.setPenColor( vex::color(0xe0e0e0) );
+  Brain.Screen.setFillColor( c );
+  Brain.Screen.drawRectangle( pButton->xpos, pButton->ypos, pButton->width, pButton->height, c );
+
+  // outline
+  Brain.Screen.drawRectangle( pButton->xpos, pButton->ypos, pButton->width, pButton->height, vex::color::transparent );
+
+  if( pButton->label != NULL )
+    Brain.Screen.printAt( pButton->xpos + 8, pButton->ypos + pButton->height - 8, pButton->label );
+}
+
+void ButtonGroupMaker::invalidate() {
+  m_drawnMask = 0;
+}
 
-  for(int i=0;i<this->buttonList.size();i++) {
-    if( this->buttonList[i].state )
-      c = this->buttonList[i].onColor;
-    else
-      c = this->buttonList[i].offColor;
+int ButtonGroupMaker::render() {
+  int nButtons = this->buttonList.size();
+  int redrawn = 0;
 
-    Brain.Screen.setFillColor( c );
+  if( m_drawnList.size() != buttonList.size() ) { // first render, nothing of ours is on the screen yet
+    m_drawnList = buttonList;
+    m_drawnMask = 0;
+  }
 
-      // button fill
-    if( i == index && pressed == true ) 
-      Brain.Screen.drawRectangle( this->buttonList[i].xpos, this->buttonList[i].ypos, this->buttonList[i].width, this->buttonList[i].height,c);
-    else
-      Brain.Screen.drawRectangle( this->buttonList[i].xpos, this->buttonList[i].ypos, this->buttonList[i].width, this->buttonList[i].height );
+  for( int index=0;index < nButtons;index++) {
+    const button &current = buttonList[ index ];
+    const button &drawn = m_drawnList[ index ];
 
-      // outline
-    Brain.Screen.drawRectangle( this->buttonList[i].xpos, this->buttonList[i].ypos, this->buttonList[i].width, this->buttonList[i].height, vex::color::transparent );
+    // colors and positions never change at runtime, so state and label are all we have to compare
+    bool valid = ( m_drawnMask & (1u << index) ) && current.state == drawn.state && current.label == drawn.label;
+    if( valid )
+      continue;
 
-    if(  this->buttonList[i].label != NULL )
-      Brain.Screen.printAt( this->buttonList[i].xpos + 8, this->buttonList[i].ypos + this->buttonList[i].height - 8, this->buttonList[i].label );
-  
+    drawButton(index);
+    m_drawnList[ index ] = current;
+    m_drawnMask |= (1u << index);
+    redrawn++;
   }
-    return 1; 
+  return redrawn;
+}
+
+TextField::TextField(int xpos, int ypos, int width, vex::color background)
+    : m_xpos(xpos), m_ypos(ypos), m_width(width), m_background(background), m_valid(false) {
+  m_text[0] = '\0';
+  m_drawn[0] = '\0';
+}
 
+void TextField::setText(const char *format, ...) {
+  va_list args;
+  va_start(args, format);
+  vsnprintf(m_text, sizeof(m_text), format, args);
+  va_end(args);
+}
 
+void TextField::invalidate() {
+  m_valid = false;
 }
 
+int TextField::render() {
+  if( m_valid && strcmp(m_text, m_drawn) == 0 )
+    return 0;
+
+  // paint over the old text, then print the new one
+  Brain.Screen.setPenColor( m_background );
+  Brain.Screen.setFillColor( m_background );
+  Brain.Screen.drawRectangle( m_xpos, m_ypos - 18, m_width, 22 );
 
-int ButtonGroupMaker::displayButtonControls(int index, bool pressed) {
-  Brain.Screen.clearScreen();
-  selector3142a::makeBackground();
-  vex::color c;
   Brain.Screen.setPenColor( vex::color(0xe0e0e0) );
-  selector3142a::tabButtons.displayButtonControls(0, false , true);
-  selector3142a::confirmButton.displayButtonControls(0,false ,true);
+  Brain.Screen.printAt( m_xpos, m_ypos, "%s", m_text );
 
+  strcpy(m_drawn, m_text);
+  m_valid = true;
+  return 1;
+}
 
-  // NEW STUFF
-  for(int i=0;i<this->buttonList.size();i++) {
+GraphField::GraphField(int xpos, int ypos, int width, int height)
+    : m_xpos(xpos), m_ypos(ypos), m_width(width), m_height(height),
+      m_lastDrawTime(0), m_valid(false) {
+  m_signals[0] = telemetry3142a::PROFILE_POSITION;
+  m_signals[1] = telemetry3142a::SIGNAL_COUNT;
+  m_drawnWritten[0] = m_drawnWritten[1] = 0;
+}
 
-    if( this->buttonList[i].state )
-      c = this->buttonList[i].onColor;
-    else
-      c = this->buttonList[i].offColor;
+void GraphField::setSignals(telemetry3142a::signalID first, telemetry3142a::signalID second) {
+  if( first == m_signals[0] && second == m_signals[1] )
+    return;
 
-    Brain.Screen.setFillColor( c );
+  m_signals[0] = first;
+  m_signals[1] = second;
+  m_valid = false;
+}
+
+void GraphField::invalidate() {
+  m_valid = false;
+}
 
-      // button fill
-    if( i == index && pressed == true ) 
-      Brain.Screen.drawRectangle( this->buttonList[i].xpos, this->buttonList[i].ypos, this->buttonList[i].width, this->buttonList[i].height,c);
-    else
-      Brain.Screen.drawRectangle( this->buttonList[i].xpos, this->buttonList[i].ypos, this->buttonList[i].width, this->buttonList[i].height );
+void GraphField::plot(const float *samples, int count, float minValue, float maxValue) {
+  float scale = (m_height - 1) / (maxValue - minValue);
+  int bottom = m_ypos + m_height - 1;
 
-      // outline
-    Brain.Screen.drawRectangle( this->buttonList[i].xpos, this->buttonList[i].ypos, this->buttonList[i].width, this->buttonList[i].height, vex::color::transparent );
+  // newest sample is on the right edge, older ones scroll off to the left
+  int x = m_xpos + m_width - 1 - (count - 1) * PIXELS_PER_SAMPLE;
+  int lastY = bottom - (int)((samples[0] - minValue) * scale);
 
-    if(  this->buttonList[i].label != NULL )
-      Brain.Screen.printAt( this->buttonList[i].xpos + 8, this->buttonList[i].ypos + this->buttonList[i].height - 8, this->buttonList[i].label );
-  
+  for( int i = 1; i < count; i++ ) {
+    int y = bottom - (int)((samples[i] - minValue) * scale);
+    Brain.Screen.drawLine( x, lastY, x + PIXELS_PER_SAMPLE, y );
+    x += PIXELS_PER_SAMPLE;
+    lastY = y;
   }
-    return 1; 
 }
 
+int GraphField::render(uint32_t timeMs) {
+  int nSignals = m_signals[1] == telemetry3142a::SIGNAL_COUNT ? 1 : 2;
+
+  bool newSamples = false;
+  for( int i = 0; i < nSignals; i++ ) {
+    if( telemetry3142a::getSignal(m_signals[i]).getWritten() != m_drawnWritten[i] )
+      newSamples = true;
+  }
+
+  if( m_valid && ( !newSamples || timeMs - m_lastDrawTime < REFRESH_MS ) )
+    return 0;
+
+  // copy everything out first so both lines use the same scale
+  static float samples[2][MAX_POINTS];
+  int counts[2] = {0, 0};
+  int wanted = std::min(m_width / PIXELS_PER_SAMPLE, (int)MAX_POINTS);
+  float minValue = 0, maxValue = 0;
+
+  for( int i = 0; i < nSignals; i++ ) {
+    const telemetry3142a::SignalRing &ring = telemetry3142a::getSignal(m_signals[i]);
+    m_drawnWritten[i] = ring.getWritten();
+    counts[i] = ring.copyLatest(samples[i], wanted);
 
+    for( int j = 0; j < counts[i]; j++ ) {
+      minValue = std::min(minValue, samples[i][j]);
+      maxValue = std::max(maxValue, samples[i][j]);
+    }
+  }
+  if( maxValue - minValue < 1e-3f ) // flat (or empty) signal, keep the scale sane
+    maxValue = minValue + 1;
+
+  Brain.Screen.setPenColor( vex::color(0x202020) );
+  Brain.Screen.setFillColor( vex::color(0x202020) );
+  Brain.Screen.drawRectangle( m_xpos, m_ypos, m_width, m_height );
+
+  const vex::color lineColors[2] = { vex::color(0x00E0E0), vex::color(0xE0E000) };
+  for( int i = 0; i < nSignals; i++ ) {
+    Brain.Screen.setPenColor( lineColors[i] );
+    if( counts[i] > 1 )
+      plot(samples[i], counts[i], minValue, maxValue);
+
+    // name and newest value of each signal in the top corner
+    Brain.Screen.printAt( m_xpos + 4, m_ypos + 16 + 20 * i, "%s %.2f", telemetry3142a::getSignalName(m_signals[i]),
+                          counts[i] > 0 ? samples[i][counts[i] - 1] : 0.0f );
+  }
+
+  Brain.Screen.setPenColor( vex::color(0xe0e0e0) );
+  Brain.Screen.printAt( m_xpos + m_width - 70, m_ypos + 16, "%.1f", maxValue );
+  Brain.Screen.printAt( m_xpos + m_width - 70, m_ypos + m_height - 4, "%.1f", minValue );
+
+  m_lastDrawTime = timeMs;
+  m_valid = true;
+  return 1;
+}
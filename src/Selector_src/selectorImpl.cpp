@@ -1,5 +1,12 @@
 #include "Selector/selectorImpl.h"
 #include "Selector/selectorAPI.h"
+#include "Selector/selectorInput.h"
+#include "ChassisSystems/chassisTuning.h"
+#include "Config/initStages.h"
+#include "Config/bootProfile.h"
+#include "Util/deferred.h"
+#include "Util/timestamp.h"
+#include "Telemetry/metrics.h"
 
 
 namespace selector3142a {
@@ -17,88 +24,191 @@ namespace selector3142a {
 /* ******************************************************************************************************
  */
 
-// values store what tab selection on (used for debugging)
-int tabSelection = -1;
+// what tab is selected, kept as a metric for debugging (see Telemetry/metrics.h)
+static telemetry3142a::metricID tabGauge = telemetry3142a::METRICS_FULL;
 int chassisSelection = -1;
-int nonChassisSelection = -1;
 // Button group definitions
-ButtonGroupMaker tabButtons({
-    {0, 0, 70, 30, false, 0x303030, 0xD0D0D0, "Auton"},
-    {80, 0, 70, 30, false, 0x303030, 0xD0D0D0, "Set."},
-    {160, 0, 70, 30, false, 0x303030, 0xD0D0D0, "PID"},
-});
-
-ButtonGroupMaker autonButtons({
-    {30, 40, 60, 60, false, 0xE00000, 0x0000E0, "Ally"},
-    {120, 40, 60, 60, false, 0x303030, 0xD0D0D0, "Start"},
-    {210, 40, 60, 60, false, 0x303030, 0xD0D0D0, "Skills"},
-});
-
-ButtonGroupMaker settingButtons({
-    {390, 200, 85, 30, false, 0x303030, 0x303030, "speed"},
-    {30, 150, 60, 30, false, 0x303030, 0x303030, "up"},
-    {150, 150, 60, 30, false, 0x303030, 0x303030, "down"},
-});
-
-ButtonGroupMaker pidToggleButtons({
-    {300, 150, 60, 40, false, 0x303030, 0x303030, "Chassis"},
-    {120, 40, 60, 30, false, 0x303030, 0x303030, "up"},
-    {120, 90, 60, 30, false, 0x303030, 0x303030, "down"},
-    {200, 40, 60, 30, false, 0x303030, 0x303030, "up"},
-    {200, 90, 60, 30, false, 0x303030, 0x303030, "down"},
-    {280, 40, 60, 30, false, 0x303030, 0x303030, "up"},
-    {280, 90, 60, 30, false, 0x303030, 0x303030, "down"},
-});
-
-ButtonGroupMaker pidChassisTabButtons({
-
-    {30, 90, 60, 30, false, 0x303030, 0xD0D0D0, "Dist."},
-    {30, 140, 60, 30, false, 0x303030, 0xD0D0D0, "Angle"},
-    {30, 190, 60, 30, false, 0x303030, 0xD0D0D0, "Turn"},
-});
-
-ButtonGroupMaker pidNonChassisTabButtons({
-
-    {30, 90, 60, 30, false, 0x303030, 0xD0D0D0, "leftFly"},
-    {30, 140, 60, 30, false, 0x303030, 0xD0D0D0, "rightFly"},
-    {30, 190, 60, 30, false, 0x303030, 0xD0D0D0, "leftIntake"},
-    {240, 210, 60, 30, false, 0x303030, 0xD0D0D0, "rightIntake"},
-});
+// the groups are built by initSelector() in the selector task, so none of them is built before main
+static math3142a::Deferred<ButtonGroupMaker> tabButtonsStorage;
+static math3142a::Deferred<ButtonGroupMaker> autonButtonsStorage;
+static math3142a::Deferred<ButtonGroupMaker> settingButtonsStorage;
+static math3142a::Deferred<ButtonGroupMaker> pidToggleButtonsStorage;
+static math3142a::Deferred<ButtonGroupMaker> pidChassisTabButtonsStorage;
+static math3142a::Deferred<ButtonGroupMaker> pidTestButtonStorage;
+static math3142a::Deferred<ButtonGroupMaker> hiButtonsStorage;
+static math3142a::Deferred<ButtonGroupMaker> telemetryButtonsStorage;
+static math3142a::Deferred<ButtonGroupMaker> confirmButtonStorage;
+
+ButtonGroupMaker &tabButtons = tabButtonsStorage.object();
+ButtonGroupMaker &autonButtons = autonButtonsStorage.object();
+ButtonGroupMaker &settingButtons = settingButtonsStorage.object();
+ButtonGroupMaker &pidToggleButtons = pidToggleButtonsStorage.object();
+ButtonGroupMaker &pidChassisTabButtons = pidChassisTabButtonsStorage.object();
+ButtonGroupMaker &pidTestButton = pidTestButtonStorage.object();
+
+/**
+ * enum chassisTunerID. Entries of the chassis PID tuner (same order as pidChassisTabButtons)
+ */
+enum chassisTunerID { DISTANCE_TUNER, ANGLE_TUNER, TURN_TUNER, FEEDFORWARD_TUNER };
 
+// filled in from the chassis when the selector starts (see syncChassisTuner)
+// the PD controllers have no kI, the feedforward entry is {max voltage, left kA, right kA}
 pidValues chassisPidControllers[] = {
-    {1, 2, 3, "distance"}, // lateral pid values
-    {4, 5, 6, "angle"},    // anglespid values
-    {7, 8, 9, "turn"}      // turn pid values
+    {0, 0, 0, "distance"},   // lateral pid values
+    {0, 0, 0, "angle"},      // anglespid values
+    {0, 0, 0, "turn"},       // turn pid values
+    {0, 0, 0, "feedforward"} // feedforward values
 };
 
-ButtonGroupMaker hiButtons({
-
-    {30, 90, 60, 30, false, 0x303030, 0xD0D0D0, "leftFly"},
-    {30, 140, 60, 30, false, 0x303030, 0xD0D0D0, "rightFly"},
-    {30, 190, 60, 30, false, 0x303030, 0xD0D0D0, "leftIntake"},
-    {240, 210, 60, 30, false, 0x303030, 0xD0D0D0, "rightIntake"},
-});
+// names printed for the three values of each chassis tuner entry
+const char *chassisTunerNames[][3] = {
+    {"kP", "kI", "kD"},
+    {"kP", "kI", "kD"},
+    {"kP", "kI", "kD"},
+    {"V", "kAl", "kAr"},
+};
 
-pidValues nonChassisPidControllers[] = {
-    {1, 2, 3, "leftFly"},          // leftFly pid values
-    {4, 5, 6, "rightFly"},         // leftIntake pid values
-    {34, 324, 23, "leftIntake"},   // rightFly pid values
-    {12, 123, 321, "rightIntake"}, // righttIntake pid values
+// how much one up/down press changes each value
+const double chassisTunerSteps[][3] = {
+    {0.5, 0, 1},
+    {0.5, 0, 1},
+    {1, 0, 1},
+    {0.25, 0.01, 0.01},
 };
 
-enum tabID { AUTON, SETTINGS, PID };
+bool tunerUnsaved = false;   // true when tuner values changed since we last saved them
+uint32_t tunerChangeTime = 0; // when the tuner values last changed (msec)
+static const uint32_t TUNER_SAVE_DELAY_MS = 1000; // save once the values stop changing for this long
+
+bool testMotionRunning = false; // true while the tuner's test motion is driving the robot
+
+ButtonGroupMaker &hiButtons = hiButtonsStorage.object();
 
-ButtonGroupMaker
-    confirmButton({{390, 120, 50, 50, false, 0x303030, 0x303030, "confirm"}});
+ButtonGroupMaker &telemetryButtons = telemetryButtonsStorage.object();
 
-std::string settings[] = {"speed", "angle"}; // settings buttons names
+// signals plotted for each of the telemetry buttons (SIGNAL_COUNT when there is no second line)
+const telemetry3142a::signalID telemetryPlots[][2] = {
+    {telemetry3142a::PROFILE_POSITION, telemetry3142a::MEASURED_POSITION},
+    {telemetry3142a::LEFT_VOLTAGE, telemetry3142a::RIGHT_VOLTAGE},
+    {telemetry3142a::HEADING, telemetry3142a::SIGNAL_COUNT},
+    {telemetry3142a::FLYWHEEL_RPM, telemetry3142a::SIGNAL_COUNT},
+};
+const int STATS_BUTTON = 4; // the telemetry button after the plots lists the metrics instead
+int telemetrySelection = 0;
+int metricsPage = 0; // which METRIC_ROWS metrics the stats view shows, pressing "Stats" again moves on
+
+enum tabID { AUTON, SETTINGS, PID, TELEMETRY };
+
+ButtonGroupMaker &confirmButton = confirmButtonStorage.object();
+
+void initSelector() {
+  tabButtonsStorage.construct(ButtonGroupMaker({
+      {0, 0, 70, 30, false, 0x303030, 0xD0D0D0, "Auton"},
+      {80, 0, 70, 30, false, 0x303030, 0xD0D0D0, "Set."},
+      {160, 0, 70, 30, false, 0x303030, 0xD0D0D0, "PID"},
+      {240, 0, 70, 30, false, 0x303030, 0xD0D0D0, "Tele."},
+  }));
+
+  autonButtonsStorage.construct(ButtonGroupMaker({
+      {30, 40, 60, 60, false, 0xE00000, 0x0000E0, "Ally"},
+      {120, 40, 60, 60, false, 0x303030, 0xD0D0D0, "Start"},
+      {210, 40, 60, 60, false, 0x303030, 0xD0D0D0, "Skills"},
+  }));
+
+  settingButtonsStorage.construct(ButtonGroupMaker({
+      {390, 200, 85, 30, false, 0x303030, 0x303030, "speed"},
+      {30, 150, 60, 30, false, 0x303030, 0x303030, "up"},
+      {150, 150, 60, 30, false, 0x303030, 0x303030, "down"},
+  }));
+
+  pidToggleButtonsStorage.construct(ButtonGroupMaker({
+      {120, 40, 60, 30, false, 0x303030, 0x303030, "up"},
+      {120, 90, 60, 30, false, 0x303030, 0x303030, "down"},
+      {200, 40, 60, 30, false, 0x303030, 0x303030, "up"},
+      {200, 90, 60, 30, false, 0x303030, 0x303030, "down"},
+      {280, 40, 60, 30, false, 0x303030, 0x303030, "up"},
+      {280, 90, 60, 30, false, 0x303030, 0x303030, "down"},
+  }));
+
+  pidChassisTabButtonsStorage.construct(ButtonGroupMaker({
+      {30, 90, 60, 30, false, 0x303030, 0xD0D0D0, "Dist."},
+      {30, 140, 60, 30, false, 0x303030, 0xD0D0D0, "Angle"},
+      {30, 190, 60, 30, false, 0x303030, 0xD0D0D0, "Turn"},
+      {100, 190, 60, 30, false, 0x303030, 0xD0D0D0, "FF"},
+  }));
+
+  pidTestButtonStorage.construct(ButtonGroupMaker({
+      {200, 190, 60, 30, false, 0x303030, 0x303030, "Test"},
+  }));
+
+  hiButtonsStorage.construct(ButtonGroupMaker({
+      {30, 90, 60, 30, false, 0x303030, 0xD0D0D0, "leftFly"},
+      {30, 140, 60, 30, false, 0x303030, 0xD0D0D0, "rightFly"},
+      {30, 190, 60, 30, false, 0x303030, 0xD0D0D0, "leftIntake"},
+      {240, 210, 60, 30, false, 0x303030, 0xD0D0D0, "rightIntake"},
+  }));
+
+  telemetryButtonsStorage.construct(ButtonGroupMaker({
+      {10, 40, 70, 32, true, 0x303030, 0xD0D0D0, "Pos"},
+      {10, 80, 70, 32, false, 0x303030, 0xD0D0D0, "Volt"},
+      {10, 120, 70, 32, false, 0x303030, 0xD0D0D0, "Head"},
+      {10, 160, 70, 32, false, 0x303030, 0xD0D0D0, "RPM"},
+      {10, 200, 70, 32, false, 0x303030, 0xD0D0D0, "Stats"},
+  }));
+
+  confirmButtonStorage.construct(ButtonGroupMaker({{390, 120, 50, 50, false, 0x303030, 0x303030, "confirm"}}));
+
+  tabGauge = telemetry3142a::addGauge("selector.tab");
+  telemetry3142a::setGauge(tabGauge, -1);
+
+  boot3142a::profileStep("selector");
+}
+
+const char *settings[] = {"speed", "angle"}; // settings buttons names
 double doubleSettings[] = {50, 50};          // settings buttons values
 int settingsLen =
     sizeof(settings) / sizeof(settings[0]); // size of the setting button array
 
-std::string pidToggle[] = {"chassis", "non-chassis"}; // pid menu names
-int pidSettingsLen =
-    sizeof(pidToggle) / sizeof(pidToggle[0]); // size of pid menu names (2)
+// text widgets for the values printed on the settings and PID pages
+TextField settingLabelField(60, 140, 60, vex::color(0x808080));
+TextField settingValueField(130, 140, 80, vex::color(0x808080));
+TextField speedField(220, 180, 150, vex::color(0x808080));
+TextField angleField(220, 220, 150, vex::color(0x808080));
+
+TextField kPField(120, 85, 85, vex::color(0x404040));
+TextField kIField(210, 85, 75, vex::color(0x404040));
+TextField kDField(290, 85, 90, vex::color(0x404040));
+
+GraphField telemetryGraph(90, 40, 290, 190);
+
+// one metric per line, the lines are 22 high so the top three sit on the dark half of the background
+const int METRIC_ROWS = 8;
+const uint32_t METRICS_REFRESH_MS = 500;
+TextField metricFields[METRIC_ROWS] = {
+    {90, 72, 290, vex::color(0x404040)},  {90, 94, 290, vex::color(0x404040)},
+    {90, 116, 290, vex::color(0x404040)}, {90, 138, 290, vex::color(0x808080)},
+    {90, 160, 290, vex::color(0x808080)}, {90, 182, 290, vex::color(0x808080)},
+    {90, 204, 290, vex::color(0x808080)}, {90, 226, 290, vex::color(0x808080)},
+};
+
+TextField calibratingField(100, 150, 230, vex::color(0x000000));
+TextField calibrationDoneField(330, 150, 60, vex::color(0x000000));
+
+/**
+ * enum pageID. Every combination of tabs/toggles that needs its own background
+ */
+enum pageID {
+  NO_PAGE = -1, // nothing drawn yet
+  BLANK_PAGE,   // no tab selected
+  AUTON_PAGE,
+  SETTINGS_PAGE,
+  CHASSIS_PID_PAGE,
+  TELEMETRY_PAGE,
+  METRICS_PAGE,
+  LOADING_PAGE
+};
+
+int drawnPage = NO_PAGE; // page that is currently on the screen
 
 void makeBackground() {
   Brain.Screen.setFillColor(vex::color(0x404040));
@@ -109,205 +219,236 @@ void makeBackground() {
   Brain.Screen.drawRectangle(0, 120, 480, 120);
 }
 
+/**
+ * Works out which page the selector should be showing from the button states
+ * @return pageID of the page
+ */
+static int currentPage() {
+  if (confirmPress != 0)
+    return LOADING_PAGE;
+  if (tabButtons.buttonList[AUTON].state)
+    return AUTON_PAGE;
+  if (tabButtons.buttonList[SETTINGS].state)
+    return SETTINGS_PAGE;
+  if (tabButtons.buttonList[PID].state)
+    return CHASSIS_PID_PAGE;
+  if (tabButtons.buttonList[TELEMETRY].state)
+    return telemetrySelection == STATS_BUTTON ? METRICS_PAGE : TELEMETRY_PAGE;
+  return BLANK_PAGE;
+}
+
 int countSettingsPress = 0; // number of times the settings switch has been pressed
-int countPidSettingsPress = 0; // number of times the pid settings switch has been pressed
-bool togglePressed = false;    // state of a settings toggle button press
-bool togglePidPressed = false; // state of a pid settings toggle button press
-
-void changeChassisPidValues(int type) {
-  /**
-   * enum pidChassisToggles. Keeps track of what value to change depending on
-   * press
-   */
-
-  enum pidChassisToggles {
-    SETTINGS_TOGGLE,
-    INCREASE_KP,
-    DECREASE_KP,
-    INCREASE_KI,
-    DECREASE_KI,
-    INCREASE_KD,
-    DECREASE_KD,
-  };
-
-  int xpos = Brain.Screen.xPosition();
-  int ypos = Brain.Screen.yPosition();
-
-  int valueIndex =
-      pidToggleButtons.findButton(xpos, ypos); // which toggle button is pressed
+
+/**
+ * enum pidToggles. Keeps track of what value to change depending on press
+ */
+
+enum pidToggles {
+  INCREASE_KP,
+  DECREASE_KP,
+  INCREASE_KI,
+  DECREASE_KI,
+  INCREASE_KD,
+  DECREASE_KD,
+};
+
+/**
+ * Applies one up/down press to a set of PID values
+ * @param values pid values to change
+ * @param valueIndex which toggle button was pressed (see pidToggles)
+ * @param steps how much a press changes kP, kI and kD
+ */
+
+static void changePidValues(pidValues &values, int valueIndex, const double steps[3]) {
   switch (valueIndex) {
-  case SETTINGS_TOGGLE:
-    break;
   case INCREASE_KP:
-    chassisPidControllers[type].kP += 2;
+    values.kP += steps[0];
     break;
   case DECREASE_KP:
-    chassisPidControllers[type].kP -= 2;
+    values.kP -= steps[0];
     break;
   case INCREASE_KI:
-    chassisPidControllers[type].kI += 2;
+    values.kI += steps[1];
     break;
   case DECREASE_KI:
-    chassisPidControllers[type].kI -= 2;
+    values.kI -= steps[1];
     break;
   case INCREASE_KD:
-    chassisPidControllers[type].kD += 2;
+    values.kD += steps[2];
     break;
   case DECREASE_KD:
-    chassisPidControllers[type].kD -= 2;
+    values.kD -= steps[2];
     break;
   }
 }
 
-void changeNonChassisPidValues(int type) {
-  /**
-   * enum pidNonChassisToggles. Keeps track of what value to change depending on
-   * press
-   */
-  enum pidNonChassisToggles {
-    SETTINGS_TOGGLE,
-    INCREASE_KP,
-    DECREASE_KP,
-    INCREASE_KI,
-    DECREASE_KI,
-    INCREASE_KD,
-    DECREASE_KD,
-  };
-  int xpos = Brain.Screen.xPosition();
-  int ypos = Brain.Screen.yPosition();
-  int valueIndex = pidToggleButtons.findButton(xpos, ypos);
-  switch (valueIndex) {
-  case SETTINGS_TOGGLE:
-    break;
-  case INCREASE_KP:
-    nonChassisPidControllers[type].kP += 2;
-    break;
-  case DECREASE_KP:
-    nonChassisPidControllers[type].kP -= 2;
-    break;
-  case INCREASE_KI:
-    nonChassisPidControllers[type].kI += 2;
-    break;
-  case DECREASE_KI:
-    nonChassisPidControllers[type].kI -= 2;
-    break;
-  case INCREASE_KD:
-    nonChassisPidControllers[type].kD += 2;
-    break;
-  case DECREASE_KD:
-    nonChassisPidControllers[type].kD -= 2;
-    break;
+/**
+ * Packs the chassis tuner values into chassisGains
+ * @return gains shown on the chassis tuner
+ */
+
+static chassisGains getChassisTunerGains() {
+  chassisGains gains;
+  gains.distance = PDcontroller{chassisPidControllers[DISTANCE_TUNER].kP, chassisPidControllers[DISTANCE_TUNER].kD};
+  gains.angle = PDcontroller{chassisPidControllers[ANGLE_TUNER].kP, chassisPidControllers[ANGLE_TUNER].kD};
+  gains.turn = PDcontroller{chassisPidControllers[TURN_TUNER].kP, chassisPidControllers[TURN_TUNER].kD};
+  gains.feedforward = feedforwardGains{chassisPidControllers[FEEDFORWARD_TUNER].kP,
+                                       chassisPidControllers[FEEDFORWARD_TUNER].kI,
+                                       chassisPidControllers[FEEDFORWARD_TUNER].kD};
+  return (gains);
+}
+
+void syncChassisTuner() {
+  chassisGains gains = getChassisGains(chassis);
+  pidValues *tuner = chassisPidControllers;
+
+  tuner[DISTANCE_TUNER].kP = gains.distance.kP;
+  tuner[DISTANCE_TUNER].kD = gains.distance.kD;
+  tuner[ANGLE_TUNER].kP = gains.angle.kP;
+  tuner[ANGLE_TUNER].kD = gains.angle.kD;
+  tuner[TURN_TUNER].kP = gains.turn.kP;
+  tuner[TURN_TUNER].kD = gains.turn.kD;
+  tuner[FEEDFORWARD_TUNER].kP = gains.feedforward.maxVoltage;
+  tuner[FEEDFORWARD_TUNER].kI = gains.feedforward.leftKa;
+  tuner[FEEDFORWARD_TUNER].kD = gains.feedforward.rightKa;
+}
+
+void changeChassisPidValues(int type, int valueIndex) {
+  changePidValues(chassisPidControllers[type], valueIndex, chassisTunerSteps[type]);
+
+  // straight to the live controllers, they pick it up between two control ticks
+  requestChassisGains(chassis, getChassisTunerGains());
+
+  tunerUnsaved = true;
+  tunerChangeTime = math3142a::millis();
+}
+
+void saveChassisTuner(uint32_t timeMs) {
+  if (!tunerUnsaved || timeMs - tunerChangeTime < TUNER_SAVE_DELAY_MS)
+    return;
+
+  saveChassisGains(getChassisTunerGains());
+  tunerUnsaved = false;
+}
+
+/**
+ * tasked function that drives a short test motion with the gains of the selected tuner entry
+ * turn gains get a 90 degree turn and back, everything else drives forwards and back
+ */
+
+static int runTestMotion() {
+  boot3142a::waitForStages(boot3142a::MOTION_STAGES);
+
+  if (chassisSelection == TURN_TUNER) {
+    chassis.turnToDegreeGyro(90.0_deg);
+    chassis.turnToDegreeGyro(0.0_deg);
+  } else {
+    chassis.driveStraightFeedforward(24.0_in);
+    chassis.driveStraightFeedforward(24.0_in, true);
   }
+
+  testMotionRunning = false;
+  return 0;
 }
 
 int confirmPress = 0; // number of times confirm button has beem pressed
 
+/**
+ * enum groupID. What the hit grid reports for each button group
+ */
+
+enum groupID {
+  TAB_GROUP,
+  CONFIRM_GROUP,
+  AUTON_GROUP,
+  SETTING_GROUP,
+  PID_TOGGLE_GROUP,
+  PID_CHASSIS_GROUP,
+  PID_TEST_GROUP,
+  TELEMETRY_GROUP
+};
+
+TouchInput touchInput; // events from the brain screen callbacks
+HitGrid hitGrid;       // buttons that can be pressed on the current page
+int gridPage = NO_PAGE; // page the hit grid was built for
+
+/**
+ * Rebuilds the hit grid with the button groups that are on a page
+ * @param page pageID of the page
+ */
+
+static void makeHitGrid(int page) {
+  hitGrid.clear();
+
+  if (page == LOADING_PAGE) // nothing can be pressed after confirming
+    return;
+
+  hitGrid.addGroup(tabButtons, TAB_GROUP);
+  hitGrid.addGroup(confirmButton, CONFIRM_GROUP);
+
+  if (page == AUTON_PAGE)
+    hitGrid.addGroup(autonButtons, AUTON_GROUP);
+  else if (page == SETTINGS_PAGE)
+    hitGrid.addGroup(settingButtons, SETTING_GROUP);
+  else if (page == CHASSIS_PID_PAGE) {
+    hitGrid.addGroup(pidToggleButtons, PID_TOGGLE_GROUP);
+    hitGrid.addGroup(pidChassisTabButtons, PID_CHASSIS_GROUP);
+    hitGrid.addGroup(pidTestButton, PID_TEST_GROUP);
+  }
+  else if (page == TELEMETRY_PAGE || page == METRICS_PAGE)
+    hitGrid.addGroup(telemetryButtons, TELEMETRY_GROUP);
+}
+
 void userTouchCallbackPressed() {
-  int index;
-  int xpos = Brain.Screen.xPosition();
-  int ypos = Brain.Screen.yPosition();
-  if (confirmPress ==
-      0) { // only register when we have not hit the confirm button
-    int currentSettingsPos =
-        countSettingsPress % settingsLen; // index of what setting we are on
-    if ((index = tabButtons.findButton(xpos, ypos)) >= 0) {
-
-      displayAllButtonControls(index, true);
-
-    } // if we are in auton button menu
-    if (tabButtons.buttonList[AUTON].state) {
-      if ((index = autonButtons.findButton(xpos, ypos)) >= 0) {
-        autonButtons.displayButtonControls(index, true);
-      }
-    }
-    if (tabButtons.buttonList[SETTINGS].state) { // if we are in tabButton menu
-      if ((index = settingButtons.findButton(xpos, ypos)) >= 0) {
-        if (index == 0) { // if the settings toggle is pressed
-          displayAllButtonControls(index, true);
-          countSettingsPress++; // changing the setting menu
-        } else if (index > 0) {
-          togglePressed = true;
-        }
-
-        // Changes the values of the settings buttons
-        // This is in a while loop to allow for increasing by press and hold
-        while (togglePressed) {
-          if (index == 1) { // if pressing increase
-            displayAllButtonControls(index, true);
-            doubleSettings[currentSettingsPos] += 5;
-          }
-          if (index == 2) { // if we are pressing decrease
-            displayAllButtonControls(index, true);
-            doubleSettings[currentSettingsPos] -= 5;
-          }
-          task::sleep(400);
-        }
-      }
-    }
-    if (tabButtons.buttonList[PID].state) { // if we are in the PID tuner menu
-      if ((index = pidToggleButtons.findButton(xpos, ypos)) >=
-          0) { // display the "chassis" vs "non-chassis" toggle no matter what
-        if (index == 0) {
-          countPidSettingsPress++;
-
-          displayAllButtonControls(index, true);
-        } else if (index > 0) {
-          togglePidPressed = true;
-        }
-      }
-      if (!(pidToggleButtons.buttonList[0]
-                .state)) { // i we are in the chassis menu of pid tuner
-        if ((index = pidChassisTabButtons.findButton(xpos, ypos)) >= 0) {
-          displayAllButtonControls(index, true);
-        }
-        while (togglePidPressed) { // similar to the settings button toggles
-          for (int i = 0; i < pidChassisTabButtons.buttonList.size(); i++) {
-            if (pidChassisTabButtons.buttonList[i].state) {
-
-              displayAllButtonControls(index, true);
-
-              if (Brain.Screen.pressing())
-                changeChassisPidValues(i);
-            }
-          }
-          if (!(Brain.Screen.pressing())) // make sure not to get stuck in loop!
-            togglePidPressed = false;
-
-          task::sleep(400);
-        }
-      } else { // if we are in the non-chassis pid menu
-        if ((index = pidNonChassisTabButtons.findButton(xpos, ypos)) >= 0) {
-          displayAllButtonControls(index, true);
-        }
-        while (togglePidPressed) {
-          for (int i = 0; i < pidNonChassisTabButtons.buttonList.size(); i++) {
-            if (pidNonChassisTabButtons.buttonList[i].state) {
-              displayAllButtonControls(index, true);
-              if (Brain.Screen.pressing())
-                changeNonChassisPidValues(i);
-            }
-          }
-          if (!(Brain.Screen.pressing()))
-            togglePidPressed = false;
-          task::sleep(400); //sleep so the values dont jump immediatly
-        }
-      }
+  touchInput.post(TOUCH_PRESS, Brain.Screen.xPosition(), Brain.Screen.yPosition());
+}
+
+void userTouchCallbackReleased() {
+  touchInput.post(TOUCH_RELEASE, Brain.Screen.xPosition(), Brain.Screen.yPosition());
+}
+
+/**
+ * Handles a button going down, or being held down (repeat)
+ * Up/down buttons change their value on the press and on every repeat after it
+ * @param group groupID of the button
+ * @param index of the button in the group
+ * @param repeat true if this is a repeat of a held press
+ */
+
+static void pressButton(int group, int index, bool repeat) {
+  int currentSettingsPos =
+      countSettingsPress % settingsLen; // index of what setting we are on
+
+  if (group == SETTING_GROUP) {
+    if (index == 0 && !repeat) { // if the settings toggle is pressed
+      countSettingsPress++;      // changing the setting menu
+    } else if (index == 1) {     // if pressing increase
+      doubleSettings[currentSettingsPos] += 5;
+    } else if (index == 2) { // if we are pressing decrease
+      doubleSettings[currentSettingsPos] -= 5;
     }
   }
+
+  if (group == PID_TOGGLE_GROUP && chassisSelection >= 0) // every toggle is an up/down button
+    changeChassisPidValues(chassisSelection, index);
 }
+
 // values to be used from the seletor
 // NOTE: This is not a final list of all variables
 bool allianceBlue = false;
 bool skills = false;
 
-void userTouchCallbackReleased() {
-  int index;
-  int xpos = Brain.Screen.xPosition();
-  int ypos = Brain.Screen.yPosition();
+/**
+ * Handles a button coming back up. Tabs, toggles and selections change here
+ * @param group groupID of the button
+ * @param index of the button in the group
+ */
+
+static void releaseButton(int group, int index) {
   int currentSettingsPos = countSettingsPress % settingsLen;
-  int currentPidSettingsPos = countPidSettingsPress % pidSettingsLen;
-  if ((index = tabButtons.findButton(xpos, ypos)) >= 0 && confirmPress == 0) {
 
+  switch (group) {
+  case TAB_GROUP:
     // clear all buttons to false
     // this allows for tab buttons to be chosen induvitually, instead of all at
     // once
@@ -315,177 +456,261 @@ void userTouchCallbackReleased() {
 
     tabButtons.switchStates(index); // set the pressed one to true
 
-    tabSelection = index;
+    telemetry3142a::setGauge(tabGauge, index);
+    break;
 
-    displayAllButtonControls(index, false);
-  }
-  if (confirmPress == 0) {
-    if ((index = confirmButton.findButton(xpos, ypos)) == 0) { // if we have confirmed our selction
+  case CONFIRM_GROUP: // if we have confirmed our selction
+    tabButtons.initButtons();
+    confirmButton.switchStates(index);
 
-      tabButtons.initButtons();
-      confirmButton.switchStates(index);
+    confirmPress += 1;
 
-      confirmPress += 1;
+    // store variables made in selector
+    allianceBlue = autonButtons.buttonList[0].state;
+    skills = autonButtons.buttonList[2].state;
 
-      // store variables made in selector
-      allianceBlue = autonButtons.buttonList[0].state;
-      skills = autonButtons.buttonList[2].state;
+    // the loading screen is drawn by the display task, we only start the calibration here
+    boot3142a::startStage(boot3142a::IMU_STAGE);
+    // runAutoSkills();
+    break;
 
-      Brain.Screen.clearScreen();
+  case AUTON_GROUP:
+    autonButtons.switchStates(index);
+    break;
 
-      // generate loading screen
-      makeLoadingScreen();
-      // runAutoSkills();
-    }
-    if (tabButtons.buttonList[AUTON].state) {
-      if ((index = autonButtons.findButton(xpos, ypos)) >= 0) {
-        autonButtons.switchStates(index);
+  case SETTING_GROUP:
+    if (index == 0)
+      settingButtons.buttonList[index].label =
+          settings[currentSettingsPos]; // change the label of the setting button depending on toggle
+    settingButtons.switchStates(index);
+    break;
 
-        autonButtons.displayButtonControls(index, false);
-      }
-    }
-    if (tabButtons.buttonList[SETTINGS].state) {
-      if ((index = settingButtons.findButton(xpos, ypos)) >= 0) {
-        if (index == 0)
-          settingButtons.buttonList[index].label =
-              settings[currentSettingsPos].c_str(); // change the label of the setting button depending on toggle
-        settingButtons.switchStates(index);
-        togglePressed = false;
-        displayAllButtonControls(index, false);
-      }
-    }
-    if (tabButtons.buttonList[PID].state) {
-      if ((index = pidToggleButtons.findButton(xpos, ypos)) >= 0) {
-        if (index == 0)
-          pidToggleButtons.buttonList[index].label =
-              pidToggle[currentPidSettingsPos].c_str(); // change the label of the pidsetting button depending on toggle
-        pidToggleButtons.switchStates(index);
-        displayAllButtonControls(index, true);
-        togglePidPressed = false;
-      }
-
-      if (!(pidToggleButtons.buttonList[0].state)) {
-        if ((index = pidChassisTabButtons.findButton(xpos, ypos)) >= 0) {
-          pidChassisTabButtons.initButtons();
-
-          pidChassisTabButtons.switchStates(index);
-
-          chassisSelection = index;
-          displayAllButtonControls(index, true);
-        }
-      } else {
-        if ((index = pidNonChassisTabButtons.findButton(xpos, ypos)) >= 0) {
-          pidNonChassisTabButtons.initButtons();
-          pidNonChassisTabButtons.switchStates(index);
-          nonChassisSelection = index;
-          displayAllButtonControls(index, true);
-        }
-      }
+  case PID_TOGGLE_GROUP:
+    pidToggleButtons.switchStates(index);
+    break;
+
+  case PID_CHASSIS_GROUP:
+    pidChassisTabButtons.initButtons();
+    pidChassisTabButtons.switchStates(index);
+    chassisSelection = index;
+    break;
+
+  case PID_TEST_GROUP:
+    if (!testMotionRunning) { // only one test motion at a time
+      testMotionRunning = true;
+      task testMotion(runTestMotion);
     }
+    break;
+
+  case TELEMETRY_GROUP:
+    if (index == STATS_BUTTON)
+      metricsPage = telemetrySelection == STATS_BUTTON ? metricsPage + 1 : 0;
+    telemetryButtons.initButtons();
+    telemetryButtons.switchStates(index);
+    telemetrySelection = index;
+    break;
   }
 }
 
-void displaySettingsValues() {
-  Brain.Screen.setCursor(7, 7);
-  Brain.Screen.print(settingButtons.buttonList[0].label);
-  Brain.Screen.setCursor(7, 14);
-  Brain.Screen.print(doubleSettings[countSettingsPress % settingsLen]);
-  double speed = doubleSettings[0];
-  double angle = doubleSettings[1];
-  Brain.Screen.setCursor(9, 23);
-  Brain.Screen.print("Speed: ");
-  Brain.Screen.setCursor(9, 30);
-  Brain.Screen.print(speed);
-  Brain.Screen.setCursor(11, 23);
-  Brain.Screen.print("Angle: ");
-  Brain.Screen.setCursor(11, 30);
-  Brain.Screen.print(angle);
+void handleTouchEvent(const touchEvent &event) {
+  int page = currentPage();
+  if (page != gridPage) { // the last event changed page, so the buttons moved
+    makeHitGrid(page);
+    gridPage = page;
+  }
+
+  int group, index;
+  if (!hitGrid.find(event.xpos, event.ypos, group, index))
+    return;
+
+  if (event.type == TOUCH_RELEASE)
+    releaseButton(group, index);
+  else
+    pressButton(group, index, event.type == TOUCH_REPEAT);
+}
+
+int displaySettingsValues() {
+  settingLabelField.setText("%s", settingButtons.buttonList[0].label);
+  settingValueField.setText("%.2f", doubleSettings[countSettingsPress % settingsLen]);
+  speedField.setText("Speed: %.2f", doubleSettings[0]);
+  angleField.setText("Angle: %.2f", doubleSettings[1]);
+
+  return settingLabelField.render() + settingValueField.render() +
+         speedField.render() + angleField.render();
 }
 
-void displayPIDSettings() {
-  if (!(pidToggleButtons.buttonList[0].state)) { //if we are in the chassis pid menu
-    Brain.Screen.printAt(120, 85, "kP:%.2f",
-                         chassisPidControllers[chassisSelection].kP);
-    Brain.Screen.printAt(210, 85, "kI:%.2f",
-                         chassisPidControllers[chassisSelection].kI);
-    Brain.Screen.printAt(290, 85, "kD:%.2f",
-                         chassisPidControllers[chassisSelection].kD);
+int displayPIDSettings() {
+  const pidValues *selected = NULL;
+  const char *const defaultNames[3] = {"kP", "kI", "kD"};
+  const char *const *names = defaultNames;
+
+  if (chassisSelection >= 0) {
+    selected = &chassisPidControllers[chassisSelection];
+    names = chassisTunerNames[chassisSelection];
   }
-  if ((pidToggleButtons.buttonList[0].state)) { //if we are in the nonchassis pid menu
-    Brain.Screen.printAt(120, 85, "kP:%.2f",
-                         nonChassisPidControllers[nonChassisSelection].kP);
-    Brain.Screen.printAt(210, 85, "kI:%.2f",
-                         nonChassisPidControllers[nonChassisSelection].kI);
-    Brain.Screen.printAt(290, 85, "kD:%.2f",
-                         nonChassisPidControllers[nonChassisSelection].kD);
+
+  if (selected == NULL) { // no controller picked yet
+    kPField.setText("");
+    kIField.setText("");
+    kDField.setText("");
+  } else {
+    kPField.setText("%s:%.2f", names[0], selected->kP);
+    kIField.setText("%s:%.2f", names[1], selected->kI);
+    kDField.setText("%s:%.2f", names[2], selected->kD);
   }
+  return kPField.render() + kIField.render() + kDField.render();
 }
 
-int displayPIDControls(int index, bool pressed) {
+int displayMetrics() {
+  static telemetry3142a::metricsSnapshot snapshot; // static, too big for the selector task's stack
+  static uint32_t lastSnapshotTime = 0;
 
-  pidToggleButtons.displayButtonControls(0, false);
+  uint32_t now = math3142a::millis();
+  if (snapshot.time == 0 || now - lastSnapshotTime >= METRICS_REFRESH_MS) {
+    telemetry3142a::takeSnapshot(snapshot);
+    lastSnapshotTime = now;
+  }
 
-  if (!(pidToggleButtons.buttonList[0].state)) { // display chassis pid settings
-    pidChassisTabButtons.displayButtonControls(0, false, false);
+  int pages = (snapshot.count + METRIC_ROWS - 1) / METRIC_ROWS;
+  int first = pages > 0 ? (metricsPage % pages) * METRIC_ROWS : 0;
+
+  int redrawn = 0;
+  char text[32];
+  for (int row = 0; row < METRIC_ROWS; row++) {
+    telemetry3142a::formatMetric(snapshot, first + row, text, sizeof(text));
+    metricFields[row].setText("%s", text);
+    redrawn += metricFields[row].render();
   }
+  return redrawn;
+}
+
+int displayPIDControls() {
+  int redrawn = pidToggleButtons.render();
+  redrawn += pidChassisTabButtons.render();
+  redrawn += pidTestButton.render();
+  return redrawn;
+}
 
-  else { // display non chassis pid settings
-    pidNonChassisTabButtons.displayButtonControls(0, false, false);
+/**
+ * Paints the background of a new page and marks everything that sits on it as stale
+ * @param page pageID of the new page
+ */
+static void makePage(int page) {
+  ButtonGroupMaker *groups[] = {&tabButtons, &confirmButton, &autonButtons, &settingButtons,
+                                &pidToggleButtons, &pidChassisTabButtons, &pidTestButton,
+                                &telemetryButtons};
+  TextField *fields[] = {&settingLabelField, &settingValueField, &speedField, &angleField,
+                         &kPField, &kIField, &kDField, &calibratingField, &calibrationDoneField};
+
+  for (auto group : groups)
+    group->invalidate();
+  for (auto field : fields)
+    field->invalidate();
+  for (auto &field : metricFields)
+    field.invalidate();
+  telemetryGraph.invalidate();
+
+  if (page == LOADING_PAGE) {
+    Brain.Screen.clearScreen();
+    return;
   }
-  return 1;
+
+  makeBackground();
+  if (page != TELEMETRY_PAGE && page != METRICS_PAGE) // the graph and metrics cover where the logo goes
+    Brain.Screen.drawImageFromFile("logo_test.png", 160, 50);
 }
 
 /*-----------------------------------------------------------------------------*/
-/** @brief      Draw all buttons */
+/** @brief      Draw whatever changed since the last frame */
 /*-----------------------------------------------------------------------------*/
 
-void displayAllButtonControls(int index, bool pressed) {
-  vex::color c;
+int renderSelector() {
+  int page = currentPage();
+  int redrawn = 0;
 
-  Brain.Screen.setPenColor(vex::color(0xe0e0e0));
-  if (confirmPress == 0) {
-    // always display these buttons on the selector
-    tabButtons.displayButtonControls(0, false, true);
-    confirmButton.displayButtonControls(0, false, true);
+  if (page != drawnPage) { // everything behind the buttons changes, start from a clean page
+    makePage(page);
+    drawnPage = page;
+    redrawn++;
+  }
 
-    Brain.Screen.drawImageFromFile("logo_test.png", 160, 50);
+  if (page == LOADING_PAGE)
+    return redrawn + makeLoadingScreen();
 
-    if (tabButtons.buttonList[AUTON].state) // display auton menu
-      autonButtons.displayButtonControls(0, false);
+  // always display these buttons on the selector
+  redrawn += tabButtons.render();
+  redrawn += confirmButton.render();
 
-    else if (tabButtons.buttonList[SETTINGS].state) { // display settings menu
-      settingButtons.displayButtonControls(0, false);
-      displaySettingsValues();
-    }
+  if (page == AUTON_PAGE) // display auton menu
+    redrawn += autonButtons.render();
 
-    else if (tabButtons.buttonList[PID].state) { // display pid settings menu
-      displayPIDControls(0, false);
-      displayPIDSettings();
-    }
+  else if (page == SETTINGS_PAGE) { // display settings menu
+    redrawn += settingButtons.render();
+    redrawn += displaySettingsValues();
+  }
+
+  else if (page == CHASSIS_PID_PAGE) { // display pid settings menu
+    redrawn += displayPIDControls();
+    redrawn += displayPIDSettings();
+  }
+
+  else if (page == TELEMETRY_PAGE) { // display live telemetry dashboard
+    redrawn += telemetryButtons.render();
+    telemetryGraph.setSignals(telemetryPlots[telemetrySelection][0], telemetryPlots[telemetrySelection][1]);
+    redrawn += telemetryGraph.render(math3142a::millis());
+  }
+
+  else if (page == METRICS_PAGE) { // display the metrics registry
+    redrawn += telemetryButtons.render();
+    redrawn += displayMetrics();
   }
+  return redrawn;
 }
 
-void makeLoadingScreen() {
+int makeLoadingScreen() {
 
   // this function shows "a loading screen" of what features are loaded
   // Some of them are time-based and are just for show :)
   // But the clibration of the IMU is real time amd we can see it actually
   // happening and know when it is done calibarting
 
-  if (confirmButton.buttonList[0].state) { // check if we are in confirm menu
-    bool calibartionDone = false;
-    poseTracker.inert.calibrate();
-    while (poseTracker.inert.isCalibrating()) {
-      Brain.Screen.printAt(100, 150, "Calibrating Sensors...");
-    }
-    calibartionDone = true;
-    if (calibartionDone)
-      Brain.Screen.printAt(330, 150, "DONE");
-  }
+  if (!confirmButton.buttonList[0].state) // check if we are in confirm menu
+    return 0;
+
+  calibratingField.setText("Calibrating Sensors...");
+  calibrationDoneField.setText(boot3142a::stagesReady(boot3142a::MOTION_STAGES) ? "DONE" : "");
+
+  return calibratingField.render() + calibrationDoneField.render();
 }
 
 int makeDisplay() {
-  displayAllButtonControls(0, false);
+  initSelector();
+
+  // the first render() switches the brain screen to double buffering.
+  // From then on we draw into the back buffer and only push it when something changed
+  Brain.Screen.render();
+
+  // the first frame doesn't need anything else from boot, so get it on the screen right away
+  renderSelector();
+  Brain.Screen.render();
+  boot3142a::markStageDone(boot3142a::SELECTOR_STAGE);
+
+  // show the gains the chassis is really running with, which come from the config
+  boot3142a::waitForStages(boot3142a::stageBit(boot3142a::CONFIG_STAGE));
+  syncChassisTuner();
+
+  while (true) {
+    touchEvent event;
+    while (touchInput.next(event, math3142a::millis())) // handle every touch that came in since last frame
+      handleTouchEvent(event);
+
+    if (renderSelector() > 0)
+      Brain.Screen.render();
+
+    saveChassisTuner(math3142a::millis());
+
+    task::sleep(20);
+  }
   return (-1);
 }
 
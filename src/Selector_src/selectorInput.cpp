@@ -0,0 +1,137 @@
+#include "Selector/selectorInput.h"
+#include <algorithm>
+#include <string.h>
+
+namespace selector3142a {
+
+TouchInput::TouchInput()
+    : m_head(0), m_tail(0), m_dropped(0), m_held(false), m_nextRepeatTime(0),
+      m_repeatInterval(FIRST_REPEAT_MS) {}
+
+void TouchInput::post(touchEventType type, int16_t xpos, int16_t ypos) {
+  uint32_t head = m_head.load(std::memory_order_relaxed);
+
+  if (head - m_tail.load(std::memory_order_acquire) >= QUEUE_SIZE) { // full, the display task has fallen behind
+    m_dropped++;
+    return;
+  }
+
+  touchEvent &slot = m_queue[head % QUEUE_SIZE];
+  slot.type = type;
+  slot.xpos = xpos;
+  slot.ypos = ypos;
+  slot.repeatCount = 0;
+
+  m_head.store(head + 1, std::memory_order_release); // publish the event
+}
+
+bool TouchInput::next(touchEvent &event, uint32_t timeMs) {
+  uint32_t tail = m_tail.load(std::memory_order_relaxed);
+
+  if (tail != m_head.load(std::memory_order_acquire)) { // real events always go first
+    event = m_queue[tail % QUEUE_SIZE];
+    m_tail.store(tail + 1, std::memory_order_release);
+
+    if (event.type == TOUCH_PRESS) { // start the press and hold timer
+      m_held = true;
+      m_heldEvent = event;
+      m_repeatInterval = FIRST_REPEAT_MS;
+      m_nextRepeatTime = timeMs + m_repeatInterval;
+    } else if (event.type == TOUCH_RELEASE) {
+      m_held = false;
+    }
+    return true;
+  }
+
+  // signed difference so this still works when the msec timer wraps
+  if (m_held && (int32_t)(timeMs - m_nextRepeatTime) >= 0) {
+    m_heldEvent.type = TOUCH_REPEAT;
+    event = m_heldEvent;
+    m_heldEvent.repeatCount++;
+
+    // every repeat comes a quarter sooner than the last one
+    m_repeatInterval -= m_repeatInterval / 4;
+    if (m_repeatInterval < MIN_REPEAT_MS)
+      m_repeatInterval = MIN_REPEAT_MS;
+
+    m_nextRepeatTime = timeMs + m_repeatInterval;
+    return true;
+  }
+  return false;
+}
+
+HitGrid::HitGrid() { clear(); }
+
+void HitGrid::clear() {
+  memset(m_cells, EMPTY, sizeof(m_cells));
+  m_groupCount = 0;
+}
+
+// same (inclusive) bounds as ButtonGroupMaker::findButton
+static bool contains(const button &aButton, int16_t xpos, int16_t ypos) {
+  return (xpos >= aButton.xpos && xpos <= aButton.xpos + aButton.width && ypos >= aButton.ypos &&
+          ypos <= aButton.ypos + aButton.height);
+}
+
+void HitGrid::addGroup(const ButtonGroupMaker &group, int groupID) {
+  int nButtons = group.buttonList.size();
+
+  if (m_groupCount < MAX_GROUPS) {
+    m_groups[m_groupCount] = &group;
+    m_groupIDs[m_groupCount] = groupID;
+    m_groupCount++;
+  }
+
+  for (int index = 0; index < nButtons; index++) {
+    const button &aButton = group.buttonList[index];
+
+    // every cell the button touches, clamped to the screen. The cells round the button out to
+    // the 5 pixel grid, so find() checks the exact bounds of what it finds there
+    int firstColumn = std::max(aButton.xpos / CELL_SIZE, 0);
+    int lastColumn = std::min((aButton.xpos + aButton.width) / CELL_SIZE, COLUMNS - 1);
+    int firstRow = std::max(aButton.ypos / CELL_SIZE, 0);
+    int lastRow = std::min((aButton.ypos + aButton.height) / CELL_SIZE, ROWS - 1);
+
+    for (int row = firstRow; row <= lastRow; row++) {
+      for (int column = firstColumn; column <= lastColumn; column++) {
+        m_cells[row][column] = (uint8_t)((groupID << 4) | index);
+      }
+    }
+  }
+}
+
+bool HitGrid::find(int16_t xpos, int16_t ypos, int &groupID, int &index) const {
+  int column = xpos / CELL_SIZE;
+  int row = ypos / CELL_SIZE;
+
+  if (column < 0 || column >= COLUMNS || row < 0 || row >= ROWS)
+    return false;
+
+  uint8_t cell = m_cells[row][column];
+  if (cell == EMPTY)
+    return false;
+
+  for (int i = 0; i < m_groupCount; i++) {
+    if (m_groupIDs[i] == cell >> 4 && contains(m_groups[i]->buttonList[cell & 0x0F], xpos, ypos)) {
+      groupID = cell >> 4;
+      index = cell & 0x0F;
+      return true;
+    }
+  }
+
+  // the edge of a cell the button only partly covers. Another button may share the cell (buttons
+  // less than a cell apart), so check every button there, the last one added is on top
+  for (int i = m_groupCount - 1; i >= 0; i--) {
+    const ButtonGroupMaker &group = *m_groups[i];
+    for (int button = 0; button < (int)group.buttonList.size(); button++) {
+      if (contains(group.buttonList[button], xpos, ypos)) {
+        groupID = m_groupIDs[i];
+        index = button;
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+}
@@ -0,0 +1,125 @@
+#include "Telemetry/capture.h"
+#include "Util/timestamp.h"
+#include "Util/vex.h"
+
+namespace telemetry3142a {
+
+/**
+ * enum captureState. Where a capture is in its cycle
+ * ARMED -> (trigger) CLAIMED -> TRIGGERED -> (CAPTURE_AFTER samples) FROZEN -> (written out) ARMED
+ */
+
+enum captureState {
+  ARMED,     // recording the history, waiting for a trigger (zero, so every capture starts armed)
+  CLAIMED,   // a trigger is filling in why, still recording like ARMED
+  TRIGGERED, // recording the samples after the trigger
+  FROZEN     // complete, the loop leaves it alone until the drain task has written it
+};
+
+/**
+ * struct captureBuffer
+ * History and trigger of one capture
+ */
+
+struct captureBuffer {
+  telemetryRecord samples[CAPTURE_LENGTH];
+  std::atomic<uint32_t> written; // samples ever recorded (only the loop adds to it)
+  std::atomic<int> state;        // captureState
+
+  // filled in by the trigger before it publishes TRIGGERED
+  uint32_t triggerWritten; // written when the trigger came
+  uint32_t triggerTime;    // us since power on
+  captureReason reason;
+  float value;
+
+  int taken; // records of the frozen capture the drain task has taken (only it touches this)
+};
+
+static captureBuffer captures[CAPTURE_COUNT];
+
+// record the samples of each capture are written as
+static const recordID captureRecords[CAPTURE_COUNT] = {DRIVE_CAPTURE_RECORD, TURN_CAPTURE_RECORD, FLYWHEEL_CAPTURE_RECORD};
+
+static std::atomic<uint32_t> captureCount(0);
+
+void captureSample(captureID capture, float a, float b, float c, float d) {
+  captureBuffer &buffer = captures[capture];
+
+  int state = buffer.state.load(std::memory_order_acquire);
+  if (state == FROZEN)
+    return;
+
+  uint32_t written = buffer.written.load(std::memory_order_relaxed);
+  telemetryRecord &record = buffer.samples[written % CAPTURE_LENGTH];
+  record.time = math3142a::micros32();
+  record.id = captureRecords[capture];
+  record.fields[0] = a;
+  record.fields[1] = b;
+  record.fields[2] = c;
+  record.fields[3] = d;
+  buffer.written.store(++written, std::memory_order_relaxed);
+
+  if (state == TRIGGERED && written - buffer.triggerWritten >= CAPTURE_AFTER)
+    buffer.state.store(FROZEN, std::memory_order_release); // hand it to the drain task
+}
+
+void captureTrigger(captureID capture, captureReason reason, float value) {
+  captureBuffer &buffer = captures[capture];
+
+  int armed = ARMED;
+  if (!buffer.state.compare_exchange_strong(armed, CLAIMED, std::memory_order_acquire))
+    return; // already triggered, or still being written out
+
+  buffer.triggerWritten = buffer.written.load(std::memory_order_relaxed);
+  buffer.triggerTime = math3142a::micros32();
+  buffer.reason = reason;
+  buffer.value = value;
+  buffer.state.store(TRIGGERED, std::memory_order_release);
+}
+
+uint32_t getCaptureCount() { return (captureCount.load()); }
+
+int takeCaptureRecords(telemetryRecord *out, int max) {
+  for (int capture = 0; capture < CAPTURE_COUNT; capture++) {
+    captureBuffer &buffer = captures[capture];
+    if (buffer.state.load(std::memory_order_acquire) != FROZEN)
+      continue;
+
+    // the trigger record, then the samples oldest first. Fewer than CAPTURE_BEFORE if it
+    // triggered right after power on
+    uint32_t written = buffer.written.load(std::memory_order_relaxed);
+    uint32_t sampleCount = written < (uint32_t)CAPTURE_LENGTH ? written : CAPTURE_LENGTH;
+    uint32_t first = written - sampleCount;
+    uint16_t number = (uint16_t)captureCount.load(); // ties the records of one capture together
+
+    int count = 0;
+    if (buffer.taken == 0 && count < max) {
+      telemetryRecord &record = out[count++];
+      record.time = buffer.triggerTime;
+      record.id = CAPTURE_TRIGGER_RECORD;
+      record.sequence = number;
+      record.fields[0] = captureRecords[capture];
+      record.fields[1] = buffer.reason;
+      record.fields[2] = buffer.value;
+      record.fields[3] = buffer.triggerWritten - first; // samples before the trigger
+      buffer.taken = 1;
+    }
+
+    while (buffer.taken <= (int)sampleCount && count < max) {
+      out[count] = buffer.samples[(first + buffer.taken - 1) % CAPTURE_LENGTH];
+      out[count].sequence = number;
+      count++;
+      buffer.taken++;
+    }
+
+    if (buffer.taken > (int)sampleCount) { // all of it is out, record the next one
+      buffer.taken = 0;
+      captureCount.fetch_add(1);
+      buffer.state.store(ARMED, std::memory_order_release);
+    }
+    return (count);
+  }
+  return (0);
+}
+
+} // namespace telemetry3142a
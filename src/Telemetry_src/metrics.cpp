@@ -0,0 +1,218 @@
+#include "Telemetry/metrics.h"
+#include "Config/other-config.h"
+#include "Util/premacros.h"
+#include "Util/timestamp.h"
+#include "Util/vex.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+namespace telemetry3142a {
+
+metricSlot metricSlots[MAX_METRICS + 1]; // the last one is METRICS_FULL
+
+// what each metric is, filled in once by add*
+static const char *metricNames[MAX_METRICS];
+static metricKind metricKinds[MAX_METRICS];
+static const float *metricBounds[MAX_METRICS];
+static int metricBoundCounts[MAX_METRICS];
+
+static std::atomic<int> nextMetric(0);
+
+static metricID addMetric(const char *name, metricKind kind, const float *bounds, int boundCount) {
+  int id = nextMetric.fetch_add(1);
+  if (id >= MAX_METRICS) {
+    LOG_ERROR(GENERAL, "METRICS FULL, NOT SHOWING", name);
+    return METRICS_FULL;
+  }
+
+  metricKinds[id] = kind;
+  metricBounds[id] = bounds;
+  metricBoundCounts[id] = boundCount > HISTOGRAM_BOUNDS ? HISTOGRAM_BOUNDS : boundCount;
+  metricNames[id] = name; // last, a metric without a name is not shown yet
+  return id;
+}
+
+metricID addCounter(const char *name) { return addMetric(name, COUNTER_METRIC, nullptr, 0); }
+
+metricID addGauge(const char *name) { return addMetric(name, GAUGE_METRIC, nullptr, 0); }
+
+metricID addHistogram(const char *name, const float *bounds, int boundCount) {
+  return addMetric(name, HISTOGRAM_METRIC, bounds, boundCount);
+}
+
+void observeMetric(metricID id, float value) {
+  int bucket = 0;
+  if (id < MAX_METRICS) {
+    int boundCount = metricBoundCounts[id];
+    while (bucket < boundCount && value > metricBounds[id][bucket])
+      bucket++;
+  }
+  metricSlots[id].buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+  metricSlots[id].count.fetch_add(1, std::memory_order_relaxed);
+}
+
+void takeSnapshot(metricsSnapshot &snapshot) {
+  snapshot.time = math3142a::millis();
+  snapshot.count = nextMetric.load();
+  if (snapshot.count > MAX_METRICS)
+    snapshot.count = MAX_METRICS;
+
+  for (int i = 0; i < snapshot.count; i++) {
+    metricSlot &slot = metricSlots[i];
+    snapshot.values[i] = metricKinds[i] == GAUGE_METRIC ? slot.gauge.load(std::memory_order_relaxed)
+                                                        : slot.count.load(std::memory_order_relaxed);
+    for (int bucket = 0; bucket <= HISTOGRAM_BOUNDS; bucket++)
+      snapshot.buckets[i][bucket] = slot.buckets[bucket].load(std::memory_order_relaxed);
+  }
+}
+
+// appends to text, keeping track of how much is left
+static void appendText(char *&text, int &size, const char *format, ...) __attribute__((format(printf, 3, 4)));
+
+static void appendText(char *&text, int &size, const char *format, ...) {
+  if (size <= 1)
+    return;
+
+  va_list args;
+  va_start(args, format);
+  int written = vsnprintf(text, size, format, args);
+  va_end(args);
+
+  if (written < 0)
+    return;
+  if (written >= size)
+    written = size - 1;
+  text += written;
+  size -= written;
+}
+
+// "name value", histograms as "name n=<count> <=<bound>:<count> ... ><last bound>:<count>"
+static void formatLine(const metricsSnapshot &snapshot, int index, char *text, int size) {
+  text[0] = '\0';
+  appendText(text, size, "%s ", metricNames[index]);
+
+  if (metricKinds[index] != HISTOGRAM_METRIC) {
+    appendText(text, size, "%g", snapshot.values[index]);
+    return;
+  }
+
+  int boundCount = metricBoundCounts[index];
+  appendText(text, size, "n=%g", snapshot.values[index]);
+  for (int bucket = 0; bucket < boundCount; bucket++)
+    appendText(text, size, " <=%g:%lu", metricBounds[index][bucket], (unsigned long)snapshot.buckets[index][bucket]);
+  appendText(text, size, " >%g:%lu", boundCount ? metricBounds[index][boundCount - 1] : 0.0f,
+             (unsigned long)snapshot.buckets[index][boundCount]);
+}
+
+// metrics sorted by name, so a dump doesn't depend on which task added its metrics first
+static int sortByName(const metricsSnapshot &snapshot, int *order) {
+  int count = 0;
+  for (int i = 0; i < snapshot.count; i++) {
+    if (!metricNames[i])
+      continue;
+    int j = count++;
+    for (; j > 0 && strcmp(metricNames[order[j - 1]], metricNames[i]) > 0; j--)
+      order[j] = order[j - 1];
+    order[j] = i;
+  }
+  return (count);
+}
+
+void printSnapshot(const metricsSnapshot &snapshot) {
+  char line[log3142a::LOG_LINE_SIZE];
+  int order[MAX_METRICS];
+  int count = sortByName(snapshot, order);
+
+  LOG_INFO(GENERAL, "METRICS AT (ms)", snapshot.time);
+  for (int k = 0; k < count; k++) {
+    int i = order[k];
+    formatLine(snapshot, i, line, sizeof(line));
+    LOG_INFO(GENERAL, "METRIC", line);
+  }
+}
+
+void printSnapshotDiff(const metricsSnapshot &before, const metricsSnapshot &after) {
+  LOG_INFO(GENERAL, "METRICS CHANGED OVER (ms)", after.time - before.time);
+
+  for (int i = 0; i < after.count; i++) {
+    if (!metricNames[i])
+      continue;
+
+    // a metric added after the first snapshot was taken started from 0
+    float previous = i < before.count ? before.values[i] : 0;
+    if (after.values[i] == previous)
+      continue;
+
+    if (metricKinds[i] == GAUGE_METRIC) {
+      LOG_INFO(GENERAL, "METRIC", metricNames[i], previous, "->", after.values[i]);
+      continue;
+    }
+
+    LOG_INFO(GENERAL, "METRIC", metricNames[i], "+", after.values[i] - previous);
+    if (metricKinds[i] == HISTOGRAM_METRIC) {
+      for (int bucket = 0; bucket <= metricBoundCounts[i]; bucket++) {
+        uint32_t was = i < before.count ? before.buckets[i][bucket] : 0;
+        if (after.buckets[i][bucket] != was)
+          LOG_INFO(GENERAL, "  BUCKET", bucket, "+", after.buckets[i][bucket] - was);
+      }
+    }
+  }
+}
+
+bool saveSnapshot(const metricsSnapshot &snapshot, const char *fileName) {
+  if (!Brain.SDcard.isInserted())
+    return false;
+
+  static char fileText[MAX_METRICS * 128]; // static, this is far too big for a task's stack
+  char *text = fileText;
+  int size = sizeof(fileText);
+
+  int order[MAX_METRICS];
+  int count = sortByName(snapshot, order);
+  for (int k = 0; k < count; k++) {
+    int i = order[k];
+    formatLine(snapshot, i, text, size);
+    int length = strlen(text);
+    text += length;
+    size -= length;
+    appendText(text, size, "\n");
+  }
+
+  int length = text - fileText;
+  return (Brain.SDcard.savefile(fileName, (uint8_t *)fileText, length) == length);
+}
+
+void formatMetric(const metricsSnapshot &snapshot, int index, char *text, int size) {
+  if (index < 0 || index >= snapshot.count || !metricNames[index]) {
+    text[0] = '\0';
+    return;
+  }
+
+  if (metricKinds[index] != HISTOGRAM_METRIC) {
+    snprintf(text, size, "%s %g", metricNames[index], snapshot.values[index]);
+    return;
+  }
+
+  if (snapshot.values[index] == 0) {
+    snprintf(text, size, "%s n=0", metricNames[index]);
+    return;
+  }
+
+  // not enough room for the buckets, show where the middle value fell
+  uint32_t half = (uint32_t)snapshot.values[index] / 2;
+  uint32_t seen = 0;
+  int bucket = 0;
+  for (; bucket < metricBoundCounts[index]; bucket++) {
+    seen += snapshot.buckets[index][bucket];
+    if (seen > half)
+      break;
+  }
+  if (bucket < metricBoundCounts[index])
+    snprintf(text, size, "%s n=%g p50<=%g", metricNames[index], snapshot.values[index], metricBounds[index][bucket]);
+  else
+    snprintf(text, size, "%s n=%g p50>%g", metricNames[index], snapshot.values[index],
+             metricBoundCounts[index] ? metricBounds[index][metricBoundCounts[index] - 1] : 0.0f);
+}
+
+} // namespace telemetry3142a
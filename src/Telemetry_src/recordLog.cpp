@@ -0,0 +1,144 @@
+#include "Telemetry/recordLog.h"
+#include "Telemetry/capture.h"
+#include "Telemetry/serialFrame.h"
+#include "Config/other-config.h"
+#include "Util/timestamp.h"
+#include "Util/vex.h"
+
+namespace telemetry3142a {
+
+/**
+ * struct recordSlot
+ * A record plus the turn number that says who may touch it next
+ *
+ * A bounded multi producer queue (the one from Dmitry Vyukov). For the slot at position p:
+ * turn == p means it is free for the writer that claims position p, turn == p + 1 means that
+ * writer has finished and the drain task may read it, and the drain task sets turn = p + RING_SIZE
+ * to hand it to the writer one lap later. Every slot starts free for the first lap (turn == index)
+ */
+
+struct recordSlot {
+  std::atomic<uint32_t> turn; // stored minus the slot's index, so the zeroed ring starts out right
+  telemetryRecord record;
+};
+
+// the RAM figure next to RECORD_RING_SIZE counts on this
+static_assert(sizeof(recordSlot) == RECORD_SLOT_SIZE, "a ring slot is the turn word and a record");
+
+static recordSlot ring[RECORD_RING_SIZE];
+static std::atomic<uint32_t> writePosition(0); // next position a writer claims
+static uint32_t readPosition = 0;              // next position the drain task reads (only it touches this)
+
+static std::atomic<uint32_t> dropped(0);
+static std::atomic<uint16_t> sequence(0);
+static std::atomic<int> sink(SD_CARD_SINK);
+
+// batch being written, header first so it goes out in one write
+static struct {
+  recordBatchHeader header;
+  telemetryRecord records[RECORD_BATCH_SIZE];
+} batch;
+
+static_assert(sizeof(batch) == sizeof(recordBatchHeader) + RECORD_BATCH_SIZE * sizeof(telemetryRecord),
+              "the batch has to be written without padding");
+static_assert(sizeof(batch) <= MAX_FRAME_PAYLOAD, "a full batch has to fit in one serial frame");
+
+static const char *recordNames[RECORD_COUNT] = {
+#define TELEMETRY_RECORD_NAME(name, f1, f2, f3, f4) #name,
+    TELEMETRY_RECORDS(TELEMETRY_RECORD_NAME)
+#undef TELEMETRY_RECORD_NAME
+};
+
+bool logRecord(recordID id, float a, float b, float c, float d) {
+  uint16_t number = sequence.fetch_add(1, std::memory_order_relaxed); // taken even if dropped, so drops leave a gap
+  uint32_t position = writePosition.load(std::memory_order_relaxed);
+  recordSlot *slot;
+
+  while (true) {
+    uint32_t index = position % RECORD_RING_SIZE;
+    slot = &ring[index];
+    int32_t lag = (int32_t)(slot->turn.load(std::memory_order_acquire) + index - position);
+
+    if (lag == 0) { // free, try to claim it (on failure position is reloaded and we go again)
+      if (writePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+        break;
+    } else if (lag < 0) { // the drain task hasn't emptied this slot yet, the ring is full
+      dropped.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    } else { // another writer claimed it first
+      position = writePosition.load(std::memory_order_relaxed);
+    }
+  }
+
+  telemetryRecord &record = slot->record;
+  record.time = math3142a::micros32();
+  record.id = id;
+  record.sequence = number;
+  record.fields[0] = a;
+  record.fields[1] = b;
+  record.fields[2] = c;
+  record.fields[3] = d;
+
+  slot->turn.store(position + 1 - position % RECORD_RING_SIZE, std::memory_order_release); // publish it to the drain task
+  return true;
+}
+
+void setRecordSink(recordSink newSink) { sink.store(newSink); }
+
+uint32_t getDroppedRecords() { return (dropped.load()); }
+
+const char *getRecordName(recordID id) { return (id < RECORD_COUNT ? recordNames[id] : "?"); }
+
+// moves up to RECORD_BATCH_SIZE finished records into the batch, returns how many
+static int takeRecords() {
+  int count = 0;
+  while (count < RECORD_BATCH_SIZE) {
+    uint32_t index = readPosition % RECORD_RING_SIZE;
+    recordSlot &slot = ring[index];
+    if (slot.turn.load(std::memory_order_acquire) + index != readPosition + 1)
+      break; // empty, or the writer that claimed it is still filling it in
+
+    batch.records[count++] = slot.record;
+    slot.turn.store(readPosition + RECORD_RING_SIZE - index, std::memory_order_release);
+    readPosition++;
+  }
+  return (count);
+}
+
+static void writeBatch(int count) {
+  batch.header.magic = RECORD_BATCH_MAGIC;
+  batch.header.count = count;
+  batch.header.size = sizeof(telemetryRecord);
+  batch.header.dropped = dropped.load();
+
+  int length = sizeof(recordBatchHeader) + count * sizeof(telemetryRecord);
+
+  switch (sink.load()) {
+  case SD_CARD_SINK:
+    if (Brain.SDcard.isInserted())
+      Brain.SDcard.appendfile(RECORD_FILE, (uint8_t *)&batch, length);
+    break;
+  case SERIAL_SINK: // framed, so the host can tell it from the log lines and see what it lost
+    sendFrame(RECORD_BATCH_FRAME, &batch, length);
+    break;
+  default:
+    break;
+  }
+}
+
+int recordDrainTask() {
+  while (true) {
+    int count;
+    while ((count = takeRecords()) > 0)
+      writeBatch(count);
+
+    // frozen captures go out the same way, a batch at a time
+    while ((count = takeCaptureRecords(batch.records, RECORD_BATCH_SIZE)) > 0)
+      writeBatch(count);
+
+    task::sleep(RECORD_DRAIN_MS);
+  }
+  return 0;
+}
+
+} // namespace telemetry3142a
@@ -0,0 +1,71 @@
+#include "Telemetry/serialFrame.h"
+#include "Util/premacros.h"
+#include <string.h>
+
+namespace telemetry3142a {
+
+// the frame before COBS, and after
+static uint8_t rawFrame[3 + MAX_FRAME_PAYLOAD + 2];
+static uint8_t wireFrame[MAX_FRAME_SIZE];
+
+static uint16_t nextSequence = 0;
+
+uint16_t crc16(const uint8_t *data, int length, uint16_t crc) {
+  for (int i = 0; i < length; i++) {
+    crc ^= (uint16_t)data[i] << 8;
+    for (int bit = 0; bit < 8; bit++)
+      crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+  }
+  return (crc);
+}
+
+// COBS: every 0 is replaced by the distance to the next one, each run starting with its length byte
+static int cobsEncode(const uint8_t *in, int length, uint8_t *out) {
+  int codeAt = 0; // where the length byte of the current run goes
+  int written = 1;
+  uint8_t code = 1;
+
+  for (int i = 0; i < length; i++) {
+    if (in[i] != 0) {
+      out[written++] = in[i];
+      code++;
+    }
+    if (in[i] == 0 || code == 0xFF) { // end of a run: a real 0, or the longest run COBS allows
+      out[codeAt] = code;
+      codeAt = written++;
+      code = 1;
+    }
+  }
+  out[codeAt] = code;
+  return (written);
+}
+
+int encodeFrame(frameType type, uint16_t sequence, const void *payload, int length, uint8_t *out) {
+  if (length < 0 || length > MAX_FRAME_PAYLOAD)
+    return 0;
+
+  rawFrame[0] = sequence & 0xFF;
+  rawFrame[1] = sequence >> 8;
+  rawFrame[2] = type;
+  memcpy(rawFrame + 3, payload, length);
+
+  uint16_t crc = crc16(rawFrame, 3 + length);
+  rawFrame[3 + length] = crc & 0xFF;
+  rawFrame[4 + length] = crc >> 8;
+
+  int size = cobsEncode(rawFrame, 5 + length, out);
+  out[size++] = 0; // end of frame
+  return (size);
+}
+
+bool sendFrame(frameType type, const void *payload, int length) {
+  int size = encodeFrame(type, nextSequence, payload, length, wireFrame);
+  if (size == 0)
+    return false;
+
+  nextSequence++;
+  log3142a::writeSerial(wireFrame, size); // shares the port with the log lines, a frame is never split
+  return true;
+}
+
+} // namespace telemetry3142a
@@ -0,0 +1,25 @@
+#include "Telemetry/telemetry.h"
+
+namespace telemetry3142a {
+
+SignalRing signalRings[SIGNAL_COUNT];
+
+int decimationCounts[SIGNAL_COUNT]; // samples seen since the last one we kept (per signal)
+
+const char *signalNames[SIGNAL_COUNT] = {
+    "profile", "measured", "left V", "right V", "heading", "fly rpm",
+};
+
+void record(signalID signal, float value) {
+  if (++decimationCounts[signal] < DECIMATION)
+    return;
+
+  decimationCounts[signal] = 0;
+  signalRings[signal].push(value);
+}
+
+const SignalRing &getSignal(signalID signal) { return (signalRings[signal]); }
+
+const char *getSignalName(signalID signal) { return (signalNames[signal]); }
+
+}
@@ -0,0 +1,149 @@
+#include "Util/allocTracker.h"
+#include "Util/premacros.h"
+#include "Util/vex.h"
+#include <atomic>
+#include <new>
+#include <stdlib.h>
+
+namespace math3142a {
+
+// plain atomics with constant initializers, so they are ready before any static constructor allocates
+static std::atomic<uint32_t> allocations(0);
+static std::atomic<uint32_t> frees(0);
+static std::atomic<uint32_t> allocatedBytes(0);
+static std::atomic<uint32_t> criticalAllocations(0);
+static std::atomic<uint32_t> largestCritical(0);
+
+static std::atomic<int> mode(ALLOCATION_REPORT);
+
+/**
+ * struct sectionSlot. A task inside a section. Several tasks can be in a section at once
+ * (a chassis motion and a mechanism loop), each gets its own slot. Sections nested inside the
+ * outermost one of a task share its slot
+ */
+
+struct sectionSlot {
+  std::atomic<int32_t> owner;        // task id + 1, 0 while the slot is free
+  std::atomic<uint32_t> allocations; // made by the owner while it had a section open
+};
+
+static const int SECTION_SLOTS = 8; // tasks that can be in a section at the same time
+static sectionSlot sectionSlots[SECTION_SLOTS]; // zero initialized, so free before any constructor runs
+static std::atomic<int> openSlots(0);           // slots in use, so allocations outside any section stay cheap
+
+/// the slot of the task with that (id + 1), NULL if it has no section open
+static sectionSlot *findSlot(int32_t owner) {
+  for (int i = 0; i < SECTION_SLOTS; i++) {
+    if (sectionSlots[i].owner.load(std::memory_order_relaxed) == owner)
+      return &sectionSlots[i];
+  }
+  return NULL;
+}
+
+static void countAllocation(size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  allocatedBytes.fetch_add((uint32_t)size, std::memory_order_relaxed);
+
+  // the display and telemetry tasks can allocate all they want, only tasks inside a section count
+  if (openSlots.load(std::memory_order_relaxed) == 0)
+    return;
+  sectionSlot *slot = findSlot(this_thread::get_id() + 1);
+  if (!slot)
+    return;
+
+  if (mode.load(std::memory_order_relaxed) == ALLOCATION_TRAP)
+    __builtin_trap(); // look one frame up in the debugger for the allocation
+
+  criticalAllocations.fetch_add(1, std::memory_order_relaxed);
+  slot->allocations.fetch_add(1, std::memory_order_relaxed);
+  uint32_t largest = largestCritical.load(std::memory_order_relaxed);
+  while (size > largest && !largestCritical.compare_exchange_weak(largest, (uint32_t)size))
+    ;
+}
+
+// NULL if the heap is out, for the nothrow news
+static void *tryAllocate(size_t size) {
+  countAllocation(size);
+  return malloc(size ? size : 1);
+}
+
+static void *allocate(size_t size) {
+  void *ptr = tryAllocate(size);
+  if (!ptr) // no exceptions on the brain, and nothing good comes after running out of heap
+    abort();
+  return ptr;
+}
+
+static void release(void *ptr) {
+  if (!ptr)
+    return;
+  frees.fetch_add(1, std::memory_order_relaxed);
+  free(ptr);
+}
+
+void setAllocationMode(allocationMode newMode) { mode.store(newMode); }
+
+allocationStats getAllocationStats() {
+  allocationStats stats;
+  stats.allocations = allocations.load();
+  stats.frees = frees.load();
+  stats.allocatedBytes = allocatedBytes.load();
+  stats.criticalAllocations = criticalAllocations.load();
+  stats.largestCritical = largestCritical.load();
+  return stats;
+}
+
+void printAllocationStats() {
+  allocationStats stats = getAllocationStats();
+  LOG("ALLOCATIONS", stats.allocations, "FREES", stats.frees);
+  LOG("ALLOCATED (bytes)", stats.allocatedBytes);
+  LOG("CONTROL ALLOCATIONS", stats.criticalAllocations, "LARGEST (bytes)", stats.largestCritical);
+}
+
+ControlCriticalSection::ControlCriticalSection(const char *name) : m_name(name), m_startCount(0), m_slot(NULL), m_outermost(false) {
+  const int32_t self = this_thread::get_id() + 1;
+  m_slot = findSlot(self);
+  if (!m_slot) { // the outermost section of this task, claim a free slot
+    for (int i = 0; i < SECTION_SLOTS && !m_slot; i++) {
+      int32_t unused = 0;
+      if (sectionSlots[i].owner.compare_exchange_strong(unused, self))
+        m_slot = &sectionSlots[i];
+    }
+    if (!m_slot) {
+      LOG_ERROR(GENERAL, "TOO MANY CONTROL SECTIONS, NOT TRACKING", m_name);
+      return;
+    }
+    m_outermost = true;
+    openSlots.fetch_add(1);
+  }
+  m_startCount = m_slot->allocations.load();
+}
+
+ControlCriticalSection::~ControlCriticalSection() {
+  if (!m_outermost) // nested (the outermost one reports), or not tracked
+    return;
+
+  // the section is closed now, so nothing the report does is counted against it
+  uint32_t count = m_slot->allocations.load() - m_startCount;
+  m_slot->owner.store(0);
+  openSlots.fetch_sub(1);
+
+  if (count > 0)
+    LOG_ERROR(GENERAL, "HEAP USED IN", m_name, count, "ALLOCATIONS");
+}
+
+} // namespace math3142a
+
+// every new and delete in the program ends up here (the library versions are weak)
+
+void *operator new(size_t size) { return math3142a::allocate(size); }
+void *operator new[](size_t size) { return math3142a::allocate(size); }
+void *operator new(size_t size, const std::nothrow_t &) noexcept { return math3142a::tryAllocate(size); }
+void *operator new[](size_t size, const std::nothrow_t &) noexcept { return math3142a::tryAllocate(size); }
+
+void operator delete(void *ptr) noexcept { math3142a::release(ptr); }
+void operator delete[](void *ptr) noexcept { math3142a::release(ptr); }
+void operator delete(void *ptr, size_t) noexcept { math3142a::release(ptr); }
+void operator delete[](void *ptr, size_t) noexcept { math3142a::release(ptr); }
+void operator delete(void *ptr, const std::nothrow_t &) noexcept { math3142a::release(ptr); }
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept { math3142a::release(ptr); }
@@ -0,0 +1,79 @@
+#include "Util/controllerDisplay.h"
+#include "Config/other-config.h"
+#include <atomic>
+#include <stdarg.h>
+
+namespace display3142a {
+
+/**
+ * struct controllerLine
+ * What we want on a line and what is on it
+ */
+
+struct controllerLine {
+  char pending[CONTROLLER_COLUMNS + 1]; // newest text posted
+  char sent[CONTROLLER_COLUMNS + 1];    // text on the controller
+  bool everSent;                        // false until the line is written once
+};
+
+controllerLine lines[CONTROLLER_ROWS];
+
+// guards the pending text. Only held for a copy of 20 bytes, so posting never really waits
+std::atomic_flag linesLock = ATOMIC_FLAG_INIT;
+
+static void lockLines() {
+  while (linesLock.test_and_set(std::memory_order_acquire)) {
+    this_thread::yield();
+  }
+}
+
+static void unlockLines() { linesLock.clear(std::memory_order_release); }
+
+void postControllerLine(int row, const char *format, ...) {
+  if (row < 1 || row > CONTROLLER_ROWS)
+    return;
+
+  // format outside the lock
+  char text[CONTROLLER_COLUMNS + 1];
+  va_list args;
+  va_start(args, format);
+  vsnprintf(text, sizeof(text), format, args);
+  va_end(args);
+
+  lockLines();
+  strcpy(lines[row - 1].pending, text);
+  unlockLines();
+}
+
+int controllerDisplayTask() {
+  int row = 0;
+
+  while (true) {
+    // look for the next line that changed, starting after the one we sent last (round robin)
+    for (int checked = 0; checked < CONTROLLER_ROWS; checked++) {
+      row = (row + 1) % CONTROLLER_ROWS;
+      controllerLine &line = lines[row];
+
+      char text[CONTROLLER_COLUMNS + 1];
+      lockLines();
+      strcpy(text, line.pending);
+      unlockLines();
+
+      if (line.everSent && strcmp(text, line.sent) == 0)
+        continue;
+
+      // pad with spaces so the old text is overwritten without a separate clearLine
+      BigBrother.Screen.setCursor(row + 1, 1);
+      BigBrother.Screen.print("%-*s", CONTROLLER_COLUMNS, text);
+
+      strcpy(line.sent, text);
+      line.everSent = true;
+      break; // one write per slot, the link can't take more
+    }
+
+    task::sleep(CONTROLLER_WRITE_MS);
+  }
+  return 0;
+}
+
+}
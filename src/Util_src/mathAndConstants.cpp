@@ -1,5 +1,6 @@
 #include "Util/vex.h"
 #include "Util/mathAndConstants.h"
+#include "Util/fastMath.h"
 double positionArray[3];
 namespace math3142a {
 
@@ -13,12 +14,12 @@ int sgn(double num) {
 
 double cosDegrees(double value)
 {
-  return (cos(value * (M_PI / 180)));
+  return (trigCos(value * (M_PI / 180)));
 }
 
 double sinDegrees(double value)
 {
-  return (sin(value * (M_PI / 180)));
+  return (trigSin(value * (M_PI / 180)));
 }
 
 double toDegrees(double angle)
@@ -0,0 +1,190 @@
+#include "Util/premacros.h"
+#include "Util/timestamp.h"
+#include "Util/vex.h"
+#include <atomic>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+namespace log3142a {
+
+// lines waiting to be written out
+static char pending[LOG_BUFFER_SIZE];
+static int pendingLength = 0;
+
+// what flushLog is writing out, so the serial port is only touched outside the pending lock
+static char sending[LOG_BUFFER_SIZE];
+
+// guards pending. Held for a copy, so a control loop logging never really waits
+static std::atomic_flag pendingLock = ATOMIC_FLAG_INIT;
+// guards sending, only one task flushes at a time, so lines stay in order
+static std::atomic_flag sendingLock = ATOMIC_FLAG_INIT;
+// the serial port itself. The log task, urgent logs and the telemetry frames all write to it
+static std::atomic_flag serialLock = ATOMIC_FLAG_INIT;
+
+// lines that didn't fit in pending, and how many of them flushLog has already reported
+static std::atomic<uint32_t> dropped(0);
+static uint32_t droppedReported = 0; // only touched under sendingLock
+
+static void lock(std::atomic_flag &flag) {
+  while (flag.test_and_set(std::memory_order_acquire)) {
+    this_thread::yield();
+  }
+}
+
+static void unlock(std::atomic_flag &flag) { flag.clear(std::memory_order_release); }
+
+// snprintf into whatever is left of the line, cutting it if it is full
+static void appendFormatted(logLine &line, const char *format, ...) __attribute__((format(printf, 2, 3)));
+
+static void appendFormatted(logLine &line, const char *format, ...) {
+  int space = LOG_LINE_SIZE - line.length;
+  if (space <= 1)
+    return;
+
+  va_list args;
+  va_start(args, format);
+  int written = vsnprintf(line.text + line.length, space, format, args);
+  va_end(args);
+
+  if (written > 0)
+    line.length += (written < space) ? written : space - 1;
+}
+
+// copies into whatever is left of the line, cutting it if it is full
+static void appendBytes(logLine &line, const char *bytes, int count) {
+  int space = LOG_LINE_SIZE - 1 - line.length; // a byte is always left for the newline
+  if (count > space)
+    count = space;
+  if (count > 0) {
+    memcpy(line.text + line.length, bytes, count);
+    line.length += count;
+  }
+}
+
+// the integers and the timestamp skip snprintf, parsing the format was most of a line's cost.
+// Digits are split off with a multiply: at -Os gcc divides by 10 with a real divide, and the
+// brain's Cortex-A9 has no divide instruction at all
+static void appendDigits(logLine &line, bool negative, unsigned long long value, int minDigits) {
+  char digits[24];
+  int start = sizeof(digits);
+  while (value > 0xFFFFFFFFull) { // only numbers past 32 bits take the slow way
+    digits[--start] = (char)('0' + value % 10);
+    value /= 10;
+  }
+  uint32_t rest = (uint32_t)value;
+  do {
+    uint32_t tenth = (uint32_t)(((uint64_t)rest * 0xCCCCCCCDull) >> 35); // rest / 10, exact for 32 bits
+    digits[--start] = (char)('0' + (rest - tenth * 10));
+    rest = tenth;
+  } while (rest != 0 || (int)sizeof(digits) - start < minDigits);
+  if (negative)
+    digits[--start] = '-';
+  appendBytes(line, digits + start, sizeof(digits) - start);
+}
+
+template <class T>
+static void appendSigned(logLine &line, T value) {
+  // negated as unsigned, so the most negative value doesn't overflow
+  unsigned long long magnitude = (unsigned long long)value;
+  appendDigits(line, value < 0, value < 0 ? 0 - magnitude : magnitude, 1);
+}
+
+void append(logLine &line, const char *value) {
+  if (!value)
+    value = "(null)";
+  appendBytes(line, value, strlen(value));
+}
+void append(logLine &line, char value) { appendBytes(line, &value, 1); }
+void append(logLine &line, bool value) { appendDigits(line, false, value ? 1 : 0, 1); } // like cout did
+void append(logLine &line, int value) { appendSigned(line, value); }
+void append(logLine &line, unsigned int value) { appendDigits(line, false, value, 1); }
+void append(logLine &line, long value) { appendSigned(line, value); }
+void append(logLine &line, unsigned long value) { appendDigits(line, false, value, 1); }
+void append(logLine &line, long long value) { appendSigned(line, value); }
+void append(logLine &line, unsigned long long value) { appendDigits(line, false, value, 1); }
+void append(logLine &line, double value) { appendFormatted(line, "%g", value); } // same 6 digits as cout
+
+void appendTimestamp(logLine &line) {
+  uint64_t now = math3142a::micros();
+  appendDigits(line, false, now / 1000000, 1);
+  append(line, '.');
+  appendDigits(line, false, now % 1000000, 6);
+  append(line, ' ');
+}
+
+void queueLine(logLine &line, bool urgent) {
+  // there is always room for the newline, the appends leave a byte for it
+  line.text[line.length++] = '\n';
+
+  lock(pendingLock);
+  if (pendingLength + line.length > LOG_BUFFER_SIZE) {
+    unlock(pendingLock);
+    if (!urgent) {
+      // logging faster than the log task empties it. Drop the line rather than write the buffer
+      // out from here, the caller may be a control loop (like logRecord does)
+      dropped.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    // an urgent line is written out by its caller anyway, make room for it first
+    flushLog();
+    lock(pendingLock);
+    if (pendingLength + line.length > LOG_BUFFER_SIZE) { // filled up again in between
+      unlock(pendingLock);
+      dropped.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+  }
+  memcpy(pending + pendingLength, line.text, line.length);
+  pendingLength += line.length;
+  unlock(pendingLock);
+
+  if (urgent)
+    flushLog();
+}
+
+void flushLog() {
+  lock(sendingLock);
+
+  lock(pendingLock);
+  int length = pendingLength;
+  memcpy(sending, pending, length);
+  pendingLength = 0;
+  unlock(pendingLock);
+
+  if (length > 0)
+    writeSerial(sending, length);
+
+  // say how many lines went missing, after the ones that made it
+  uint32_t droppedNow = dropped.load(std::memory_order_relaxed);
+  if (droppedNow != droppedReported) {
+    logLine note;
+    note.length = 0;
+    appendTimestamp(note);
+    appendAll(note, "LOG DROPPED", (unsigned long)(droppedNow - droppedReported));
+    note.text[note.length++] = '\n';
+    writeSerial(note.text, note.length);
+    droppedReported = droppedNow;
+  }
+
+  unlock(sendingLock);
+}
+
+uint32_t getDroppedLogLines() { return (dropped.load()); }
+
+void writeSerial(const void *data, int length) {
+  lock(serialLock);
+  fwrite(data, 1, length, stdout);
+  fflush(stdout);
+  unlock(serialLock);
+}
+
+int logTask() {
+  while (true) {
+    flushLog();
+    task::sleep(LOG_FLUSH_MS);
+  }
+  return 0;
+}
+
+} // namespace log3142a
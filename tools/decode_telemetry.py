@@ -0,0 +1,116 @@
+#!/usr/bin/env python3
+"""Decodes the binary telemetry records (include/Telemetry/recordLog.h) into CSV.
+
+The record names and field names come from TELEMETRY_RECORDS in include/Telemetry/recordDefs.h,
+so a record added there shows up here without touching this script.
+
+    python3 tools/decode_telemetry.py telemetry.bin -o telemetry_csv
+
+writes one <RECORD>.csv per record (time_us, sequence and the named fields). In the *_CAPTURE_RECORD
+files and CAPTURE_TRIGGER_RECORD.csv the sequence column is the capture number instead, so each
+triggered capture can be picked out on its own. The input is the telemetry.bin from the SD card
+(the USB serial stream is framed, tools/telemetry_client.py reads that one).
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+BATCH_MAGIC = 0x52323431
+BATCH_HEADER = struct.Struct("<IHHI")  # recordBatchHeader
+RECORD = struct.Struct("<IHH4f")       # telemetryRecord
+
+DEFAULT_DEFS = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "include", "Telemetry", "recordDefs.h")
+
+
+def load_schema(path):
+    """Returns [(record name, [field names])] in recordID order."""
+    with open(path) as f:
+        text = f.read()
+    body = text[text.index("#define TELEMETRY_RECORDS"):]
+    schema = []
+    for match in re.finditer(r"X\(\s*(\w+)\s*,([^)]*)\)", body):
+        fields = [field.strip().strip('"') for field in match.group(2).split(",")]
+        schema.append((match.group(1), fields))
+    if not schema:
+        sys.exit("no records found in " + path)
+    return schema
+
+
+def read_batches(data):
+    """Yields (dropped, [records]) for every batch found in data."""
+    magic = struct.pack("<I", BATCH_MAGIC)
+    offset = data.find(magic)
+    while offset >= 0:
+        if offset + BATCH_HEADER.size > len(data):
+            break
+        _, count, size, dropped = BATCH_HEADER.unpack_from(data, offset)
+        end = offset + BATCH_HEADER.size + count * size
+        if size != RECORD.size or end > len(data):  # not really a header, or cut off at the end
+            offset = data.find(magic, offset + 1)
+            continue
+        records = [RECORD.unpack_from(data, offset + BATCH_HEADER.size + i * size) for i in range(count)]
+        yield dropped, records
+        offset = data.find(magic, end)
+
+
+class RecordCsv:
+    """Writes records into one <RECORD>.csv per record, with the column names from the schema."""
+
+    def __init__(self, schema, directory):
+        self.schema = schema
+        self.directory = directory
+        self.files = {}
+        self.counts = {}
+        os.makedirs(directory, exist_ok=True)
+
+    def write(self, record):
+        time, record_id, sequence, *values = record
+        if record_id >= len(self.schema):
+            name, fields = "RECORD_%d" % record_id, ["field1", "field2", "field3", "field4"]
+        else:
+            name, fields = self.schema[record_id]
+        if name not in self.files:
+            out = open(os.path.join(self.directory, name + ".csv"), "w")
+            used = [field for field in fields if field]
+            out.write(",".join(["time_us", "sequence"] + used) + "\n")
+            self.files[name] = (out, [i for i, field in enumerate(fields) if field])
+        out, columns = self.files[name]
+        out.write("%d,%d,%s\n" % (time, sequence, ",".join("%g" % values[i] for i in columns)))
+        self.counts[name] = self.counts.get(name, 0) + 1
+
+    def close(self):
+        for out, _ in self.files.values():
+            out.close()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("input", help="telemetry.bin from the SD card")
+    parser.add_argument("-o", "--output", default="telemetry_csv", help="directory for the CSV files")
+    parser.add_argument("--defs", default=DEFAULT_DEFS, help="recordDefs.h to take the schema from")
+    args = parser.parse_args()
+
+    schema = load_schema(args.defs)
+    with open(args.input, "rb") as f:
+        data = f.read()
+
+    csv = RecordCsv(schema, args.output)
+    batches = 0
+    dropped = 0
+    for batch_dropped, records in read_batches(data):
+        batches += 1
+        dropped = max(dropped, batch_dropped)
+        for record in records:
+            csv.write(record)
+    csv.close()
+
+    print("%d batches, %d dropped on the brain" % (batches, dropped))
+    for name in sorted(csv.counts):
+        print("  %-24s %d records" % (name, csv.counts[name]))
+
+
+if __name__ == "__main__":
+    main()
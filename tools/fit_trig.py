@@ -0,0 +1,66 @@
+#!/usr/bin/env python3
+"""Fits the polynomials of the fast trig kernels (include/Util/fastMath.h).
+
+    python3 tools/fit_trig.py
+
+prints the coefficients to paste into fastMath.h and the largest error of each polynomial over its
+reduced range, evaluated in the precision the kernel uses (float or double, Horner's rule like the
+C++). Both polynomials are odd, x * (c0 + c1 x^2 + c2 x^4 + ...), so they are fitted in x^2:
+
+    sin   on [0, pi/2]             (the kernels fold every angle into [-pi/2, pi/2] first)
+    atan  on [0, tan(pi/8)]        (atan2 folds y/x into [0, 1], then shifts [tan(pi/8), 1] down by pi/4)
+
+The fit is Lawson's reweighted least squares, which ends up within a hair of the minimax polynomial.
+Needs numpy.
+"""
+
+import numpy as np
+
+# (name, function, end of the range, [(precision, number of coefficients)])
+KERNELS = [
+    ("SIN", np.sin, np.pi / 2, [(np.float32, 4), (np.float64, 7)]),
+    ("ATAN", np.arctan, np.sqrt(2) - 1, [(np.float32, 4), (np.float64, 8)]),
+]
+
+
+def fit(function, end, terms, iterations=300, points=4000):
+    x = end / 2 + end / 2 * np.cos(np.pi * (np.arange(points) + 0.5) / points)  # Chebyshev nodes
+    powers = np.stack([x ** (2 * k + 1) for k in range(terms)], 1)
+    target = function(x)
+    weights = np.ones(points) / points
+    for _ in range(iterations):
+        root = np.sqrt(weights)
+        coefficients = np.linalg.lstsq(powers * root[:, None], target * root, rcond=None)[0]
+        weights *= np.abs(powers @ coefficients - target)
+        weights /= weights.sum()
+    return coefficients
+
+
+def evaluate(coefficients, x, precision):
+    """Horner in x^2, in the kernel's precision."""
+    x = x.astype(precision)
+    x2 = x * x
+    result = np.full_like(x, coefficients[-1])
+    for c in coefficients[-2::-1]:
+        result = result * x2 + precision(c)
+    return result * x
+
+
+def main():
+    x = np.linspace(0, 1, 1000001)
+    for name, function, end, variants in KERNELS:
+        for precision, terms in variants:
+            coefficients = fit(function, end, terms)
+            coefficients = [precision(c) for c in coefficients]
+            points = x * end
+            error = np.max(np.abs(evaluate(coefficients, points, precision).astype(np.float64) - function(points)))
+            suffix = "_F" if precision == np.float32 else ""
+            literal = "%.9ef" if precision == np.float32 else "%.17e"
+            print("// %s, degree %d, largest error %.2e" % (precision.__name__, 2 * terms - 1, error))
+            print("const %s %s%s[] = {%s};" % ("float" if precision == np.float32 else "double", name, suffix,
+                                               ", ".join(literal % c for c in coefficients)))
+            print()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,316 @@
+#!/usr/bin/env python3
+"""Reads the framed telemetry stream from the brain's USB serial port (include/Telemetry/serialFrame.h).
+
+    python3 tools/telemetry_client.py /dev/ttyACM1 --csv run1              record every record to CSV
+    python3 tools/telemetry_client.py /dev/ttyACM1 --plot DRIVE_STRAIGHT_RECORD.profilePosition \\
+                                                      --plot DRIVE_STRAIGHT_RECORD.measuredPosition
+    python3 tools/telemetry_client.py --selftest                           loopback through a pseudo terminal
+
+The brain only streams once the record sink is set to SERIAL_SINK (telemetry3142a::setRecordSink).
+Lines that are not frames (the LOG output on the same port) are printed as they come. Lost frames
+(gaps in the sequence numbers), bad CRCs and records the brain had to drop are counted and printed
+when the client stops. Plotting needs matplotlib, nothing else does.
+"""
+
+import argparse
+import os
+import select
+import struct
+import sys
+import threading
+import time
+import tty
+
+import decode_telemetry
+from decode_telemetry import BATCH_HEADER, BATCH_MAGIC, DEFAULT_DEFS, RECORD
+
+RECORD_BATCH_FRAME = 1
+
+
+def crc16(data, crc=0xFFFF):
+    """CRC-16/CCITT-FALSE, the same as telemetry3142a::crc16."""
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def cobs_encode(data):
+    out = bytearray([0])
+    code_at = 0
+    code = 1
+    for byte in data:
+        if byte:
+            out.append(byte)
+            code += 1
+        if not byte or code == 0xFF:
+            out[code_at] = code
+            code_at = len(out)
+            out.append(0)
+            code = 1
+    out[code_at] = code
+    return bytes(out)
+
+
+def cobs_decode(data):
+    """Returns the decoded bytes, or None if data is not valid COBS."""
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0 or i + code > len(data):
+            return None
+        out += data[i + 1:i + code]
+        i += code
+        if code < 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def encode_frame(frame_type, sequence, payload):
+    """Builds a frame like telemetry3142a::encodeFrame (used by the self test)."""
+    raw = struct.pack("<HB", sequence & 0xFFFF, frame_type) + payload
+    raw += struct.pack("<H", crc16(raw))
+    return cobs_encode(raw) + b"\0"
+
+
+class FrameReader:
+    """Splits the byte stream at the 0 bytes and checks each frame."""
+
+    def __init__(self, on_records, on_text):
+        self.on_records = on_records
+        self.on_text = on_text
+        self.pending = bytearray()
+        self.last_sequence = None
+        self.frames = 0
+        self.lost = 0
+        self.bad = 0
+        self.brain_dropped = 0
+
+    def feed(self, data):
+        self.pending += data
+        while True:
+            end = self.pending.find(0)
+            if end < 0:
+                break
+            chunk = bytes(self.pending[:end])
+            del self.pending[:end + 1]
+            if chunk:
+                self.handle(chunk)
+
+    @staticmethod
+    def check(chunk):
+        """Returns the frame without COBS if chunk is a good frame, otherwise None."""
+        raw = cobs_decode(chunk)
+        if raw is None or len(raw) < 5 or crc16(raw[:-2]) != struct.unpack_from("<H", raw, len(raw) - 2)[0]:
+            return None
+        return raw
+
+    def handle(self, chunk):
+        raw = self.check(chunk)
+        text = b""
+        if raw is None:
+            # LOG lines have no 0 at the end, so they come stuck to the front of the next frame
+            newline = chunk.find(b"\n")
+            while newline >= 0 and raw is None:
+                raw = self.check(chunk[newline + 1:])
+                if raw is not None:
+                    text = chunk[:newline + 1]
+                newline = chunk.find(b"\n", newline + 1)
+            if raw is None:
+                text = chunk
+        if text:
+            if all(32 <= byte < 127 or byte in (9, 10, 13) for byte in text):
+                self.on_text(text.decode("ascii"))  # plain LOG output
+            else:
+                self.bad += 1
+        if raw is None:
+            return
+
+        sequence, frame_type = struct.unpack_from("<HB", raw)
+        if self.last_sequence is not None:
+            self.lost += (sequence - self.last_sequence - 1) & 0xFFFF
+        self.last_sequence = sequence
+        self.frames += 1
+
+        if frame_type == RECORD_BATCH_FRAME:
+            payload = raw[3:-2]
+            magic, count, size, dropped = BATCH_HEADER.unpack_from(payload)
+            if magic != BATCH_MAGIC or size != RECORD.size or BATCH_HEADER.size + count * size > len(payload):
+                self.bad += 1
+                return
+            self.brain_dropped = dropped
+            self.on_records([RECORD.unpack_from(payload, BATCH_HEADER.size + i * size) for i in range(count)])
+
+    def summary(self):
+        return "%d frames, %d lost, %d bad, %d records dropped on the brain" % (
+            self.frames, self.lost, self.bad, self.brain_dropped)
+
+
+def open_port(path):
+    fd = os.open(path, os.O_RDWR | os.O_NOCTTY)
+    if os.isatty(fd):
+        tty.setraw(fd)  # no echo, no newline translation, every byte as it comes
+    return fd
+
+
+def read_port(fd, reader, stop):
+    while not stop.is_set():
+        ready, _, _ = select.select([fd], [], [], 0.1)
+        if not ready:
+            continue
+        try:
+            data = os.read(fd, 65536)
+        except OSError:  # the brain was unplugged
+            break
+        if not data:
+            break
+        reader.feed(data)
+
+
+class Plotter:
+    """Keeps the last few seconds of the chosen fields and draws them."""
+
+    def __init__(self, schema, names, length=1000):
+        self.series = []
+        for name in names:
+            record_name, _, field = name.partition(".")
+            ids = [i for i, (record, _) in enumerate(schema) if record == record_name]
+            if not ids or field not in schema[ids[0]][1]:
+                sys.exit("unknown field " + name)
+            self.series.append((name, ids[0], schema[ids[0]][1].index(field), [], []))
+        self.length = length
+        self.lock = threading.Lock()
+
+    def add(self, records):
+        with self.lock:
+            for time_us, record_id, _, *values in records:
+                for _, wanted, field, times, points in self.series:
+                    if record_id == wanted:
+                        times.append(time_us / 1e6)
+                        points.append(values[field])
+                        del times[:-self.length], points[:-self.length]
+
+    def run(self, stop):
+        import matplotlib.pyplot as plt
+        from matplotlib.animation import FuncAnimation
+
+        figure, axes = plt.subplots()
+        lines = [axes.plot([], [], label=name)[0] for name, *_ in self.series]
+        axes.set_xlabel("time (s)")
+        axes.legend(loc="upper left")
+
+        def update(_):
+            with self.lock:
+                for line, (_, _, _, times, points) in zip(lines, self.series):
+                    line.set_data(list(times), list(points))
+            axes.relim()
+            axes.autoscale_view()
+            return lines
+
+        animation = FuncAnimation(figure, update, interval=50, cache_frame_data=False)
+        plt.show()
+        stop.set()
+        return animation
+
+
+def self_test(seconds, schema):
+    """Streams the full signal set at 100 Hz into a pseudo terminal, like the brain would, and checks nothing is lost."""
+    brain, host = os.openpty()
+    tty.setraw(brain)
+    tty.setraw(host)
+
+    tick_records = [i for i, (name, _) in enumerate(schema) if not name.startswith("CAPTURE") and "_CAPTURE_" not in name]
+    ticks = int(seconds * 100)
+    expected = ticks * len(tick_records)
+
+    def brain_side():
+        sequence = 0
+        pending = []
+        start = time.monotonic()
+        for tick in range(ticks):
+            now_us = tick * 10000
+            pending += [RECORD.pack(now_us, record_id, tick & 0xFFFF, tick, -tick, tick * 0.5, 0)
+                        for record_id in tick_records]
+            if tick % 2 == 1 or tick == ticks - 1:  # the drain task runs every 20 ms
+                payload = BATCH_HEADER.pack(BATCH_MAGIC, len(pending), RECORD.size, 0) + b"".join(pending)
+                os.write(brain, encode_frame(RECORD_BATCH_FRAME, sequence, payload))
+                sequence += 1
+                pending = []
+            if tick % 10 == 0:
+                os.write(brain, b"FLYWHEEL INDEXING TO TOP LINE 712 2400\n")  # LOG lines share the port
+            time.sleep(max(0, start + (tick + 1) * 0.01 - time.monotonic()))
+
+    received = [0]
+    text = [0]
+    reader = FrameReader(lambda records: received.__setitem__(0, received[0] + len(records)),
+                         lambda lines: text.__setitem__(0, text[0] + lines.count("\n")))
+    stop = threading.Event()
+    listener = threading.Thread(target=read_port, args=(host, reader, stop))
+    listener.start()
+
+    brain_side()
+    time.sleep(0.3)
+    stop.set()
+    listener.join()
+
+    print(reader.summary())
+    print("%d of %d records, %d log lines, %.0f records/s" % (received[0], expected, text[0], expected / seconds))
+    ok = received[0] == expected and reader.lost == 0 and reader.bad == 0
+    print("PASS" if ok else "FAIL")
+    return 0 if ok else 1
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("port", nargs="?", help="serial port of the brain (the user port)")
+    parser.add_argument("--csv", help="directory to record every record into (one CSV per record)")
+    parser.add_argument("--plot", action="append", default=[], metavar="RECORD.field", help="field to plot live")
+    parser.add_argument("--defs", default=DEFAULT_DEFS, help="recordDefs.h to take the schema from")
+    parser.add_argument("--selftest", type=float, nargs="?", const=5.0, metavar="SECONDS",
+                        help="stream through a pseudo terminal and check nothing is lost")
+    args = parser.parse_args()
+
+    schema = decode_telemetry.load_schema(args.defs)
+    if args.selftest:
+        return self_test(args.selftest, schema)
+    if not args.port:
+        parser.error("a port is needed (or --selftest)")
+
+    csv = decode_telemetry.RecordCsv(schema, args.csv) if args.csv else None
+    plotter = Plotter(schema, args.plot) if args.plot else None
+
+    def on_records(records):
+        if csv:
+            for record in records:
+                csv.write(record)
+        if plotter:
+            plotter.add(records)
+
+    reader = FrameReader(on_records, sys.stdout.write)
+    fd = open_port(args.port)
+    stop = threading.Event()
+    listener = threading.Thread(target=read_port, args=(fd, reader, stop), daemon=True)
+    listener.start()
+
+    try:
+        if plotter:
+            plotter.run(stop)
+        else:
+            while listener.is_alive():
+                listener.join(0.5)
+    except KeyboardInterrupt:
+        pass
+    stop.set()
+    listener.join(1)
+
+    if csv:
+        csv.close()
+    print(reader.summary(), file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())